@@ -0,0 +1,288 @@
+#pragma once
+
+// Minimal benchmark harness shared by the standalone benchmark executables.
+//	Every benchmark runs over batches sized for L1, L2 and main memory and the
+//	results are written as JSON, so runs can be diffed between releases.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fe::bench {
+
+// Keeps the compiler from optimizing away results that are never read.
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	static volatile const void* pSink;
+	pSink = &value;
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+struct BatchSize_t {
+	const char* name;
+	size_t bytes;
+};
+
+// Working set sizes, chosen well inside the usual L1 and L2 sizes and well
+//	outside of any L3.
+constexpr BatchSize_t batchSizes[] = {
+	{ "L1", 16 * 1024 },
+	{ "L2", 256 * 1024 },
+	{ "DRAM", 128 * 1024 * 1024 },
+};
+
+struct Options_t {
+	const char* pFilter = nullptr;
+	const char* pOutputFile = nullptr;
+	double minSampleSeconds = 0.02;
+	int numSamples = 5;
+	bool skipDRAM = false;
+};
+
+struct Result_t {
+	std::string name;
+	std::string variant;
+	std::string batch;
+	size_t batchCount;
+	double nsPerOp;
+	double opsPerSecond;
+	// Only for results added with AddThroughput.
+	double gbPerSecond = 0.0;
+};
+
+// Largest errors an accuracy check may have, unbounded by default.
+struct Tolerance_t {
+	double maxAbsError = std::numeric_limits<double>::infinity();
+	double maxRelError = std::numeric_limits<double>::infinity();
+};
+
+inline Tolerance_t AbsTolerance(double maxAbsError) {
+	Tolerance_t tolerance;
+	tolerance.maxAbsError = maxAbsError;
+	return tolerance;
+}
+
+inline Tolerance_t RelTolerance(double maxRelError) {
+	Tolerance_t tolerance;
+	tolerance.maxRelError = maxRelError;
+	return tolerance;
+}
+
+struct AccuracyResult_t {
+	std::string name;
+	std::string variant;
+	size_t samples;
+	double maxAbsError;
+	double maxRelError;
+	bool passed;
+};
+
+class Harness {
+public:
+	// Understands --filter <substring>, --out <file>, --quick and --no-dram.
+	Harness(int argc, char** argv) {
+		for (int i = 1; i < argc; i++) {
+			if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+				m_Options.pFilter = argv[++i];
+			}
+			else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+				m_Options.pOutputFile = argv[++i];
+			}
+			else if (!strcmp(argv[i], "--quick")) {
+				m_Options.minSampleSeconds = 0.002;
+				m_Options.numSamples = 2;
+				m_Options.skipDRAM = true;
+			}
+			else if (!strcmp(argv[i], "--no-dram")) {
+				m_Options.skipDRAM = true;
+			}
+			else {
+				fprintf(stderr, "Unknown argument %s\n", argv[i]);
+			}
+		}
+	}
+
+	const Options_t& GetOptions() const {
+		return m_Options;
+	}
+
+	bool IsEnabled(const std::string& name) const {
+		return !m_Options.pFilter || name.find(m_Options.pFilter) != std::string::npos;
+	}
+
+	// Calls fn() until one sample takes at least minSampleSeconds, then
+	//	keeps the fastest of numSamples. fn must do opsPerCall operations.
+	template<typename Fn>
+	double MeasureNsPerOp(Fn&& fn, size_t opsPerCall) const {
+		using Clock = std::chrono::steady_clock;
+
+		fn(); // Warm up caches and page in the buffers.
+
+		size_t calls = 1;
+		double best = 0.0;
+
+		for (int sample = 0; sample < m_Options.numSamples; sample++) {
+			double seconds;
+
+			for (;;) {
+				Clock::time_point start = Clock::now();
+
+				for (size_t i = 0; i < calls; i++) {
+					fn();
+				}
+
+				seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+				if (seconds >= m_Options.minSampleSeconds || sample > 0)
+					break;
+
+				calls *= 2;
+			}
+
+			double nsPerOp = seconds * 1e9 / static_cast<double>(calls * opsPerCall);
+
+			if (sample == 0 || nsPerOp < best)
+				best = nsPerOp;
+		}
+
+		return best;
+	}
+
+	void AddResult(const std::string& name, const std::string& variant, const BatchSize_t& batch, size_t batchCount, double nsPerOp) {
+		Result_t result;
+		result.name = name;
+		result.variant = variant;
+		result.batch = batch.name;
+		result.batchCount = batchCount;
+		result.nsPerOp = nsPerOp;
+		result.opsPerSecond = nsPerOp > 0.0 ? 1e9 / nsPerOp : 0.0;
+
+		fprintf(stderr, "%-40s %-10s %-5s %10zu %10.3f ns/op\n", name.c_str(), variant.c_str(), batch.name, batchCount, nsPerOp);
+
+		m_Results.push_back(result);
+	}
+
+	// For results measured per byte, bytesPerCall is what one call to the
+	//	measured function processes. Also reports GB/s, which is 1 / nsPerOp.
+	void AddThroughput(const std::string& name, const std::string& variant, const BatchSize_t& batch, size_t bytesPerCall, double nsPerByte) {
+		Result_t result;
+		result.name = name;
+		result.variant = variant;
+		result.batch = batch.name;
+		result.batchCount = bytesPerCall;
+		result.nsPerOp = nsPerByte;
+		result.opsPerSecond = nsPerByte > 0.0 ? 1e9 / nsPerByte : 0.0;
+		result.gbPerSecond = nsPerByte > 0.0 ? 1.0 / nsPerByte : 0.0;
+
+		fprintf(stderr, "%-40s %-10s %-5s %10zu %10.3f GB/s\n", name.c_str(), variant.c_str(), batch.name, bytesPerCall, result.gbPerSecond);
+
+		m_Results.push_back(result);
+	}
+
+	// Fails the run when an error is above its tolerance, or NaN.
+	void AddAccuracy(const std::string& name, const std::string& variant, size_t samples, double maxAbsError, double maxRelError, const Tolerance_t& tolerance) {
+		AccuracyResult_t result;
+		result.name = name;
+		result.variant = variant;
+		result.samples = samples;
+		result.maxAbsError = maxAbsError;
+		result.maxRelError = maxRelError;
+		result.passed = maxAbsError <= tolerance.maxAbsError && maxRelError <= tolerance.maxRelError;
+
+		fprintf(stderr, "%-40s %-10s abs %.3e rel %.3e%s\n", name.c_str(), variant.c_str(), maxAbsError, maxRelError, result.passed ? "" : "  FAILED");
+
+		if (!result.passed) {
+			fprintf(stderr, "  allowed abs %.3e rel %.3e\n", tolerance.maxAbsError, tolerance.maxRelError);
+			m_HasFailures = true;
+		}
+
+		m_Accuracy.push_back(result);
+	}
+
+	// Marks the run as failed, for checks that aren't an AddAccuracy.
+	void AddFailure(const std::string& name, const std::string& message) {
+		fprintf(stderr, "%-40s FAILED: %s\n", name.c_str(), message.c_str());
+		m_HasFailures = true;
+	}
+
+	bool HasFailures() const {
+		return m_HasFailures;
+	}
+
+	void AddInfo(const std::string& key, const std::string& value) {
+		m_Info.emplace_back(key, value);
+	}
+
+	// Writes to --out when given, stdout otherwise.
+	bool WriteJson() const {
+		FILE* pFile = stdout;
+
+		if (m_Options.pOutputFile) {
+			pFile = fopen(m_Options.pOutputFile, "w");
+
+			if (!pFile) {
+				fprintf(stderr, "Failed to open %s\n", m_Options.pOutputFile);
+				return false;
+			}
+		}
+
+		fprintf(pFile, "{\n");
+
+		for (const auto& [key, value] : m_Info) {
+			fprintf(pFile, "  \"%s\": \"%s\",\n", key.c_str(), value.c_str());
+		}
+
+		fprintf(pFile, "  \"benchmarks\": [\n");
+		for (size_t i = 0; i < m_Results.size(); i++) {
+			const Result_t& r = m_Results[i];
+
+			fprintf(pFile, "    {\"name\": \"%s\", \"variant\": \"%s\", \"batch\": \"%s\", \"batchCount\": %zu, \"nsPerOp\": %.4f, \"opsPerSecond\": %.1f",
+				r.name.c_str(), r.variant.c_str(), r.batch.c_str(), r.batchCount, r.nsPerOp, r.opsPerSecond);
+
+			if (r.gbPerSecond > 0.0)
+				fprintf(pFile, ", \"gbPerSecond\": %.3f", r.gbPerSecond);
+
+			fprintf(pFile, "}%s\n", i + 1 < m_Results.size() ? "," : "");
+		}
+		fprintf(pFile, "  ],\n");
+
+		fprintf(pFile, "  \"accuracy\": [\n");
+		for (size_t i = 0; i < m_Accuracy.size(); i++) {
+			const AccuracyResult_t& r = m_Accuracy[i];
+
+			fprintf(pFile, "    {\"name\": \"%s\", \"variant\": \"%s\", \"samples\": %zu, \"maxAbsError\": %.6e, \"maxRelError\": %.6e, \"passed\": %s}%s\n",
+				r.name.c_str(), r.variant.c_str(), r.samples, r.maxAbsError, r.maxRelError, r.passed ? "true" : "false", i + 1 < m_Accuracy.size() ? "," : "");
+		}
+		fprintf(pFile, "  ]\n");
+
+		fprintf(pFile, "}\n");
+
+		if (pFile != stdout)
+			fclose(pFile);
+
+		return true;
+	}
+
+private:
+	Options_t m_Options;
+	std::vector<std::pair<std::string, std::string>> m_Info;
+	std::vector<Result_t> m_Results;
+	std::vector<AccuracyResult_t> m_Accuracy;
+	bool m_HasFailures = false;
+};
+
+// Number of elements of the given footprint that fit in a batch.
+inline size_t GetBatchCount(const BatchSize_t& batch, size_t bytesPerElement) {
+	size_t count = batch.bytes / bytesPerElement;
+
+	return count > 0 ? count : 1;
+}
+
+}
\ No newline at end of file
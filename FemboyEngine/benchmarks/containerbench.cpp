@@ -0,0 +1,1182 @@
+// Throughput of the fstdlib containers against their std counterparts,
+//	written as JSON to stdout or --out. Built by the CMakeLists.txt next to
+//	FemboyEngine.vcxproj alongside mathbench.
+#include "benchmark.h"
+
+#include "fstdlib/flathashmap.h"
+#include "fstdlib/spscqueue.h"
+#include "fstdlib/mpmcqueue.h"
+#include "fstdlib/blockingqueue.h"
+#include "fstdlib/pointers.h"
+#include "fstdlib/bitset.h"
+#include "fstdlib/blockpool.h"
+#include "fstdlib/radixsort.h"
+#include "fstdlib/inplacefunction.h"
+#include "fstdlib/hash.h"
+#include "fstdlib/stringid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+using namespace fe;
+using bench::Harness;
+using bench::BatchSize_t;
+
+// ===============================================
+// Helpers
+// ===============================================
+static std::mt19937_64 rng(1234);
+
+// Set when a run produced wrong results, makes the exit code non-zero.
+static bool failed = false;
+
+static bool SkipBatch(const Harness& harness, const BatchSize_t& batch) {
+	return harness.GetOptions().skipDRAM && !strcmp(batch.name, "DRAM");
+}
+
+// Unique random keys with the top bit clear, so keys with it set are misses.
+static std::vector<uint64_t> MakeKeys(size_t count) {
+	std::vector<uint64_t> keys(count);
+
+	for (size_t i = 0; i < count; i++) {
+		keys[i] = ((rng() << 20) | i) & ~(1ull << 63);
+	}
+
+	std::shuffle(keys.begin(), keys.end(), rng);
+	return keys;
+}
+
+// ===============================================
+// Hash maps
+// ===============================================
+// Random inserts, erases and finds compared against std::unordered_map. The
+//	size hovers around TargetSize, which ends up a bit under half of the
+//	table's capacity. Every insert takes a fresh key, so erases keep leaving
+//	tombstones behind until the table runs out of empty slots and has to
+//	clean them up in place instead of growing.
+static void CheckHashMap() {
+	FlatHashMap<uint64_t, uint64_t> map;
+	std::unordered_map<uint64_t, uint64_t> expected;
+	std::vector<uint64_t> liveKeys;
+
+	constexpr size_t TargetSize = 800;
+	constexpr size_t StepCount = 1 << 18;
+
+	for (size_t step = 0; step < StepCount; step++) {
+		uint64_t key = rng();
+		uint64_t value = rng();
+
+		// Half of the erases and finds are for keys that are in the table.
+		size_t liveIndex = liveKeys.size();
+
+		if (!liveKeys.empty() && rng() % 2) {
+			liveIndex = rng() % liveKeys.size();
+			key = liveKeys[liveIndex];
+		}
+
+		// 0 inserts, 1 erases, 2 finds. Inserting gets less likely the
+		//	fuller the table is.
+		uint64_t roll = rng() % 4;
+		int op = roll == 3 ? 2 : rng() % (2 * TargetSize) >= liveKeys.size() ? 0 : 1;
+
+		switch (op) {
+		case 0: {
+			bool inserted = map.try_emplace(key, value).second;
+			bool expectedInserted = expected.try_emplace(key, value).second;
+
+			if (inserted != expectedInserted) {
+				fprintf(stderr, "FlatHashMap insert of %llu returned %d at step %zu\n", static_cast<unsigned long long>(key), inserted, step);
+				failed = true;
+				return;
+			}
+
+			if (inserted)
+				liveKeys.push_back(key);
+			break;
+		}
+		case 1:
+			if (map.erase(key) != expected.erase(key)) {
+				fprintf(stderr, "FlatHashMap erase of %llu returned the wrong count at step %zu\n", static_cast<unsigned long long>(key), step);
+				failed = true;
+				return;
+			}
+
+			if (liveIndex < liveKeys.size()) {
+				liveKeys[liveIndex] = liveKeys.back();
+				liveKeys.pop_back();
+			}
+			break;
+		default: {
+			auto it = map.find(key);
+			auto expectedIt = expected.find(key);
+			bool found = it != map.end();
+
+			if (found != (expectedIt != expected.end()) || (found && it->second != expectedIt->second)) {
+				fprintf(stderr, "FlatHashMap find of %llu gave the wrong result at step %zu\n", static_cast<unsigned long long>(key), step);
+				failed = true;
+				return;
+			}
+			break;
+		}
+		}
+
+		if (map.size() != expected.size()) {
+			fprintf(stderr, "FlatHashMap has %zu entries instead of %zu at step %zu\n", map.size(), expected.size(), step);
+			failed = true;
+			return;
+		}
+	}
+
+	// Iteration has to visit every entry exactly once.
+	size_t visited = 0;
+
+	for (const auto& [key, value] : map) {
+		auto expectedIt = expected.find(key);
+
+		if (expectedIt == expected.end() || expectedIt->second != value) {
+			fprintf(stderr, "FlatHashMap iteration found %llu, which it shouldn't have\n", static_cast<unsigned long long>(key));
+			failed = true;
+			return;
+		}
+
+		visited++;
+	}
+
+	if (visited != expected.size()) {
+		fprintf(stderr, "FlatHashMap iteration visited %zu of %zu entries\n", visited, expected.size());
+		failed = true;
+	}
+}
+
+// The batch size is the table's working set, a uint64_t to uint64_t entry
+//	plus the table's overhead is counted as 32 bytes.
+template<typename Map>
+static void BenchHashMap(Harness& harness, const char* pVariant) {
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, 32);
+		std::vector<uint64_t> keys = MakeKeys(count);
+
+		// Building the table, its destruction included.
+		if (harness.IsEnabled("HashMap insert")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				Map map;
+
+				for (uint64_t key : keys) {
+					map[key] = key;
+				}
+
+				bench::DoNotOptimize(map.size());
+			}, count);
+
+			harness.AddResult("HashMap insert", pVariant, batch, count, ns);
+		}
+
+		if (harness.IsEnabled("HashMap insert reserved")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				Map map;
+				map.reserve(count);
+
+				for (uint64_t key : keys) {
+					map[key] = key;
+				}
+
+				bench::DoNotOptimize(map.size());
+			}, count);
+
+			harness.AddResult("HashMap insert reserved", pVariant, batch, count, ns);
+		}
+
+		Map map;
+		for (uint64_t key : keys) {
+			map[key] = key;
+		}
+
+		// Looked up in a different order than inserted.
+		std::vector<uint64_t> hits = keys;
+		std::shuffle(hits.begin(), hits.end(), rng);
+
+		if (harness.IsEnabled("HashMap find hit")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				uint64_t sum = 0;
+
+				for (uint64_t key : hits) {
+					auto it = map.find(key);
+
+					if (it != map.end())
+						sum += it->second;
+				}
+
+				bench::DoNotOptimize(sum);
+			}, count);
+
+			harness.AddResult("HashMap find hit", pVariant, batch, count, ns);
+		}
+
+		if (harness.IsEnabled("HashMap find miss")) {
+			std::vector<uint64_t> misses = MakeKeys(count);
+
+			for (uint64_t& key : misses) {
+				key |= 1ull << 63;
+			}
+
+			double ns = harness.MeasureNsPerOp([&]() {
+				size_t found = 0;
+
+				for (uint64_t key : misses) {
+					found += map.find(key) != map.end();
+				}
+
+				bench::DoNotOptimize(found);
+			}, count);
+
+			harness.AddResult("HashMap find miss", pVariant, batch, count, ns);
+		}
+
+		if (harness.IsEnabled("HashMap iterate")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				uint64_t sum = 0;
+
+				for (const auto& [key, value] : map) {
+					sum += value;
+				}
+
+				bench::DoNotOptimize(sum);
+			}, count);
+
+			harness.AddResult("HashMap iterate", pVariant, batch, count, ns);
+		}
+	}
+}
+
+// ===============================================
+// Queues
+// ===============================================
+// Values a queue run pushes in total, split over the producers.
+constexpr size_t QueueRunCount = 1 << 18;
+
+// Baseline, a std::deque behind a mutex.
+class MutexQueue {
+public:
+	explicit MutexQueue(size_t capacity)
+		: m_Capacity(capacity) {}
+
+	bool TryPush(uint64_t value) {
+		return TryPushBatch(&value, 1) == 1;
+	}
+
+	bool TryPop(uint64_t& value) {
+		return TryPopBatch(&value, 1) == 1;
+	}
+
+	size_t TryPushBatch(const uint64_t* pValues, size_t count) {
+		std::lock_guard lock(m_Mutex);
+
+		count = std::min(count, m_Capacity - m_Values.size());
+		m_Values.insert(m_Values.end(), pValues, pValues + count);
+
+		return count;
+	}
+
+	size_t TryPopBatch(uint64_t* pValues, size_t maxCount) {
+		std::lock_guard lock(m_Mutex);
+
+		size_t count = std::min(maxCount, m_Values.size());
+		std::copy_n(m_Values.begin(), count, pValues);
+		m_Values.erase(m_Values.begin(), m_Values.begin() + count);
+
+		return count;
+	}
+
+private:
+	std::mutex m_Mutex;
+	std::deque<uint64_t> m_Values;
+	size_t m_Capacity;
+};
+
+template<typename Queue>
+static void PushValues(Queue& queue, uint64_t* pValues, size_t count) {
+	size_t pushed = 0;
+
+	while (pushed < count) {
+		size_t n = count == 1 ? (queue.TryPush(std::move(pValues[0])) ? 1 : 0) : queue.TryPushBatch(pValues + pushed, count - pushed);
+
+		if (n == 0)
+			std::this_thread::yield();
+
+		pushed += n;
+	}
+}
+
+template<typename Queue>
+static void PushValues(BlockingQueue<Queue>& queue, uint64_t* pValues, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		queue.Push(pValues[i]);
+	}
+}
+
+template<typename Queue>
+static size_t PopValues(Queue& queue, uint64_t* pValues, size_t maxCount) {
+	size_t n = maxCount == 1 ? (queue.TryPop(pValues[0]) ? 1 : 0) : queue.TryPopBatch(pValues, maxCount);
+
+	if (n == 0)
+		std::this_thread::yield();
+
+	return n;
+}
+
+template<typename Queue>
+static size_t PopValues(BlockingQueue<Queue>& queue, uint64_t* pValues, size_t maxCount) {
+	return queue.PopBatch(pValues, maxCount);
+}
+
+// Pushes 1 to QueueRunCount through the queue and checks every value came
+//	out once, and in order when there is one producer and one consumer.
+//	Consumers claim values from a shared count before popping them, so
+//	none of them waits for a value another one took.
+template<typename Queue>
+static void RunQueue(Queue& queue, int numProducers, int numConsumers, size_t batchSize) {
+	size_t perProducer = QueueRunCount / numProducers;
+	size_t total = perProducer * numProducers;
+
+	std::atomic<size_t> numClaimed = 0;
+	std::atomic<uint64_t> sum = 0;
+	std::atomic<bool> inOrder = true;
+	std::vector<std::thread> threads;
+
+	for (int p = 0; p < numProducers; p++) {
+		threads.emplace_back([&, p]() {
+			std::vector<uint64_t> values(batchSize);
+			uint64_t first = p * perProducer + 1;
+
+			for (size_t i = 0; i < perProducer; i += batchSize) {
+				size_t count = std::min(batchSize, perProducer - i);
+
+				for (size_t j = 0; j < count; j++) {
+					values[j] = first + i + j;
+				}
+
+				PushValues(queue, values.data(), count);
+			}
+		});
+	}
+
+	for (int c = 0; c < numConsumers; c++) {
+		threads.emplace_back([&]() {
+			std::vector<uint64_t> values(batchSize);
+			uint64_t localSum = 0;
+			uint64_t previous = 0;
+
+			for (;;) {
+				size_t start = numClaimed.fetch_add(batchSize, std::memory_order_relaxed);
+				if (start >= total)
+					break;
+
+				size_t claimed = std::min(batchSize, total - start);
+
+				for (size_t popped = 0; popped < claimed;) {
+					size_t count = PopValues(queue, values.data(), claimed - popped);
+
+					for (size_t j = 0; j < count; j++) {
+						if (values[j] != previous + 1 && numProducers == 1 && numConsumers == 1)
+							inOrder = false;
+
+						previous = values[j];
+						localSum += values[j];
+					}
+
+					popped += count;
+				}
+			}
+
+			sum += localSum;
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	if (sum != total * (total + 1) / 2 || !inOrder) {
+		fprintf(stderr, "Queue run with %d producers and %d consumers lost or reordered values\n", numProducers, numConsumers);
+		failed = true;
+	}
+}
+
+// The batch size sets the queue's capacity.
+template<typename Queue>
+static void BenchQueue(Harness& harness, const char* pVariant, int numProducers, int numConsumers, size_t batchSize) {
+	std::string name = "Queue " + std::to_string(numProducers) + ":" + std::to_string(numConsumers);
+
+	if (!harness.IsEnabled(name))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		// A queue the size of main memory tells nothing new.
+		if (!strcmp(batch.name, "DRAM"))
+			continue;
+
+		size_t capacity = bench::GetBatchCount(batch, sizeof(uint64_t));
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			Queue queue(capacity);
+			RunQueue(queue, numProducers, numConsumers, batchSize);
+		}, QueueRunCount);
+
+		harness.AddResult(name, pVariant, batch, capacity, ns);
+	}
+}
+
+static void BenchQueues(Harness& harness) {
+	constexpr size_t QueueBatchSize = 32;
+
+	BenchQueue<SpscQueue<uint64_t>>(harness, "Spsc", 1, 1, 1);
+	BenchQueue<SpscQueue<uint64_t>>(harness, "SpscBatch", 1, 1, QueueBatchSize);
+
+	const int threadCounts[][2] = { { 1, 1 }, { 1, 4 }, { 4, 1 }, { 4, 4 } };
+
+	for (const auto& [numProducers, numConsumers] : threadCounts) {
+		BenchQueue<MpmcQueue<uint64_t>>(harness, "Mpmc", numProducers, numConsumers, 1);
+		BenchQueue<MpmcQueue<uint64_t>>(harness, "MpmcBatch", numProducers, numConsumers, QueueBatchSize);
+		BenchQueue<BlockingQueue<MpmcQueue<uint64_t>>>(harness, "Blocking", numProducers, numConsumers, 1);
+		BenchQueue<MutexQueue>(harness, "Mutex", numProducers, numConsumers, 1);
+	}
+}
+
+// ===============================================
+// Reference counting
+// ===============================================
+struct RefPayload_t : RefCounted<RefPayload_t> {
+	uint64_t value = 0;
+};
+
+struct AtomicRefPayload_t : AtomicRefCounted<AtomicRefPayload_t> {
+	uint64_t value = 0;
+};
+
+struct SharedPayload_t {
+	uint64_t value = 0;
+};
+
+// Adds up what allocate_shared asks for, which is the payload plus the
+//	control block.
+template<typename T>
+struct CountingAllocator {
+	using value_type = T;
+
+	size_t* pBytes;
+
+	explicit CountingAllocator(size_t* pBytes)
+		: pBytes(pBytes) {}
+
+	template<typename U>
+	CountingAllocator(const CountingAllocator<U>& other)
+		: pBytes(other.pBytes) {}
+
+	T* allocate(size_t count) {
+		*pBytes += sizeof(T) * count;
+		return std::allocator<T>().allocate(count);
+	}
+
+	void deallocate(T* p, size_t count) {
+		std::allocator<T>().deallocate(p, count);
+	}
+
+	template<typename U>
+	bool operator==(const CountingAllocator<U>& other) const { return pBytes == other.pBytes; }
+};
+
+// The batch size is the working set of the pointers and their objects, a
+//	pointer plus a 16 to 32 byte allocation is counted as 32 bytes.
+template<typename Ptr, typename MakeFn>
+static void BenchRefPtr(Harness& harness, const char* pVariant, MakeFn&& make) {
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, 32);
+
+		// One allocation and free per object, with its count or control block.
+		if (harness.IsEnabled("RefPtr make")) {
+			std::vector<Ptr> ptrs;
+			ptrs.reserve(count);
+
+			double ns = harness.MeasureNsPerOp([&]() {
+				for (size_t i = 0; i < count; i++) {
+					ptrs.push_back(make());
+				}
+
+				ptrs.clear();
+			}, count);
+
+			harness.AddResult("RefPtr make", pVariant, batch, count, ns);
+		}
+
+		std::vector<Ptr> ptrs;
+		for (size_t i = 0; i < count; i++) {
+			ptrs.push_back(make());
+		}
+
+		// Adds a reference to every object, then drops it again.
+		if (harness.IsEnabled("RefPtr copy")) {
+			std::vector<Ptr> copies;
+			copies.reserve(count);
+
+			double ns = harness.MeasureNsPerOp([&]() {
+				for (const Ptr& p : ptrs) {
+					copies.push_back(p);
+				}
+
+				bench::DoNotOptimize(copies.data());
+				copies.clear();
+			}, count);
+
+			harness.AddResult("RefPtr copy", pVariant, batch, count, ns);
+		}
+
+		if (harness.IsEnabled("RefPtr deref")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				uint64_t sum = 0;
+
+				for (const Ptr& p : ptrs) {
+					sum += p->value;
+				}
+
+				bench::DoNotOptimize(sum);
+			}, count);
+
+			harness.AddResult("RefPtr deref", pVariant, batch, count, ns);
+		}
+	}
+}
+
+static void BenchRefPtrs(Harness& harness) {
+	// libstdc++ skips the atomics in shared_ptr until the process starts a
+	//	thread, which any engine has done long before.
+	std::thread([]() {}).join();
+
+	size_t sharedBytes = 0;
+	std::allocate_shared<SharedPayload_t>(CountingAllocator<SharedPayload_t>(&sharedBytes));
+
+	harness.AddInfo("RefPtr size", std::to_string(sizeof(RefPtr<RefPayload_t>)));
+	harness.AddInfo("shared_ptr size", std::to_string(sizeof(std::shared_ptr<SharedPayload_t>)));
+	harness.AddInfo("RefPtr allocation", std::to_string(sizeof(RefPayload_t)));
+	harness.AddInfo("make_shared allocation", std::to_string(sharedBytes));
+
+	BenchRefPtr<RefPtr<RefPayload_t>>(harness, "RefPtr", []() { return MakeRef<RefPayload_t>(); });
+	BenchRefPtr<RefPtr<AtomicRefPayload_t>>(harness, "AtomicRefPtr", []() { return MakeRef<AtomicRefPayload_t>(); });
+	BenchRefPtr<std::shared_ptr<SharedPayload_t>>(harness, "shared_ptr", []() { return std::make_shared<SharedPayload_t>(); });
+}
+
+// ===============================================
+// Callbacks
+// ===============================================
+// Callbacks capture 24 bytes, like a this pointer and two handles, which is
+//	more than libstdc++ and MSVC keep inside a std::function. The batch size
+//	is the working set of the wrappers.
+template<typename Function>
+static void BenchFunction(Harness& harness, const char* pVariant) {
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, sizeof(Function));
+
+		std::vector<Function> functions;
+		functions.reserve(count);
+
+		auto addFunctions = [&]() {
+			for (size_t i = 0; i < count; i++) {
+				uint64_t a = i, b = i * 3, c = i * 7;
+
+				functions.push_back([a, b, c](uint64_t x) { return a + b * x + c; });
+			}
+		};
+
+		if (harness.IsEnabled("Function make")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				addFunctions();
+				bench::DoNotOptimize(functions.data());
+				functions.clear();
+			}, count);
+
+			harness.AddResult("Function make", pVariant, batch, count, ns);
+		}
+
+		addFunctions();
+
+		if (harness.IsEnabled("Function call")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				uint64_t sum = 0;
+
+				for (const Function& function : functions) {
+					sum += function(sum);
+				}
+
+				bench::DoNotOptimize(sum);
+			}, count);
+
+			harness.AddResult("Function call", pVariant, batch, count, ns);
+		}
+	}
+}
+
+static void BenchFunctions(Harness& harness) {
+	harness.AddInfo("InplaceFunction size", std::to_string(sizeof(InplaceFunction<uint64_t(uint64_t)>)));
+	harness.AddInfo("std::function size", std::to_string(sizeof(std::function<uint64_t(uint64_t)>)));
+
+	BenchFunction<InplaceFunction<uint64_t(uint64_t)>>(harness, "InplaceFunction");
+	BenchFunction<std::function<uint64_t(uint64_t)>>(harness, "std::function");
+}
+
+// ===============================================
+// Bit sets
+// ===============================================
+// The batch size is the working set of two sets. Every run is counted per
+//	64 bit word, so the numbers compare with a plain loop over uint64_t.
+//	Iterating uses a set with one bit in 16 set, like a culling result.
+template<typename Bits>
+static void BenchBitSet(Harness& harness, const char* pVariant) {
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		size_t numBits = batch.bytes * 8 / 2;
+		size_t numWords = numBits / 64;
+
+		Bits a(numBits);
+		Bits b(numBits);
+		Bits sparse(numBits);
+
+		for (size_t i = 0; i < numBits; i++) {
+			uint64_t random = rng();
+
+			a[i] = random & 1;
+			b[i] = random & 2;
+			sparse[i] = (random >> 8) % 16 == 0;
+		}
+
+		if (harness.IsEnabled("BitSet and")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				a &= b;
+				a |= b;
+			}, numWords * 2);
+
+			harness.AddResult("BitSet and", pVariant, batch, numWords, ns);
+		}
+
+		if (harness.IsEnabled("BitSet count")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				bench::DoNotOptimize(a.Count());
+			}, numWords);
+
+			harness.AddResult("BitSet count", pVariant, batch, numWords, ns);
+		}
+
+		if (harness.IsEnabled("BitSet iterate")) {
+			double ns = harness.MeasureNsPerOp([&]() {
+				size_t sum = 0;
+
+				sparse.ForEachSetBit([&](size_t index) {
+					sum += index;
+				});
+
+				bench::DoNotOptimize(sum);
+			}, numWords);
+
+			harness.AddResult("BitSet iterate", pVariant, batch, numWords, ns);
+		}
+	}
+}
+
+// Gives std::vector<bool> the interface BenchBitSet uses, written the way
+//	code using it would be.
+class VectorBoolBits {
+public:
+	explicit VectorBoolBits(size_t size)
+		: m_Bits(size) {}
+
+	std::vector<bool>::reference operator[](size_t index) { return m_Bits[index]; }
+
+	VectorBoolBits& operator&=(const VectorBoolBits& other) {
+		for (size_t i = 0; i < m_Bits.size(); i++) {
+			m_Bits[i] = m_Bits[i] && other.m_Bits[i];
+		}
+
+		return *this;
+	}
+
+	VectorBoolBits& operator|=(const VectorBoolBits& other) {
+		for (size_t i = 0; i < m_Bits.size(); i++) {
+			m_Bits[i] = m_Bits[i] || other.m_Bits[i];
+		}
+
+		return *this;
+	}
+
+	size_t Count() const {
+		return std::count(m_Bits.begin(), m_Bits.end(), true);
+	}
+
+	template<typename Fn>
+	void ForEachSetBit(Fn&& fn) const {
+		for (size_t i = 0; i < m_Bits.size(); i++) {
+			if (m_Bits[i])
+				fn(i);
+		}
+	}
+
+private:
+	std::vector<bool> m_Bits;
+};
+
+// Indexing support for DynamicBitSet in the setup loop only.
+class DynamicBits : public DynamicBitSet<> {
+public:
+	explicit DynamicBits(size_t size)
+		: DynamicBitSet(size) {}
+
+	struct BitRef_t {
+		DynamicBits& bits;
+		size_t index;
+
+		void operator=(bool value) { bits.Set(index, value); }
+	};
+
+	BitRef_t operator[](size_t index) { return { *this, index }; }
+};
+
+// ===============================================
+// Block pool
+// ===============================================
+// A 64 byte object, the size of a typical component.
+struct PoolObject_t {
+	uint64_t values[8];
+};
+
+struct PoolAllocator_t {
+	static PoolObject_t* New() { return PoolNew<PoolObject_t>(MemoryTag::General); }
+	static void Delete(PoolObject_t* p) { PoolDelete(p); }
+};
+
+struct HeapAllocator_t {
+	static PoolObject_t* New() { return new PoolObject_t(); }
+	static void Delete(PoolObject_t* p) { delete p; }
+};
+
+// Objects spawning and dying at random in a live set of a fixed size, on
+//	1 and 4 threads. Every op is one delete and one new.
+template<typename Allocator>
+static void BenchPoolChurn(Harness& harness, const char* pVariant, int numThreads) {
+	std::string name = "Pool churn " + std::to_string(numThreads) + "T";
+
+	if (!harness.IsEnabled(name))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		size_t liveCount = bench::GetBatchCount(batch, sizeof(PoolObject_t) * numThreads);
+		constexpr size_t OpsPerThread = 1 << 16;
+
+		std::vector<std::vector<PoolObject_t*>> liveSets(numThreads);
+		std::vector<std::vector<uint32_t>> slotOrders(numThreads);
+
+		for (int t = 0; t < numThreads; t++) {
+			for (size_t i = 0; i < liveCount; i++) {
+				liveSets[t].push_back(Allocator::New());
+			}
+
+			for (size_t i = 0; i < OpsPerThread; i++) {
+				slotOrders[t].push_back(static_cast<uint32_t>(rng() % liveCount));
+			}
+		}
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			auto churn = [&](int t) {
+				std::vector<PoolObject_t*>& live = liveSets[t];
+
+				for (uint32_t slot : slotOrders[t]) {
+					Allocator::Delete(live[slot]);
+					live[slot] = Allocator::New();
+				}
+			};
+
+			if (numThreads == 1) {
+				churn(0);
+				return;
+			}
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < numThreads; t++) {
+				threads.emplace_back(churn, t);
+			}
+
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		}, OpsPerThread * numThreads);
+
+		for (std::vector<PoolObject_t*>& live : liveSets) {
+			for (PoolObject_t* p : live) {
+				Allocator::Delete(p);
+			}
+		}
+
+		harness.AddResult(name, pVariant, batch, liveCount, ns);
+	}
+}
+
+// Allocates a batch of objects and frees them all, like a burst of spawns.
+template<typename Allocator>
+static void BenchPoolBurst(Harness& harness, const char* pVariant) {
+	if (!harness.IsEnabled("Pool burst"))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, sizeof(PoolObject_t));
+		std::vector<PoolObject_t*> objects(count);
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			for (size_t i = 0; i < count; i++) {
+				objects[i] = Allocator::New();
+			}
+
+			for (size_t i = 0; i < count; i++) {
+				Allocator::Delete(objects[i]);
+			}
+		}, count);
+
+		harness.AddResult("Pool burst", pVariant, batch, count, ns);
+	}
+}
+
+static void BenchPool(Harness& harness) {
+	BenchPoolBurst<PoolAllocator_t>(harness, "BlockPool");
+	BenchPoolBurst<HeapAllocator_t>(harness, "new");
+
+	for (int numThreads : { 1, 4 }) {
+		BenchPoolChurn<PoolAllocator_t>(harness, "BlockPool", numThreads);
+		BenchPoolChurn<HeapAllocator_t>(harness, "new", numThreads);
+	}
+}
+
+// ===============================================
+// Sorting
+// ===============================================
+// Element counts instead of cache sizes, the batch bytes count a key and a
+//	32 bit index.
+template<typename Key>
+static std::vector<BatchSize_t> GetSortSizes() {
+	return {
+		{ "1K", 1000 * (sizeof(Key) + 4) },
+		{ "100K", 100000 * (sizeof(Key) + 4) },
+		{ "10M", 10000000 * (sizeof(Key) + 4) },
+	};
+}
+
+template<typename Key>
+static std::vector<Key> MakeSortKeys(size_t count) {
+	std::vector<Key> keys(count);
+
+	for (Key& key : keys) {
+		if constexpr (std::is_floating_point_v<Key>)
+			key = static_cast<Key>(static_cast<int64_t>(rng()) >> 20) * 0.001f;
+		else
+			key = static_cast<Key>(rng());
+	}
+
+	return keys;
+}
+
+// Sorts keys with their indices. Every run starts by copying the unsorted
+//	keys back in, for every variant alike.
+template<typename Key>
+static void BenchSort(Harness& harness, const char* pName) {
+	if (!harness.IsEnabled(pName))
+		return;
+
+	for (const BatchSize_t& batch : GetSortSizes<Key>()) {
+		if (harness.GetOptions().skipDRAM && !strcmp(batch.name, "10M"))
+			continue;
+
+		size_t count = batch.bytes / (sizeof(Key) + 4);
+		std::vector<Key> unsorted = MakeSortKeys<Key>(count);
+		std::vector<Key> keys(count);
+		std::vector<uint32_t> indices(count);
+
+		struct Pair_t {
+			Key key;
+			uint32_t index;
+		};
+
+		std::vector<Pair_t> pairs(count);
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			for (size_t i = 0; i < count; i++) {
+				pairs[i] = { unsorted[i], static_cast<uint32_t>(i) };
+			}
+
+			std::sort(pairs.begin(), pairs.end(), [](const Pair_t& a, const Pair_t& b) { return a.key < b.key; });
+			bench::DoNotOptimize(pairs.data());
+		}, count);
+
+		harness.AddResult(pName, "std::sort", batch, count, ns);
+
+		for (uint32_t numThreads : { 1u, 0u }) {
+			RadixSorter sorter(numThreads);
+			uint32_t usedThreads = sorter.GetNumThreadsFor(count);
+
+			// Small arrays and single core machines would repeat the first run.
+			if (numThreads == 0 && usedThreads == 1)
+				continue;
+
+			ns = harness.MeasureNsPerOp([&]() {
+				std::copy(unsorted.begin(), unsorted.end(), keys.begin());
+
+				for (size_t i = 0; i < count; i++) {
+					indices[i] = static_cast<uint32_t>(i);
+				}
+
+				sorter.Sort(keys.data(), indices.data(), count);
+				bench::DoNotOptimize(keys.data());
+			}, count);
+
+			if (!std::is_sorted(keys.begin(), keys.end())) {
+				fprintf(stderr, "%s with %u threads didn't sort\n", pName, usedThreads);
+				failed = true;
+			}
+
+			// The indices have to be moved along with their keys.
+			for (size_t i = 0; i < count; i++) {
+				if (indices[i] >= count || !(unsorted[indices[i]] == keys[i])) {
+					fprintf(stderr, "%s with %u threads has the wrong index %u at %zu\n", pName, usedThreads, indices[i], i);
+					failed = true;
+					break;
+				}
+			}
+
+			harness.AddResult(pName, "Radix " + std::to_string(usedThreads) + "T", batch, count, ns);
+		}
+	}
+}
+
+// ===============================================
+// Hashing
+// ===============================================
+// Hashes one buffer the size of the batch, counted per byte.
+template<typename HashFn>
+static void BenchHashBulk(Harness& harness, const char* pVariant, HashFn&& hash) {
+	if (!harness.IsEnabled("Hash bulk"))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (SkipBatch(harness, batch))
+			continue;
+
+		std::vector<uint8_t> data(batch.bytes);
+
+		for (uint8_t& byte : data) {
+			byte = static_cast<uint8_t>(rng());
+		}
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			bench::DoNotOptimize(hash(data.data(), data.size()));
+		}, data.size());
+
+		harness.AddThroughput("Hash bulk", pVariant, batch, data.size(), ns);
+	}
+}
+
+// Hashes every key of keySize bytes in an L1 sized buffer, like looking
+//	up cache keys.
+template<typename HashFn>
+static void BenchHashKeys(Harness& harness, const char* pVariant, size_t keySize, HashFn&& hash) {
+	std::string name = "Hash " + std::to_string(keySize) + "B keys";
+
+	if (!harness.IsEnabled(name))
+		return;
+
+	const BatchSize_t& batch = bench::batchSizes[0];
+	size_t count = bench::GetBatchCount(batch, keySize);
+	std::vector<uint8_t> data(count * keySize);
+
+	for (uint8_t& byte : data) {
+		byte = static_cast<uint8_t>(rng());
+	}
+
+	double ns = harness.MeasureNsPerOp([&]() {
+		uint64_t sum = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			sum += hash(data.data() + i * keySize, keySize);
+		}
+
+		bench::DoNotOptimize(sum);
+	}, count);
+
+	harness.AddResult(name, pVariant, batch, count, ns);
+}
+
+template<typename HashFn>
+static void BenchHashFunction(Harness& harness, const char* pVariant, HashFn&& hash) {
+	BenchHashBulk(harness, pVariant, hash);
+
+	for (size_t keySize : { 8, 16, 32, 64, 128, 256 }) {
+		BenchHashKeys(harness, pVariant, keySize, hash);
+	}
+}
+
+// Hash64 and the high half of Hash128 of the bytes i * 131 + 7, worked out
+//	once. Every SIMD path has to give the same results.
+struct KnownHash_t {
+	size_t size;
+	uint64_t seed;
+	uint64_t hash64;
+	uint64_t high128;
+};
+
+static const KnownHash_t knownHashes[] = {
+	{ 0, 0x0000000000000000ull, 0x1D14A72E0BCBA494ull, 0x232E9517EF9E040Dull },
+	{ 0, 0x9E3779B97F4A7C15ull, 0xDF837E697F23CD52ull, 0xF766AECE76ACDE4Aull },
+	{ 5, 0x0000000000000000ull, 0xD68C00B608E906B8ull, 0xF11D60EBE16A751Bull },
+	{ 5, 0x9E3779B97F4A7C15ull, 0xD02F60264164AF20ull, 0xF6C41397B22F4703ull },
+	{ 16, 0x0000000000000000ull, 0x07DE2C102B337B58ull, 0x5A661F90E1586FADull },
+	{ 16, 0x9E3779B97F4A7C15ull, 0xC3207E6C2DBED4F0ull, 0x25F4F801155D4BCFull },
+	{ 100, 0x0000000000000000ull, 0x2CF3B24A36BBB513ull, 0x6139FC6AD509EAF2ull },
+	{ 100, 0x9E3779B97F4A7C15ull, 0xDECDA49D83851434ull, 0xC51EE798AC1F49E5ull },
+	{ 200, 0x0000000000000000ull, 0xC9605D01CD46194Full, 0x47106474BADECD05ull },
+	{ 200, 0x9E3779B97F4A7C15ull, 0x9618F13101863DF5ull, 0xEFE086D2F18ABFCEull },
+	{ 3000, 0x0000000000000000ull, 0x2E9E45FB11B3D7BAull, 0xAF9735C2D9A10366ull },
+	{ 3000, 0x9E3779B97F4A7C15ull, 0x9F1E8E573A031B0Full, 0x4A063492E3C2F2FDull },
+};
+
+// Known answers for the short, medium and striped paths, then random
+//	inputs fed to Hasher in random pieces have to match the one-shot hashes.
+static void CheckHashing() {
+	std::vector<uint8_t> data(4096);
+
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<uint8_t>(i * 131 + 7);
+	}
+
+	for (const KnownHash_t& known : knownHashes) {
+		uint64_t hash = Hash64(data.data(), known.size, known.seed);
+		Hash128_t hash128 = Hash128(data.data(), known.size, known.seed);
+
+		if (hash != known.hash64 || hash128.low != known.hash64 || hash128.high != known.high128) {
+			fprintf(stderr, "Hash of %zu bytes with seed 0x%016llX doesn't match its known value\n", known.size, static_cast<unsigned long long>(known.seed));
+			failed = true;
+		}
+	}
+
+	for (uint8_t& byte : data) {
+		byte = static_cast<uint8_t>(rng());
+	}
+
+	// Pieces up to 300 bytes, some of them empty, cross the 256 byte buffer.
+	for (int run = 0; run < 256; run++) {
+		size_t size = rng() % (data.size() + 1);
+		uint64_t seed = rng();
+
+		Hasher hasher(seed);
+
+		for (size_t offset = 0; offset < size;) {
+			size_t pieceSize = std::min<size_t>(rng() % 301, size - offset);
+
+			hasher.Update(data.data() + offset, pieceSize);
+			offset += pieceSize;
+		}
+
+		uint64_t hash = Hash64(data.data(), size, seed);
+		Hash128_t hash128 = Hash128(data.data(), size, seed);
+
+		if (hasher.Finish() != hash || hasher.Finish128() != hash128) {
+			fprintf(stderr, "Hasher doesn't match the one-shot hash of %zu bytes\n", size);
+			failed = true;
+		}
+
+		if (hash128.low != hash) {
+			fprintf(stderr, "Hash128 of %zu bytes doesn't start with Hash64\n", size);
+			failed = true;
+		}
+	}
+}
+
+static void BenchHashing(Harness& harness) {
+	BenchHashFunction(harness, "Hash64", [](const uint8_t* p, size_t size) {
+		return Hash64(p, size);
+	});
+
+	BenchHashFunction(harness, "Hash128", [](const uint8_t* p, size_t size) {
+		Hash128_t hash = Hash128(p, size);
+		return hash.low ^ hash.high;
+	});
+
+	// Fed in 4KB pieces, like a file read in chunks.
+	BenchHashBulk(harness, "Hasher", [](const uint8_t* p, size_t size) {
+		Hasher hasher;
+
+		for (size_t i = 0; i < size; i += 4096) {
+			hasher.Update(p + i, std::min<size_t>(4096, size - i));
+		}
+
+		return hasher.Finish();
+	});
+
+	BenchHashFunction(harness, "std::hash", [](const uint8_t* p, size_t size) {
+		return static_cast<uint64_t>(std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(p), size)));
+	});
+
+	// What StringId uses.
+	BenchHashFunction(harness, "FNV-1a", [](const uint8_t* p, size_t size) {
+		return static_cast<uint64_t>(HashStringId(std::string_view(reinterpret_cast<const char*>(p), size)));
+	});
+}
+
+int main(int argc, char** argv) {
+	Harness harness(argc, argv);
+
+#if defined(__clang__)
+	harness.AddInfo("compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+	harness.AddInfo("compiler", "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+	harness.AddInfo("compiler", "msvc " + std::to_string(_MSC_FULL_VER));
+#endif
+
+	CheckHashMap();
+	BenchHashMap<FlatHashMap<uint64_t, uint64_t>>(harness, "Flat");
+	BenchHashMap<std::unordered_map<uint64_t, uint64_t>>(harness, "std");
+
+	BenchQueues(harness);
+	BenchRefPtrs(harness);
+	BenchFunctions(harness);
+
+	BenchBitSet<DynamicBits>(harness, "DynamicBitSet");
+	BenchBitSet<VectorBoolBits>(harness, "vector<bool>");
+
+	BenchPool(harness);
+
+	BenchSort<uint32_t>(harness, "Sort u32");
+	BenchSort<uint64_t>(harness, "Sort u64");
+	BenchSort<float>(harness, "Sort float");
+
+	CheckHashing();
+	BenchHashing(harness);
+
+	return harness.WriteJson() && !failed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,886 @@
+// Throughput and accuracy of mathlib, written as JSON to stdout or --out.
+//	Build with the CMakeLists.txt next to FemboyEngine.vcxproj:
+//	  cmake -S . -B build && cmake --build build && build/mathbench --out mathlib.json
+#include "benchmark.h"
+
+#include "mathlib/mathlib.h"
+#include "mathlib/vector.h"
+#include "mathlib/matrix.h"
+#include "mathlib/quaternion.h"
+#include "mathlib/transform.h"
+#include "mathlib/batch.h"
+#include "mathlib/approxmath.h"
+#include "mathlib/packing.h"
+#include "mathlib/bvh.h"
+#include "mathlib/noise.h"
+#include "mathlib/dispatch.h"
+
+#include <cmath>
+#include <random>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace fe;
+using namespace fe::math;
+using bench::Harness;
+using bench::BatchSize_t;
+using bench::Tolerance_t;
+using bench::AbsTolerance;
+using bench::RelTolerance;
+
+// ===============================================
+// Helpers
+// ===============================================
+static std::mt19937 rng(1234);
+
+static float RandomFloat(float low = -1.f, float high = 1.f) {
+	return std::uniform_real_distribution<float>(low, high)(rng);
+}
+
+template<typename T>
+static T Random();
+
+template<>
+float Random<float>() {
+	return RandomFloat();
+}
+
+template<>
+Vector3 Random<Vector3>() {
+	return Vector3(RandomFloat(), RandomFloat(), RandomFloat());
+}
+
+template<>
+Vector4 Random<Vector4>() {
+	return Vector4(RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat());
+}
+
+template<>
+Quaternion Random<Quaternion>() {
+	return NormalizeQuaternion(Quaternion(RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat()));
+}
+
+template<>
+Matrix3x4 Random<Matrix3x4>() {
+	Vector3 scale(RandomFloat(0.5f, 2.f), RandomFloat(0.5f, 2.f), RandomFloat(0.5f, 2.f));
+
+	return MakeAffineMatrix(Random<Vector3>() * 10.f, Random<Quaternion>(), scale);
+}
+
+// General matrices, kept away from singular by a dominant diagonal.
+template<>
+Matrix4x4 Random<Matrix4x4>() {
+	Matrix4x4 M(Random<Vector4>(), Random<Vector4>(), Random<Vector4>(), Random<Vector4>());
+
+	return M + Matrix4x4::Identity() * 4.f;
+}
+
+static Matrix4x4 RandomAffineMatrix() {
+	return Matrix4x4(Random<Matrix3x4>());
+}
+
+static Matrix4x4 RandomRigidMatrix() {
+	return Matrix4x4(MakeAffineMatrix(Random<Vector3>() * 10.f, Random<Quaternion>(), Vector3(1.f, 1.f, 1.f)));
+}
+
+static bool IsSimdLevelSupported(SimdLevel::Enum level) {
+#if !FE_SIMD_SSE
+	return level == SimdLevel::Scalar;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuidex(info, 7, 0);
+	bool hasAVX2 = (info[1] & (1 << 5)) != 0;
+	bool hasAVX512F = (info[1] & (1 << 16)) != 0;
+	__cpuid(info, 1);
+	bool hasFMA = (info[2] & (1 << 12)) != 0;
+	bool hasF16C = (info[2] & (1 << 29)) != 0;
+	// The OS has to save the YMM registers, see cpuinfo.cpp.
+	bool hasOSYmmState = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+	switch (level) {
+	case SimdLevel::AVX2: return hasAVX2 && hasFMA && hasF16C && hasOSYmmState;
+	case SimdLevel::AVX512: return hasAVX512F;
+	default: return true;
+	}
+#else
+	switch (level) {
+	case SimdLevel::AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+	case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+	default: return true;
+	}
+#endif
+}
+
+static float MaxAbsDifference(const Vector4& A, const Vector4& B) {
+	return fmaxf(fmaxf(fabsf(A.x - B.x), fabsf(A.y - B.y)), fmaxf(fabsf(A.z - B.z), fabsf(A.w - B.w)));
+}
+
+static float MaxAbsDifference(const Matrix4x4& A, const Matrix4x4& B) {
+	float result = 0.f;
+
+	for (int i = 0; i < 4; i++) {
+		result = fmaxf(result, MaxAbsDifference(A[i], B[i]));
+	}
+
+	return result;
+}
+
+static float MaxAbsDifference(const Matrix3x4& A, const Matrix3x4& B) {
+	return MaxAbsDifference(Matrix4x4(A), Matrix4x4(B));
+}
+
+// ===============================================
+// Benchmark runners
+// ===============================================
+// out[i] = fn(in[i]) over every batch size.
+template<typename Out, typename In, typename Fn>
+static void BenchUnary(Harness& harness, const std::string& name, const char* pVariant, Fn fn, In(*pGenerate)() = Random<In>) {
+	if (!harness.IsEnabled(name))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (harness.GetOptions().skipDRAM && !strcmp(batch.name, "DRAM"))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, sizeof(In) + sizeof(Out));
+		std::vector<In> in(count);
+		std::vector<Out> out(count);
+
+		for (In& value : in) {
+			value = pGenerate();
+		}
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = fn(in[i]);
+			}
+
+			bench::DoNotOptimize(out.data());
+		}, count);
+
+		harness.AddResult(name, pVariant, batch, count, ns);
+	}
+}
+
+// out[i] = fn(a[i], b[i]) over every batch size.
+template<typename Out, typename InA, typename InB, typename Fn>
+static void BenchBinary(Harness& harness, const std::string& name, const char* pVariant, Fn fn, InA(*pGenerateA)() = Random<InA>, InB(*pGenerateB)() = Random<InB>) {
+	if (!harness.IsEnabled(name))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (harness.GetOptions().skipDRAM && !strcmp(batch.name, "DRAM"))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, sizeof(InA) + sizeof(InB) + sizeof(Out));
+		std::vector<InA> a(count);
+		std::vector<InB> b(count);
+		std::vector<Out> out(count);
+
+		for (size_t i = 0; i < count; i++) {
+			a[i] = pGenerateA();
+			b[i] = pGenerateB();
+		}
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = fn(a[i], b[i]);
+			}
+
+			bench::DoNotOptimize(out.data());
+		}, count);
+
+		harness.AddResult(name, pVariant, batch, count, ns);
+	}
+}
+
+constexpr size_t MaxArrays = 8;
+
+// fn(inputs, outputs, count) over up to MaxArrays float arrays filled with values in [low, high].
+template<typename Fn>
+static void BenchArrays(Harness& harness, const std::string& name, const char* pVariant, size_t numInputs, size_t numOutputs, float low, float high, Fn fn) {
+	if (!harness.IsEnabled(name))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (harness.GetOptions().skipDRAM && !strcmp(batch.name, "DRAM"))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, sizeof(float) * (numInputs + numOutputs));
+		std::vector<std::vector<float>> inputs(numInputs, std::vector<float>(count));
+		std::vector<std::vector<float>> outputs(numOutputs, std::vector<float>(count));
+		const float* pInputs[MaxArrays] = {};
+		float* pOutputs[MaxArrays] = {};
+
+		for (size_t i = 0; i < numInputs; i++) {
+			for (float& value : inputs[i]) {
+				value = RandomFloat(low, high);
+			}
+
+			pInputs[i] = inputs[i].data();
+		}
+
+		for (size_t i = 0; i < numOutputs; i++) {
+			pOutputs[i] = outputs[i].data();
+		}
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			fn(pInputs, pOutputs, count);
+
+			bench::DoNotOptimize(pOutputs[0]);
+		}, count);
+
+		harness.AddResult(name, pVariant, batch, count, ns);
+	}
+}
+
+// ===============================================
+// vector.h
+// ===============================================
+static void BenchVectors(Harness& harness) {
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "Vector3::operator+", "Inline", [](const Vector3& a, const Vector3& b) { return a + b; });
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "Vector3::operator-", "Inline", [](const Vector3& a, const Vector3& b) { return a - b; });
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "Vector3::operator*", "Inline", [](const Vector3& a, const Vector3& b) { return a * b; });
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "Vector3::operator/", "Inline", [](const Vector3& a, const Vector3& b) { return a / b; });
+	BenchBinary<Vector3, Vector3, float>(harness, "Vector3::operator*(float)", "Inline", [](const Vector3& a, float s) { return a * s; });
+
+	BenchBinary<Vector4, Vector4, Vector4>(harness, "Vector4::operator+", "Inline", [](const Vector4& a, const Vector4& b) { return a + b; });
+	BenchBinary<Vector4, Vector4, Vector4>(harness, "Vector4::operator-", "Inline", [](const Vector4& a, const Vector4& b) { return a - b; });
+	BenchBinary<Vector4, Vector4, Vector4>(harness, "Vector4::operator*", "Inline", [](const Vector4& a, const Vector4& b) { return a * b; });
+	BenchBinary<Vector4, Vector4, Vector4>(harness, "Vector4::operator/", "Inline", [](const Vector4& a, const Vector4& b) { return a / b; });
+	BenchBinary<Vector4, Vector4, float>(harness, "Vector4::operator*(float)", "Inline", [](const Vector4& a, float s) { return a * s; });
+
+	BenchUnary<Vector3, Vector4>(harness, "Swizzle<2,1,0>", "Inline", [](const Vector4& v) { return Swizzle<2, 1, 0>(v); });
+	BenchUnary<float, Vector3>(harness, "VectorLengthSqr", "Inline", [](const Vector3& v) { return VectorLengthSqr(v); });
+	BenchUnary<float, Vector3>(harness, "VectorLength", "Inline", [](const Vector3& v) { return VectorLength(v); });
+	BenchBinary<float, Vector3, Vector3>(harness, "DotProduct(Vector3)", "Inline", [](const Vector3& a, const Vector3& b) { return DotProduct(a, b); });
+	BenchBinary<float, Vector4, Vector4>(harness, "DotProduct(Vector4)", "Inline", [](const Vector4& a, const Vector4& b) { return DotProduct(a, b); });
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "CrossProduct", "Inline", [](const Vector3& a, const Vector3& b) { return CrossProduct(a, b); });
+	BenchUnary<Vector3, Vector3>(harness, "NormalizeVector", "Inline", [](const Vector3& v) { return NormalizeVector(v); });
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "VectorAdd", "Inline", [](const Vector3& a, const Vector3& b) { return VectorAdd(a, b); });
+	BenchBinary<Vector3, Vector3, Vector3>(harness, "VectorSubtract", "Inline", [](const Vector3& a, const Vector3& b) { return VectorSubtract(a, b); });
+}
+
+// ===============================================
+// matrix.h
+// ===============================================
+static void BenchMatrices(Harness& harness) {
+	BenchUnary<Matrix4x4, float>(harness, "MakePerspectiveFovRH", "Inline", [](float f) { return MakePerspectiveFovRH(1.f + f * 0.5f, 1.7f, 0.01f, 100.f); });
+	BenchUnary<Matrix4x4, float>(harness, "MakePerspectiveFovRH", "Scalar", [](float f) { return MakePerspectiveFovRH_Scalar(1.f + f * 0.5f, 1.7f, 0.01f, 100.f); });
+	BenchUnary<Matrix4x4, float>(harness, "MakePerspectiveFovLH", "Inline", [](float f) { return MakePerspectiveFovLH(1.f + f * 0.5f, 1.7f, 0.01f, 100.f); });
+
+	BenchBinary<Matrix4x4, Vector3, Vector3>(harness, "MakeLookToRH", "Inline", [](const Vector3& eye, const Vector3& forward) { return MakeLookToRH(eye, forward, Vector3(0.f, 1.f, 0.f)); });
+	BenchBinary<Matrix4x4, Vector3, Vector3>(harness, "MakeLookToRH", "Scalar", [](const Vector3& eye, const Vector3& forward) { return MakeLookToRH_Scalar(eye, forward, Vector3(0.f, 1.f, 0.f)); });
+	BenchBinary<Matrix4x4, Vector3, Vector3>(harness, "MakeLookAtRH", "Inline", [](const Vector3& eye, const Vector3& focus) { return MakeLookAtRH(eye, focus, Vector3(0.f, 1.f, 0.f)); });
+
+	BenchBinary<Matrix4x4, Matrix4x4, Matrix4x4>(harness, "MatrixMultiply", "Inline", [](const Matrix4x4& A, const Matrix4x4& B) { return MatrixMultiply(A, B); });
+	BenchBinary<Matrix4x4, Matrix4x4, Matrix4x4>(harness, "MatrixMultiply", "Scalar", [](const Matrix4x4& A, const Matrix4x4& B) { return MatrixMultiply_Scalar(A, B); });
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "TransposeMatrix", "Inline", [](const Matrix4x4& M) { return TransposeMatrix(M); });
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "TransposeMatrix", "Scalar", [](const Matrix4x4& M) { return TransposeMatrix_Scalar(M); });
+	BenchBinary<Vector4, Matrix4x4, Vector4>(harness, "TransformVector", "Inline", [](const Matrix4x4& M, const Vector4& v) { return TransformVector(M, v); });
+	BenchBinary<Vector4, Matrix4x4, Vector4>(harness, "TransformVector", "Scalar", [](const Matrix4x4& M, const Vector4& v) { return TransformVector_Scalar(M, v); });
+
+	BenchUnary<Matrix3x4, Matrix4x4>(harness, "ToMatrix3x4", "Inline", [](const Matrix4x4& M) { return ToMatrix3x4(M); });
+	BenchBinary<Matrix3x4, Matrix3x4, Matrix3x4>(harness, "AffineMultiply", "Inline", [](const Matrix3x4& A, const Matrix3x4& B) { return AffineMultiply(A, B); });
+	BenchBinary<Matrix3x4, Matrix3x4, Matrix3x4>(harness, "AffineMultiply", "Scalar", [](const Matrix3x4& A, const Matrix3x4& B) { return AffineMultiply_Scalar(A, B); });
+	BenchBinary<Vector3, Matrix3x4, Vector3>(harness, "TransformPoint", "Inline", [](const Matrix3x4& M, const Vector3& p) { return TransformPoint(M, p); });
+	BenchBinary<Vector3, Matrix3x4, Vector3>(harness, "TransformDirection", "Inline", [](const Matrix3x4& M, const Vector3& d) { return TransformDirection(M, d); });
+
+	// Inverses, the scalar rows are the reference the SIMD versions are measured against.
+	auto invert = [](const Matrix4x4& M) { Matrix4x4 inverse; InvertMatrix(M, inverse); return inverse; };
+	auto invertAffine = [](const Matrix4x4& M) { Matrix4x4 inverse; InvertAffineMatrix(M, inverse); return inverse; };
+	auto invertAffine3x4 = [](const Matrix3x4& M) { Matrix3x4 inverse; InvertAffineMatrix(M, inverse); return inverse; };
+	auto invertRigid = [](const Matrix4x4& M) { Matrix4x4 inverse; InvertRigidMatrix(M, inverse); return inverse; };
+
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "InvertMatrix", "Inline", invert);
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "InvertMatrix", "Scalar", [](const Matrix4x4& M) { float determinant; return InverseMatrix_Scalar(M, &determinant); });
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "InvertAffineMatrix", "Inline", invertAffine, RandomAffineMatrix);
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "InvertAffineMatrix", "Scalar", [](const Matrix4x4& M) { float determinant; return InverseAffineMatrix_Scalar(M, &determinant); }, RandomAffineMatrix);
+	BenchUnary<Matrix3x4, Matrix3x4>(harness, "InvertAffineMatrix(Matrix3x4)", "Inline", invertAffine3x4);
+	BenchUnary<Matrix3x4, Matrix3x4>(harness, "AffineInverse", "Inline", [](const Matrix3x4& M) { return AffineInverse(M); });
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "InvertRigidMatrix", "Inline", invertRigid, RandomRigidMatrix);
+	BenchUnary<Matrix4x4, Matrix4x4>(harness, "InvertRigidMatrix", "Scalar", [](const Matrix4x4& M) { float determinant; return InverseRigidMatrix_Scalar(M, &determinant); }, RandomRigidMatrix);
+}
+
+// ===============================================
+// quaternion.h and transform.h
+// ===============================================
+static void BenchQuaternions(Harness& harness) {
+	BenchBinary<Quaternion, Quaternion, Quaternion>(harness, "QuaternionMultiply", "Inline", [](const Quaternion& A, const Quaternion& B) { return QuaternionMultiply(A, B); });
+	BenchBinary<Vector3, Quaternion, Vector3>(harness, "RotateVector", "Inline", [](const Quaternion& q, const Vector3& v) { return RotateVector(q, v); });
+	BenchBinary<Quaternion, Quaternion, Quaternion>(harness, "QuaternionNlerp", "Inline", [](const Quaternion& A, const Quaternion& B) { return QuaternionNlerp(A, B, 0.3f); });
+	BenchBinary<Quaternion, Quaternion, Quaternion>(harness, "QuaternionSlerp", "Inline", [](const Quaternion& A, const Quaternion& B) { return QuaternionSlerp(A, B, 0.3f); });
+	BenchBinary<Matrix3x4, Vector3, Quaternion>(harness, "MakeAffineMatrix", "Inline", [](const Vector3& t, const Quaternion& q) { return MakeAffineMatrix(t, q, Vector3(1.f, 2.f, 3.f)); });
+}
+
+// ===============================================
+// batch.h and approxmath.h, once per SIMD level
+// ===============================================
+static void BenchBatchKernels(Harness& harness, const char* pVariant) {
+	Matrix3x4 M = Random<Matrix3x4>();
+
+	BenchArrays(harness, "TransformPoints", pVariant, 3, 3, -10.f, 10.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+		TransformPoints(M, pIn[0], pIn[1], pIn[2], count, pOut[0], pOut[1], pOut[2]);
+	});
+	BenchArrays(harness, "TransformDirections", pVariant, 3, 3, -10.f, 10.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+		TransformDirections(M, pIn[0], pIn[1], pIn[2], count, pOut[0], pOut[1], pOut[2]);
+	});
+	BenchArrays(harness, "NormalizeVectors", pVariant, 3, 3, 0.1f, 10.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+		NormalizeVectors(pIn[0], pIn[1], pIn[2], count, pOut[0], pOut[1], pOut[2]);
+	});
+}
+
+static void BenchApproxMath(Harness& harness, const char* pVariant) {
+	BenchArrays(harness, "SinArray", pVariant, 1, 1, -100.f, 100.f, [](const float* const* pIn, float* const* pOut, size_t count) { SinArray(pIn[0], count, pOut[0]); });
+	BenchArrays(harness, "CosArray", pVariant, 1, 1, -100.f, 100.f, [](const float* const* pIn, float* const* pOut, size_t count) { CosArray(pIn[0], count, pOut[0]); });
+	BenchArrays(harness, "SinCosArray", pVariant, 1, 2, -100.f, 100.f, [](const float* const* pIn, float* const* pOut, size_t count) { SinCosArray(pIn[0], count, pOut[0], pOut[1]); });
+	BenchArrays(harness, "ExpArray", pVariant, 1, 1, -80.f, 80.f, [](const float* const* pIn, float* const* pOut, size_t count) { ExpArray(pIn[0], count, pOut[0]); });
+	BenchArrays(harness, "LogArray", pVariant, 1, 1, 1e-3f, 1e3f, [](const float* const* pIn, float* const* pOut, size_t count) { LogArray(pIn[0], count, pOut[0]); });
+	BenchArrays(harness, "Atan2Array", pVariant, 2, 1, -10.f, 10.f, [](const float* const* pIn, float* const* pOut, size_t count) { Atan2Array(pIn[0], pIn[1], count, pOut[0]); });
+	BenchArrays(harness, "RsqrtArray", pVariant, 1, 1, 1e-3f, 1e3f, [](const float* const* pIn, float* const* pOut, size_t count) { RsqrtArray(pIn[0], count, pOut[0]); });
+	BenchArrays(harness, "RcpArray", pVariant, 1, 1, 1e-3f, 1e3f, [](const float* const* pIn, float* const* pOut, size_t count) { RcpArray(pIn[0], count, pOut[0]); });
+}
+
+// Outputs narrower than a float reuse the float output arrays.
+static void BenchPacking(Harness& harness, const char* pVariant) {
+	BenchArrays(harness, "FloatToHalfArray", pVariant, 1, 1, -1000.f, 1000.f, [](const float* const* pIn, float* const* pOut, size_t count) {
+		FloatToHalfArray(pIn[0], count, reinterpret_cast<uint16_t*>(pOut[0]));
+	});
+	BenchArrays(harness, "HalfToFloatArray", pVariant, 1, 1, -1000.f, 1000.f, [](const float* const* pIn, float* const* pOut, size_t count) {
+		HalfToFloatArray(reinterpret_cast<const uint16_t*>(pIn[0]), count, pOut[0]);
+	});
+	BenchArrays(harness, "PackSnorm16Array", pVariant, 1, 1, -1.f, 1.f, [](const float* const* pIn, float* const* pOut, size_t count) {
+		PackSnorm16Array(pIn[0], count, reinterpret_cast<int16_t*>(pOut[0]));
+	});
+	BenchArrays(harness, "UnpackSnorm16Array", pVariant, 1, 1, -1.f, 1.f, [](const float* const* pIn, float* const* pOut, size_t count) {
+		UnpackSnorm16Array(reinterpret_cast<const int16_t*>(pIn[0]), count, pOut[0]);
+	});
+	BenchArrays(harness, "PackOctahedralNormals", pVariant, 3, 1, -1.f, 1.f, [](const float* const* pIn, float* const* pOut, size_t count) {
+		PackOctahedralNormals(pIn[0], pIn[1], pIn[2], count, reinterpret_cast<uint32_t*>(pOut[0]));
+	});
+	BenchArrays(harness, "UnpackOctahedralNormals", pVariant, 1, 3, -1.f, 1.f, [](const float* const* pIn, float* const* pOut, size_t count) {
+		UnpackOctahedralNormals(reinterpret_cast<const uint32_t*>(pIn[0]), count, pOut[0], pOut[1], pOut[2]);
+	});
+
+	std::vector<PackedTangentFrame_t> frames;
+
+	BenchArrays(harness, "PackTangentFrames", pVariant, 7, 2, -1.f, 1.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+		if (frames.size() < count)
+			frames.resize(count);
+
+		PackTangentFrames(pIn[0], pIn[1], pIn[2], pIn[3], pIn[4], pIn[5], pIn[6], count, frames.data());
+		pOut[0][0] = static_cast<float>(frames[0].normal);
+	});
+}
+
+// ===============================================
+// intersect.h and bvh.h
+// ===============================================
+// Rays start near the origin and boxes, spheres and triangles are scattered
+//	around it, so roughly half of the tests hit.
+static Ray_t RandomRay() {
+	return { Random<Vector3>(), NormalizeVector(Random<Vector3>() + Vector3(1e-3f, 0.f, 0.f)) };
+}
+
+static AABB_t RandomAABB() {
+	Vector3 center = Random<Vector3>() * 4.f;
+	Vector3 extent(RandomFloat(0.5f, 2.f), RandomFloat(0.5f, 2.f), RandomFloat(0.5f, 2.f));
+
+	return { center - extent, center + extent };
+}
+
+// fn(packet, pDistances) returns the hit mask, results are per lane.
+template<typename Packet, size_t Lanes, typename Fill, typename Fn>
+static void BenchPackets(Harness& harness, const std::string& name, const char* pVariant, Fill fill, Fn fn) {
+	if (!harness.IsEnabled(name))
+		return;
+
+	for (const BatchSize_t& batch : bench::batchSizes) {
+		if (harness.GetOptions().skipDRAM && !strcmp(batch.name, "DRAM"))
+			continue;
+
+		size_t count = bench::GetBatchCount(batch, sizeof(Packet));
+		std::vector<Packet> packets(count);
+
+		for (Packet& packet : packets) {
+			for (size_t lane = 0; lane < Lanes; lane++) {
+				fill(packet, lane);
+			}
+		}
+
+		alignas(32) float distances[Lanes];
+		uint32_t hits = 0;
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			for (const Packet& packet : packets) {
+				hits += fn(packet, distances);
+			}
+
+			bench::DoNotOptimize(hits);
+		}, count * Lanes);
+
+		harness.AddResult(name, pVariant, batch, count * Lanes, ns);
+	}
+}
+
+static void BenchIntersect(Harness& harness, const char* pVariant) {
+	Ray_t ray = RandomRay();
+	Vector3 v0 = Random<Vector3>() * 4.f, v1 = Random<Vector3>() * 4.f, v2 = Random<Vector3>() * 4.f;
+	Plane_t plane = { NormalizeVector(Random<Vector3>() + Vector3(1e-3f, 0.f, 0.f)), RandomFloat() };
+
+	auto fillAABBs = [](auto& boxes, size_t lane) { SetAABB(boxes, lane, RandomAABB()); };
+	auto fillSpheres = [](auto& spheres, size_t lane) { SetSphere(spheres, lane, { Random<Vector3>() * 4.f, RandomFloat(0.5f, 2.f) }); };
+	auto fillRays = [](auto& rays, size_t lane) { SetRay(rays, lane, RandomRay()); };
+
+	BenchPackets<AABBx4_t, 4>(harness, "IntersectRayAABBx4", pVariant, fillAABBs, [&](const AABBx4_t& boxes, float* pDistances) {
+		return IntersectRayAABBx4(ray, boxes, 100.f, pDistances);
+	});
+	BenchPackets<AABBx8_t, 8>(harness, "IntersectRayAABBx8", pVariant, fillAABBs, [&](const AABBx8_t& boxes, float* pDistances) {
+		return IntersectRayAABBx8(ray, boxes, 100.f, pDistances);
+	});
+	BenchPackets<Spherex4_t, 4>(harness, "IntersectRaySpherex4", pVariant, fillSpheres, [&](const Spherex4_t& spheres, float* pDistances) {
+		return IntersectRaySpherex4(ray, spheres, 100.f, pDistances);
+	});
+	BenchPackets<Spherex8_t, 8>(harness, "IntersectRaySpherex8", pVariant, fillSpheres, [&](const Spherex8_t& spheres, float* pDistances) {
+		return IntersectRaySpherex8(ray, spheres, 100.f, pDistances);
+	});
+	BenchPackets<RayPacket4_t, 4>(harness, "IntersectRayPacketTriangle4", pVariant, fillRays, [&](const RayPacket4_t& rays, float* pDistances) {
+		return IntersectRayPacketTriangle(rays, v0, v1, v2, 100.f, pDistances);
+	});
+	BenchPackets<RayPacket8_t, 8>(harness, "IntersectRayPacketTriangle8", pVariant, fillRays, [&](const RayPacket8_t& rays, float* pDistances) {
+		return IntersectRayPacketTriangle(rays, v0, v1, v2, 100.f, pDistances);
+	});
+	BenchPackets<RayPacket4_t, 4>(harness, "IntersectRayPacketPlane4", pVariant, fillRays, [&](const RayPacket4_t& rays, float* pDistances) {
+		return IntersectRayPacketPlane(rays, plane, 100.f, pDistances);
+	});
+	BenchPackets<RayPacket8_t, 8>(harness, "IntersectRayPacketPlane8", pVariant, fillRays, [&](const RayPacket8_t& rays, float* pDistances) {
+		return IntersectRayPacketPlane(rays, plane, 100.f, pDistances);
+	});
+}
+
+// A sphere of 2 * 128 * 256 triangles with rays from outside aimed near the
+//	center, the batch is the size of the tree.
+static void BenchBVH(Harness& harness, const char* pVariant, const BVH4& bvh) {
+	const char* pNames[] = { "BVH4::Raycast", "BVH4::Occluded" };
+
+	for (int occluded = 0; occluded < 2; occluded++) {
+		if (!harness.IsEnabled(pNames[occluded]))
+			continue;
+
+		std::vector<Ray_t> rays(4096);
+		for (Ray_t& ray : rays) {
+			ray.origin = NormalizeVector(Random<Vector3>() + Vector3(1e-3f, 0.f, 0.f)) * 20.f;
+			ray.direction = NormalizeVector(Random<Vector3>() * 5.f - ray.origin);
+		}
+
+		uint32_t hits = 0;
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			for (const Ray_t& ray : rays) {
+				RayHit_t hit;
+				hits += occluded ? bvh.Occluded(ray, 100.f) : bvh.Raycast(ray, 100.f, hit);
+			}
+
+			bench::DoNotOptimize(hits);
+		}, rays.size());
+
+		BatchSize_t batch = { "Tree", bvh.GetNodes().size() * sizeof(BVH4Node_t) + bvh.GetLeaves().size() * sizeof(BVH4Leaf_t) };
+		harness.AddResult(pNames[occluded], pVariant, batch, rays.size(), ns);
+	}
+}
+
+static void BuildSphereMesh(BVH4& bvh) {
+	constexpr uint32_t rings = 128, segments = 256;
+	std::vector<Vector3> positions;
+	std::vector<uint32_t> indices;
+
+	for (uint32_t ring = 0; ring <= rings; ring++) {
+		for (uint32_t segment = 0; segment <= segments; segment++) {
+			float theta = Pi * ring / rings;
+			float phi = 2.f * Pi * segment / segments;
+
+			positions.push_back(Vector3(Sin(theta) * Cos(phi), Cos(theta), Sin(theta) * Sin(phi)) * 5.f);
+		}
+	}
+
+	for (uint32_t ring = 0; ring < rings; ring++) {
+		for (uint32_t segment = 0; segment < segments; segment++) {
+			uint32_t first = ring * (segments + 1) + segment;
+			uint32_t second = first + segments + 1;
+
+			indices.insert(indices.end(), { first, second, first + 1, second, second + 1, first + 1 });
+		}
+	}
+
+	bvh.Build(positions.data(), indices.data(), indices.size() / 3);
+}
+
+// ===============================================
+// noise.h
+// ===============================================
+static void BenchNoise(Harness& harness, const char* pVariant) {
+	const char* pTypeNames[] = { "Value", "Perlin", "Simplex", "Cellular" };
+
+	for (uint32_t type = NoiseType::Value; type <= NoiseType::Cellular; type++) {
+		NoiseParams_t params;
+		params.type = static_cast<NoiseType::Enum>(type);
+		params.frequency = 0.05f;
+
+		BenchArrays(harness, std::string("NoiseArray2D/") + pTypeNames[type], pVariant, 2, 1, -1000.f, 1000.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+			NoiseArray2D(params, pIn[0], pIn[1], count, pOut[0]);
+		});
+		BenchArrays(harness, std::string("NoiseArray3D/") + pTypeNames[type], pVariant, 3, 1, -1000.f, 1000.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+			NoiseArray3D(params, pIn[0], pIn[1], pIn[2], count, pOut[0]);
+		});
+	}
+
+	// Per sample cost of a typical terrain heightmap, 6 octaves of simplex.
+	NoiseParams_t terrain;
+	terrain.frequency = 0.01f;
+	terrain.octaves = 6;
+
+	BenchArrays(harness, "NoiseArray2D/SimplexFBm6", pVariant, 2, 1, -1000.f, 1000.f, [&](const float* const* pIn, float* const* pOut, size_t count) {
+		NoiseArray2D(terrain, pIn[0], pIn[1], count, pOut[0]);
+	});
+
+	const char* pGridNames[] = { "FillNoiseGrid2D/1Thread", "FillNoiseGrid2D/AllThreads" };
+	constexpr uint32_t gridSize = 256;
+	std::vector<float> grid(gridSize * gridSize);
+
+	for (uint32_t i = 0; i < 2; i++) {
+		if (!harness.IsEnabled(pGridNames[i]))
+			continue;
+
+		double ns = harness.MeasureNsPerOp([&]() {
+			FillNoiseGrid2D(terrain, 0.f, 0.f, 1.f, gridSize, gridSize, grid.data(), i == 0 ? 1 : 0);
+
+			bench::DoNotOptimize(grid.data());
+		}, grid.size());
+
+		BatchSize_t batch = { "256x256", grid.size() * sizeof(float) };
+		harness.AddResult(pGridNames[i], pVariant, batch, grid.size(), ns);
+	}
+}
+
+// ===============================================
+// Accuracy
+// ===============================================
+constexpr size_t AccuracySamples = 1 << 20;
+
+// SIMD paths against their scalar references. They only differ by rounding,
+//	when the compiler contracts one of them into FMAs.
+constexpr double SimdVsScalarTolerance = 1e-5;
+
+// Residual allowed for the inverses of the random matrices. The seed is
+//	fixed, so the worst case doesn't change between runs.
+constexpr double InverseTolerance = 1e-4;
+
+static void CheckMatrixAccuracy(Harness& harness) {
+	constexpr size_t numSamples = AccuracySamples / 16;
+	float multiply = 0.f, transpose = 0.f, transform = 0.f, affine = 0.f, lookTo = 0.f, perspective = 0.f;
+
+	for (size_t i = 0; i < numSamples; i++) {
+		Matrix4x4 A = Random<Matrix4x4>(), B = Random<Matrix4x4>();
+		Matrix3x4 C = Random<Matrix3x4>(), D = Random<Matrix3x4>();
+		Vector4 v = Random<Vector4>();
+		Vector3 eye = Random<Vector3>(), forward = NormalizeVector(Random<Vector3>() + Vector3(0.f, 0.f, 2.f));
+		float fov = RandomFloat(0.5f, 2.f);
+
+		multiply = fmaxf(multiply, MaxAbsDifference(MatrixMultiply(A, B), MatrixMultiply_Scalar(A, B)));
+		transpose = fmaxf(transpose, MaxAbsDifference(TransposeMatrix(A), TransposeMatrix_Scalar(A)));
+		transform = fmaxf(transform, MaxAbsDifference(TransformVector(A, v), TransformVector_Scalar(A, v)));
+		affine = fmaxf(affine, MaxAbsDifference(AffineMultiply(C, D), AffineMultiply_Scalar(C, D)));
+		lookTo = fmaxf(lookTo, MaxAbsDifference(MakeLookToRH(eye, forward, Vector3(0.f, 1.f, 0.f)), MakeLookToRH_Scalar(eye, forward, Vector3(0.f, 1.f, 0.f))));
+		perspective = fmaxf(perspective, MaxAbsDifference(MakePerspectiveFovRH(fov, 1.7f, 0.01f, 100.f), MakePerspectiveFovRH_Scalar(fov, 1.7f, 0.01f, 100.f)));
+	}
+
+	const Tolerance_t tolerance = AbsTolerance(SimdVsScalarTolerance);
+
+	harness.AddAccuracy("MatrixMultiply", "Inline vs Scalar", numSamples, multiply, 0.0, tolerance);
+	harness.AddAccuracy("TransposeMatrix", "Inline vs Scalar", numSamples, transpose, 0.0, tolerance);
+	harness.AddAccuracy("TransformVector", "Inline vs Scalar", numSamples, transform, 0.0, tolerance);
+	harness.AddAccuracy("AffineMultiply", "Inline vs Scalar", numSamples, affine, 0.0, tolerance);
+	harness.AddAccuracy("MakeLookToRH", "Inline vs Scalar", numSamples, lookTo, 0.0, tolerance);
+	harness.AddAccuracy("MakePerspectiveFovRH", "Inline vs Scalar", numSamples, perspective, 0.0, tolerance);
+}
+
+// Largest element of M * inverse - identity.
+static void CheckInverseAccuracy(Harness& harness) {
+	constexpr size_t numSamples = AccuracySamples / 16;
+	float general = 0.f, generalScalar = 0.f, affine = 0.f, affineScalar = 0.f, rigid = 0.f, rigidScalar = 0.f;
+
+	for (size_t i = 0; i < numSamples; i++) {
+		Matrix4x4 M = Random<Matrix4x4>(), A = RandomAffineMatrix(), R = RandomRigidMatrix();
+		Matrix4x4 inverse;
+		float determinant;
+
+		InvertMatrix(M, inverse);
+		general = fmaxf(general, MaxAbsDifference(MatrixMultiply_Scalar(M, inverse), Matrix4x4::Identity()));
+		generalScalar = fmaxf(generalScalar, MaxAbsDifference(MatrixMultiply_Scalar(M, InverseMatrix_Scalar(M, &determinant)), Matrix4x4::Identity()));
+
+		InvertAffineMatrix(A, inverse);
+		affine = fmaxf(affine, MaxAbsDifference(MatrixMultiply_Scalar(A, inverse), Matrix4x4::Identity()));
+		affineScalar = fmaxf(affineScalar, MaxAbsDifference(MatrixMultiply_Scalar(A, InverseAffineMatrix_Scalar(A, &determinant)), Matrix4x4::Identity()));
+
+		InvertRigidMatrix(R, inverse);
+		rigid = fmaxf(rigid, MaxAbsDifference(MatrixMultiply_Scalar(R, inverse), Matrix4x4::Identity()));
+		rigidScalar = fmaxf(rigidScalar, MaxAbsDifference(MatrixMultiply_Scalar(R, InverseRigidMatrix_Scalar(R, &determinant)), Matrix4x4::Identity()));
+	}
+
+	const Tolerance_t tolerance = AbsTolerance(InverseTolerance);
+
+	harness.AddAccuracy("InvertMatrix", "Inline", numSamples, general, 0.0, tolerance);
+	harness.AddAccuracy("InvertMatrix", "Scalar", numSamples, generalScalar, 0.0, tolerance);
+	harness.AddAccuracy("InvertAffineMatrix", "Inline", numSamples, affine, 0.0, tolerance);
+	harness.AddAccuracy("InvertAffineMatrix", "Scalar", numSamples, affineScalar, 0.0, tolerance);
+	harness.AddAccuracy("InvertRigidMatrix", "Inline", numSamples, rigid, 0.0, tolerance);
+	harness.AddAccuracy("InvertRigidMatrix", "Scalar", numSamples, rigidScalar, 0.0, tolerance);
+}
+
+// Sweeps the documented input range of every approximation against double
+//	precision libm and fails when it is outside the bound approxmath.h
+//	documents. A nonzero maxUlps also bounds each result to that many units
+//	in the last place of the correctly rounded float.
+template<typename Fn, typename Reference>
+static void CheckApproxFunction(Harness& harness, const char* pName, const char* pVariant, float low, float high, bool logSpaced, Fn fn, Reference reference, const Tolerance_t& tolerance, double maxUlps = 0.0) {
+	std::vector<float> in(AccuracySamples), out(AccuracySamples);
+
+	for (size_t i = 0; i < AccuracySamples; i++) {
+		double t = static_cast<double>(i) / static_cast<double>(AccuracySamples - 1);
+
+		if (logSpaced)
+			in[i] = static_cast<float>(low * pow(static_cast<double>(high) / low, t));
+		else
+			in[i] = static_cast<float>(low + (static_cast<double>(high) - low) * t);
+	}
+
+	fn(in.data(), AccuracySamples, out.data());
+
+	double maxAbs = 0.0, maxRel = 0.0, worstUlps = 0.0;
+
+	for (size_t i = 0; i < AccuracySamples; i++) {
+		double expected = reference(static_cast<double>(in[i]));
+		double error = fabs(static_cast<double>(out[i]) - expected);
+
+		maxAbs = fmax(maxAbs, error);
+		if (expected != 0.0)
+			maxRel = fmax(maxRel, error / fabs(expected));
+
+		if (maxUlps > 0.0 && expected != 0.0) {
+			// 1 ulp of the float nearest to expected.
+			double ulp = ldexp(1.0, ilogbf(static_cast<float>(expected)) - 23);
+			worstUlps = fmax(worstUlps, error / ulp);
+		}
+	}
+
+	harness.AddAccuracy(pName, pVariant, AccuracySamples, maxAbs, maxRel, tolerance);
+
+	if (!(worstUlps <= maxUlps))
+		harness.AddFailure(std::string(pName) + " " + pVariant, "off by " + std::to_string(worstUlps) + " ulps, allowed " + std::to_string(maxUlps));
+}
+
+static void CheckApproxAccuracy(Harness& harness, const char* pVariant) {
+	// The bounds documented in approxmath.h. 1 ulp is at most 2^-23 relative.
+	const Tolerance_t sinCosTolerance = AbsTolerance(1e-7);
+	const Tolerance_t oneUlpTolerance = RelTolerance(1.0 / 8388608.0);
+
+	auto sinOfSinCos = [](const float* pIn, size_t count, float* pOut) {
+		std::vector<float> cosines(count);
+		SinCosArray(pIn, count, pOut, cosines.data());
+	};
+	auto cosOfSinCos = [](const float* pIn, size_t count, float* pOut) {
+		std::vector<float> sines(count);
+		SinCosArray(pIn, count, sines.data(), pOut);
+	};
+
+	CheckApproxFunction(harness, "SinArray", pVariant, -8192.f, 8192.f, false, SinArray, [](double x) { return sin(x); }, sinCosTolerance);
+	CheckApproxFunction(harness, "CosArray", pVariant, -8192.f, 8192.f, false, CosArray, [](double x) { return cos(x); }, sinCosTolerance);
+	CheckApproxFunction(harness, "SinCosArray sin", pVariant, -8192.f, 8192.f, false, sinOfSinCos, [](double x) { return sin(x); }, sinCosTolerance);
+	CheckApproxFunction(harness, "SinCosArray cos", pVariant, -8192.f, 8192.f, false, cosOfSinCos, [](double x) { return cos(x); }, sinCosTolerance);
+	CheckApproxFunction(harness, "ExpArray", pVariant, -87.f, 88.f, false, ExpArray, [](double x) { return exp(x); }, oneUlpTolerance, 1.0);
+	CheckApproxFunction(harness, "LogArray", pVariant, 1e-37f, 1e37f, true, LogArray, [](double x) { return log(x); }, oneUlpTolerance, 1.0);
+	CheckApproxFunction(harness, "RsqrtArray", pVariant, 1e-37f, 1e37f, true, RsqrtArray, [](double x) { return 1.0 / sqrt(x); }, RelTolerance(2.5e-7));
+	CheckApproxFunction(harness, "RcpArray", pVariant, 1e-37f, 1e37f, true, RcpArray, [](double x) { return 1.0 / x; }, RelTolerance(2e-7));
+
+	// atan2 over a full circle of directions at varying lengths.
+	std::vector<float> ys(AccuracySamples), xs(AccuracySamples), out(AccuracySamples);
+
+	for (size_t i = 0; i < AccuracySamples; i++) {
+		float angle = static_cast<float>(i) * (2.f * Pi / static_cast<float>(AccuracySamples));
+		float length = 1e-3f + static_cast<float>(i % 1000);
+
+		ys[i] = sinf(angle) * length;
+		xs[i] = cosf(angle) * length;
+	}
+
+	Atan2Array(ys.data(), xs.data(), AccuracySamples, out.data());
+
+	double maxAbs = 0.0;
+
+	for (size_t i = 0; i < AccuracySamples; i++) {
+		maxAbs = fmax(maxAbs, fabs(static_cast<double>(out[i]) - atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]))));
+	}
+
+	harness.AddAccuracy("Atan2Array", pVariant, AccuracySamples, maxAbs, 0.0, AbsTolerance(3e-7));
+}
+
+// Round trips through the packed formats.
+static void CheckPackingAccuracy(Harness& harness) {
+	double halfError = 0.0, octahedralDegrees = 0.0, tangentError = 0.0;
+
+	for (size_t i = 0; i < AccuracySamples; i++) {
+		float f = RandomFloat(-65504.f, 65504.f);
+		halfError = fmax(halfError, fabs(static_cast<double>(HalfToFloat(FloatToHalf(f))) - f) / fabs(f));
+
+		Vector3 n = NormalizeVector(Random<Vector3>() + Vector3(1e-3f, 0.f, 0.f));
+		Vector4 tangent(NormalizeVector(CrossProduct(n, Vector3(0.3f, 0.5f, 0.7f))), 1.f);
+		Vector3 decodedNormal;
+		Vector4 decodedTangent;
+
+		UnpackTangentFrame(PackTangentFrame(n, tangent), decodedNormal, decodedTangent);
+
+		double cosine = fmin(1.0, static_cast<double>(DotProduct(n, decodedNormal)));
+		octahedralDegrees = fmax(octahedralDegrees, acos(cosine) * 180.0 / 3.14159265358979);
+		tangentError = fmax(tangentError, static_cast<double>(MaxAbsDifference(tangent, decodedTangent)));
+	}
+
+	// Half keeps 11 significant bits, so round to nearest is off by at most
+	//	2^-11 relative. The octahedral bound is the one packing.h documents.
+	harness.AddAccuracy("FloatToHalf round trip", "Scalar", AccuracySamples, 0.0, halfError, RelTolerance(1.0 / 2048.0));
+	harness.AddAccuracy("PackOctahedral16 round trip degrees", "Scalar", AccuracySamples, octahedralDegrees, 0.0, AbsTolerance(0.05));
+	harness.AddAccuracy("PackTangentFrame tangent round trip", "Scalar", AccuracySamples, tangentError, 0.0, AbsTolerance(2e-3));
+}
+
+// Noise2D and Noise3D against the batch functions, which have to give
+//	exactly the same values at every SIMD level.
+static void CheckNoiseConsistency(Harness& harness, const char* pVariant) {
+	constexpr size_t numSamples = 4096;
+	constexpr uint32_t gridSize = 16;
+	const char* pTypeNames[] = { "Value", "Perlin", "Simplex", "Cellular" };
+
+	std::vector<float> xs(numSamples), ys(numSamples), zs(numSamples), out(numSamples);
+	std::vector<float> grid(gridSize * gridSize * gridSize);
+
+	for (size_t i = 0; i < numSamples; i++) {
+		xs[i] = RandomFloat(-1000.f, 1000.f);
+		ys[i] = RandomFloat(-1000.f, 1000.f);
+		zs[i] = RandomFloat(-1000.f, 1000.f);
+	}
+
+	for (uint32_t type = NoiseType::Value; type <= NoiseType::Cellular; type++) {
+		for (uint32_t octaves : { 1u, 4u }) {
+			NoiseParams_t params;
+			params.type = static_cast<NoiseType::Enum>(type);
+			params.seed = 77;
+			params.frequency = 0.05f;
+			params.octaves = octaves;
+
+			std::string name = std::string("Noise/") + pTypeNames[type] + (octaves > 1 ? "FBm" : "");
+			float array2D = 0.f, array3D = 0.f, grid2D = 0.f, grid3D = 0.f;
+
+			NoiseArray2D(params, xs.data(), ys.data(), numSamples, out.data());
+			for (size_t i = 0; i < numSamples; i++)
+				array2D = fmaxf(array2D, fabsf(out[i] - Noise2D(params, xs[i], ys[i])));
+
+			NoiseArray3D(params, xs.data(), ys.data(), zs.data(), numSamples, out.data());
+			for (size_t i = 0; i < numSamples; i++)
+				array3D = fmaxf(array3D, fabsf(out[i] - Noise3D(params, xs[i], ys[i], zs[i])));
+
+			// All threads, so the split into rows is covered too.
+			FillNoiseGrid2D(params, -3.5f, 7.25f, 0.75f, gridSize, gridSize, grid.data(), 0);
+			for (uint32_t y = 0; y < gridSize; y++) {
+				for (uint32_t x = 0; x < gridSize; x++) {
+					float expected = Noise2D(params, -3.5f + static_cast<float>(x) * 0.75f, 7.25f + static_cast<float>(y) * 0.75f);
+					grid2D = fmaxf(grid2D, fabsf(grid[y * gridSize + x] - expected));
+				}
+			}
+
+			FillNoiseGrid3D(params, -3.5f, 7.25f, 1.5f, 0.75f, gridSize, gridSize, gridSize, grid.data(), 0);
+			for (uint32_t z = 0; z < gridSize; z++) {
+				for (uint32_t y = 0; y < gridSize; y++) {
+					for (uint32_t x = 0; x < gridSize; x++) {
+						float expected = Noise3D(params, -3.5f + static_cast<float>(x) * 0.75f, 7.25f + static_cast<float>(y) * 0.75f, 1.5f + static_cast<float>(z) * 0.75f);
+						grid3D = fmaxf(grid3D, fabsf(grid[(z * gridSize + y) * gridSize + x] - expected));
+					}
+				}
+			}
+
+			// Any difference at all fails, NaN included.
+			const Tolerance_t tolerance = AbsTolerance(0.0);
+
+			harness.AddAccuracy(name + " NoiseArray2D vs Noise2D", pVariant, numSamples, array2D, 0.0, tolerance);
+			harness.AddAccuracy(name + " NoiseArray3D vs Noise3D", pVariant, numSamples, array3D, 0.0, tolerance);
+			harness.AddAccuracy(name + " FillNoiseGrid2D vs Noise2D", pVariant, gridSize * gridSize, grid2D, 0.0, tolerance);
+			harness.AddAccuracy(name + " FillNoiseGrid3D vs Noise3D", pVariant, grid.size(), grid3D, 0.0, tolerance);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	Harness harness(argc, argv);
+
+#if defined(__clang__)
+	harness.AddInfo("compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+	harness.AddInfo("compiler", "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+	harness.AddInfo("compiler", "msvc " + std::to_string(_MSC_FULL_VER));
+#endif
+	harness.AddInfo("defaultSimdLevel", GetSimdLevelName(GetSimdLevel()));
+
+	BenchVectors(harness);
+	BenchMatrices(harness);
+	BenchQuaternions(harness);
+
+	CheckMatrixAccuracy(harness);
+	CheckInverseAccuracy(harness);
+	CheckPackingAccuracy(harness);
+
+	SimdLevel::Enum defaultLevel = GetSimdLevel();
+
+	BVH4 sphereMesh;
+	BuildSphereMesh(sphereMesh);
+
+	// libm baseline for the approximations.
+	SetSimdLevel(SimdLevel::Scalar);
+	SetApproxMathMode(ApproxMathMode::Precise);
+	BenchApproxMath(harness, "libm");
+	SetApproxMathMode(ApproxMathMode::Fast);
+
+	// There are no AVX512 kernels yet.
+	for (uint32_t level = SimdLevel::Scalar; level <= SimdLevel::AVX2; level++) {
+		if (!IsSimdLevelSupported(static_cast<SimdLevel::Enum>(level)))
+			continue;
+
+		SetSimdLevel(static_cast<SimdLevel::Enum>(level));
+
+		// FE_MATH_NO_SIMD builds stay on scalar.
+		if (GetSimdLevel() != level)
+			continue;
+
+		const char* pVariant = GetSimdLevelName(GetSimdLevel());
+
+		BenchBatchKernels(harness, pVariant);
+		BenchPacking(harness, pVariant);
+		BenchIntersect(harness, pVariant);
+		BenchBVH(harness, pVariant, sphereMesh);
+		BenchNoise(harness, pVariant);
+		CheckNoiseConsistency(harness, pVariant);
+
+		if (level != SimdLevel::Scalar) {
+			BenchApproxMath(harness, pVariant);
+			CheckApproxAccuracy(harness, pVariant);
+		}
+	}
+
+	SetSimdLevel(defaultLevel);
+
+	bool written = harness.WriteJson();
+
+	if (harness.HasFailures())
+		fprintf(stderr, "Accuracy checks failed\n");
+
+	return written && !harness.HasFailures() ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "cpuinfo.h"
+#include "gameconfig.h"
+
+#include <cstdio>
+
+#include <SDL3/SDL_cpuinfo.h>
+#include <SDL3/SDL_stdinc.h>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace fe {
+
+// SDL has no FMA or F16C query, those come straight from CPUID leaf 1.
+static void QueryX86Features(CPUInfo_t& info) {
+	info.hasFMA = false;
+	info.hasF16C = false;
+	info.hasOSYmmState = false;
+
+#if defined(_M_X64) || defined(__x86_64__)
+	uint32_t ecx;
+
+#if defined(_MSC_VER)
+	int registers[4];
+	__cpuid(registers, 1);
+	ecx = static_cast<uint32_t>(registers[2]);
+#else
+	uint32_t eax, ebx, edx;
+	__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+#endif
+
+	info.hasFMA = (ecx & (1u << 12)) != 0;
+	info.hasF16C = (ecx & (1u << 29)) != 0;
+
+	// XCR0 bits 1 and 2 are the XMM and YMM state.
+	bool hasOSXSAVE = (ecx & (1u << 27)) != 0;
+
+	if (hasOSXSAVE) {
+#if defined(_MSC_VER)
+		uint64_t xcr0 = _xgetbv(0);
+#else
+		uint32_t xcr0Low, xcr0High;
+		__asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+		uint64_t xcr0 = (static_cast<uint64_t>(xcr0High) << 32) | xcr0Low;
+#endif
+		info.hasOSYmmState = (xcr0 & 0x6) == 0x6;
+	}
+#endif
+}
+
+static CPUInfo_t QueryCPUInfo() {
+	CPUInfo_t info;
+
+	info.numLogicalCores = SDL_GetCPUCount();
+	info.cacheLineSize = SDL_GetCPUCacheLineSize();
+	info.hasSSE2 = SDL_HasSSE2();
+	info.hasSSE41 = SDL_HasSSE41();
+	info.hasAVX = SDL_HasAVX();
+	info.hasAVX2 = SDL_HasAVX2();
+	info.hasAVX512F = SDL_HasAVX512F();
+
+	QueryX86Features(info);
+
+	return info;
+}
+
+const CPUInfo_t& GetCPUInfo() {
+	static CPUInfo_t info = QueryCPUInfo();
+
+	return info;
+}
+
+math::SimdLevel::Enum GetBestSimdLevel(const CPUInfo_t& info) {
+	// FE_TARGET_AVX2 code uses FMA and F16C as well, so the AVX2 level
+	//	needs all three and the OS saving the YMM registers.
+	bool canUseAVX2 = info.hasAVX2 && info.hasFMA && info.hasF16C && info.hasOSYmmState;
+
+	if (info.hasAVX512F && canUseAVX2)
+		return math::SimdLevel::AVX512;
+
+	if (canUseAVX2)
+		return math::SimdLevel::AVX2;
+
+	if (info.hasSSE2)
+		return math::SimdLevel::SSE2;
+
+	return math::SimdLevel::Scalar;
+}
+
+void InitializeSimdDispatch() {
+	math::SimdLevel::Enum level = GetBestSimdLevel(GetCPUInfo());
+
+	if (GetGameConfig().maxSimdLevel < level) {
+		level = GetGameConfig().maxSimdLevel;
+	}
+
+	const char* pOverride = SDL_getenv("FE_SIMD_LEVEL");
+	if (pOverride) {
+		math::SimdLevel::Enum overrideLevel;
+
+		if (!math::ParseSimdLevel(pOverride, overrideLevel)) {
+			printf("Unknown FE_SIMD_LEVEL \"%s\", ignoring it.\n", pOverride);
+		}
+		else if (overrideLevel < level) {
+			level = overrideLevel;
+		}
+	}
+
+	math::SetSimdLevel(level);
+
+	printf("Math kernels use %s.\n", math::GetSimdLevelName(math::GetSimdLevel()));
+}
+
+}
\ No newline at end of file
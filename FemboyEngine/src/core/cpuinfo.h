@@ -0,0 +1,34 @@
+#pragma once
+
+#include "mathlib/dispatch.h"
+
+#include <cstdint>
+
+namespace fe {
+
+struct CPUInfo_t {
+	int32_t numLogicalCores;
+	int32_t cacheLineSize;
+	bool hasSSE2;
+	bool hasSSE41;
+	bool hasAVX;
+	bool hasAVX2;
+	bool hasFMA;
+	bool hasF16C;
+	// The OS saves the YMM registers on context switches (OSXSAVE and
+	//	XCR0), without it AVX instructions fault even when the CPU has them.
+	bool hasOSYmmState;
+	bool hasAVX512F;
+};
+
+// Queried once on first use.
+const CPUInfo_t& GetCPUInfo();
+
+math::SimdLevel::Enum GetBestSimdLevel(const CPUInfo_t& info);
+
+// Picks the math kernel level from the CPU, GameConfig_t::maxSimdLevel and the
+//	FE_SIMD_LEVEL environment variable (e.g. FE_SIMD_LEVEL=SSE2), the lowest wins.
+//	Call after the game config has been loaded.
+void InitializeSimdDispatch();
+
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "mathlib/dispatch.h"
+
 #include <cstdint>
 
 namespace fe {
@@ -9,6 +11,9 @@ struct GameConfig_t {
 	int32_t height;
 	bool isFullscreen;
 	bool isBorderless;
+
+	// Highest SIMD level the math kernels may use, the CPU can still lower it.
+	math::SimdLevel::Enum maxSimdLevel;
 };
 
 const GameConfig_t& GetGameConfig();
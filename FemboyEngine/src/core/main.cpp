@@ -7,10 +7,13 @@
 #include "mathlib/matrix.h"
 
 #include "gameconfig.h"
+#include "cpuinfo.h"
 
 #include "typeinfo/TypeInfo.h"
 
 #include "fstdlib/pointers.h"
+#include "fstdlib/arena.h"
+#include "fstdlib/memorytracking.h"
 
 #include <iostream>
 
@@ -78,10 +81,12 @@ static void LoadGameConfig() {
 	gameConfig.width = 800;
 	gameConfig.height = 600;
 
+	gameConfig.maxSimdLevel = math::SimdLevel::AVX512;
+
 	SetGameConfig(gameConfig);
 }
 
-static bool CompileShader(const std::string& shaderFile, render::VertexShader** ppVertexShader, render::PixelShader** ppPixelShader, render::InputLayout** ppInputLayout, const render::InputElement_t* const pInputElements, uint32_t numElements) {
+static bool CompileShader(const std::string& shaderFile, render::VertexShader** ppVertexShader, render::PixelShader** ppPixelShader, render::InputLayout** ppInputLayout, const render::InputElementList_t& inputElements) {
 	ScopedPtr<render::ShaderBytecode> pVSCode, pPSCode;
 
 	render::ShaderCompiler* pShaderCompiler = g_pDevice->GetShaderCompiler();
@@ -96,7 +101,7 @@ static bool CompileShader(const std::string& shaderFile, render::VertexShader**
 
 	*ppVertexShader = g_pDevice->CreateVertexShader(pVSCode->GetData(), pVSCode->GetSize());
 	*ppPixelShader = g_pDevice->CreatePixelShader(pPSCode->GetData(), pPSCode->GetSize());
-	*ppInputLayout = g_pDevice->CreateInputLayout(pInputElements, numElements, pVSCode->GetData(), pVSCode->GetSize());
+	*ppInputLayout = g_pDevice->CreateInputLayout(inputElements, pVSCode->GetData(), pVSCode->GetSize());
 
 	return true;
 }
@@ -112,6 +117,13 @@ int EntryPoint() {
 
 	LoadGameConfig();
 
+	InitializeSimdDispatch();
+
+	// CPU memory only, what the GPU driver allocates isn't counted.
+	SetMemoryBudget(MemoryTag::Render, 64 * 1024 * 1024);
+	SetMemoryBudget(MemoryTag::Scene, 64 * 1024 * 1024);
+	SetMemoryBudget(MemoryTag::TypeInfo, 4 * 1024 * 1024);
+
 	if (!CreateGameWindow()) {
 		printf("Creating game window failed.\n");
 		return -1;
@@ -161,16 +173,17 @@ int EntryPoint() {
 	render::PixelShader* pPS;
 	render::InputLayout* pInputLayout;
 
-	render::InputElement_t inputElems[] = {
+	render::InputElementList_t inputElems = {
 		render::InputElement_t("POSITION", 0, render::RenderFormat::R32G32B32_Float, 0)
 	};
 
-	if (!CompileShader("src/hlsl/lit.hlsl", &pVS, &pPS, &pInputLayout, inputElems, _countof(inputElems))) {
+	if (!CompileShader("src/hlsl/lit.hlsl", &pVS, &pPS, &pInputLayout, inputElems)) {
 		printf("Failed to compile shader\n");
 		return -1;
 	}
 
 	bool exitGame = false;
+	size_t maxScratchPeak = 0;
 
 	while (!exitGame) {
 		float time = static_cast<float>(static_cast<double>(SDL_GetTicks()) * 0.001);
@@ -184,6 +197,7 @@ int EntryPoint() {
 			if (ev.type == SDL_EVENT_KEY_DOWN) {
 				if (ev.key.keysym.scancode == SDL_SCANCODE_F8) {
 					g_pDevice->ReportLiveObjects();
+					DumpMemoryStats();
 				}
 			}
 
@@ -244,6 +258,18 @@ int EntryPoint() {
 		}
 
 		g_pSwapChain->Present();
+
+		// Nothing allocates from the frame arena yet, so only the scratch
+		//	peak is printed, whenever it grows, to size the arena.
+		GetFrameArena().EndFrame();
+
+		LinearArena& scratchArena = GetScratchArena();
+
+		if (scratchArena.GetPeak() > maxScratchPeak) {
+			maxScratchPeak = scratchArena.GetPeak();
+
+			printf("Scratch arena peak: %zu of %zu bytes\n", maxScratchPeak, scratchArena.GetCapacity());
+		}
 	}
 	
 	SceneSystem::DeleteInstance();
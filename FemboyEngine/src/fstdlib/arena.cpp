@@ -0,0 +1,111 @@
+#include "arena.h"
+#include "memorytracking.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace fe {
+
+constexpr size_t FrameArenaCapacity = 4 * 1024 * 1024;
+constexpr size_t ScratchArenaCapacity = 256 * 1024;
+
+static uintptr_t AlignUp(uintptr_t value, size_t alignment) {
+	return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+// ===============================================
+// LinearArena
+// ===============================================
+LinearArena::LinearArena(size_t capacity) {
+	m_pBase = static_cast<uint8_t*>(TaggedAllocate(MemoryTag::Arena, capacity));
+	m_Capacity = capacity;
+	m_Offset = 0;
+	m_Peak = 0;
+	m_OverflowBytes = 0;
+}
+
+LinearArena::~LinearArena() {
+	Reset();
+
+	TaggedFree(MemoryTag::Arena, m_pBase, m_Capacity);
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment) {
+	uintptr_t base = reinterpret_cast<uintptr_t>(m_pBase);
+	uintptr_t aligned = AlignUp(base + m_Offset, alignment);
+	size_t end = static_cast<size_t>(aligned - base) + size;
+
+	if (end <= m_Capacity) {
+		m_Offset = end;
+
+		if (GetUsed() > m_Peak)
+			m_Peak = GetUsed();
+
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	// Full, take a block of its own. operator new only guarantees the
+	//	default alignment, so over-allocate for larger ones.
+	size_t blockSize = size + (alignment > DefaultAlignment ? alignment : 0);
+	void* pBlock = TaggedAllocate(MemoryTag::Arena, blockSize);
+
+	m_OverflowBlocks.push_back({ pBlock, blockSize });
+	m_OverflowBytes += blockSize;
+
+	if (GetUsed() > m_Peak)
+		m_Peak = GetUsed();
+
+	return reinterpret_cast<void*>(AlignUp(reinterpret_cast<uintptr_t>(pBlock), alignment));
+}
+
+void LinearArena::Free(void* p, size_t size) {
+	uint8_t* pBytes = static_cast<uint8_t*>(p);
+
+	if (pBytes >= m_pBase && pBytes + size == m_pBase + m_Offset) {
+		m_Offset = static_cast<size_t>(pBytes - m_pBase);
+	}
+}
+
+LinearArena::Marker_t LinearArena::GetMarker() const {
+	return { m_Offset, m_OverflowBlocks.size(), m_OverflowBytes };
+}
+
+void LinearArena::Rewind(const Marker_t& marker) {
+	while (m_OverflowBlocks.size() > marker.numOverflowBlocks) {
+		TaggedFree(MemoryTag::Arena, m_OverflowBlocks.back().pMemory, m_OverflowBlocks.back().size);
+		m_OverflowBlocks.pop_back();
+	}
+
+	m_OverflowBytes = marker.overflowBytes;
+	m_Offset = marker.offset;
+}
+
+void LinearArena::Reset() {
+	Rewind({ 0, 0, 0 });
+}
+
+// ===============================================
+// FrameArena
+// ===============================================
+void FrameArena::EndFrame() {
+	m_LastFramePeak = GetPeak();
+	if (m_LastFramePeak > m_MaxFramePeak)
+		m_MaxFramePeak = m_LastFramePeak;
+
+	Reset();
+	ResetPeak();
+}
+
+FrameArena& GetFrameArena() {
+	static FrameArena frameArena(FrameArenaCapacity);
+
+	return frameArena;
+}
+
+LinearArena& GetScratchArena() {
+	thread_local LinearArena scratchArena(ScratchArenaCapacity);
+
+	return scratchArena;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "memorytracking.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fe {
+
+// Bump pointer allocator over one fixed block. Freeing is done all at once
+//	with Reset, or back to a marker with Rewind. When the block is full it
+//	falls back to separate heap blocks, which are freed the same way, so a
+//	too small arena is slower but still correct. The peak usage, overflow
+//	included, tells how large the block should be. All of it counts against
+//	MemoryTag::Arena.
+class LinearArena {
+public:
+	struct Marker_t {
+		size_t offset;
+		size_t numOverflowBlocks;
+		size_t overflowBytes;
+	};
+
+	static constexpr size_t DefaultAlignment = alignof(std::max_align_t);
+
+	explicit LinearArena(size_t capacity);
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	// alignment must be a power of two. Never returns nullptr.
+	void* Allocate(size_t size, size_t alignment = DefaultAlignment);
+
+	template<typename T>
+	T* AllocateArray(size_t count) {
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	// Gives back the most recent allocation if it is p, so containers growing
+	//	at the top of the arena reuse their old space. Does nothing otherwise.
+	void Free(void* p, size_t size);
+
+	Marker_t GetMarker() const;
+	// Frees everything allocated after the marker was taken.
+	void Rewind(const Marker_t& marker);
+	void Reset();
+
+	size_t GetCapacity() const { return m_Capacity; }
+	// Bytes in use, overflow blocks included.
+	size_t GetUsed() const { return m_Offset + m_OverflowBytes; }
+	size_t GetPeak() const { return m_Peak; }
+	void ResetPeak() { m_Peak = GetUsed(); }
+
+private:
+	uint8_t* m_pBase;
+	size_t m_Capacity;
+	size_t m_Offset;
+	size_t m_Peak;
+
+	struct OverflowBlock_t {
+		void* pMemory;
+		size_t size;
+	};
+
+	std::vector<OverflowBlock_t, TaggedAllocator<OverflowBlock_t, MemoryTag::Arena>> m_OverflowBlocks;
+	size_t m_OverflowBytes;
+};
+
+// Transient memory for one frame, everything is freed by EndFrame.
+class FrameArena : public LinearArena {
+public:
+	explicit FrameArena(size_t capacity)
+		: LinearArena(capacity) {}
+
+	// Frees the frame's allocations and records its peak.
+	void EndFrame();
+
+	size_t GetLastFramePeak() const { return m_LastFramePeak; }
+	// Highest peak of any frame so far.
+	size_t GetMaxFramePeak() const { return m_MaxFramePeak; }
+
+private:
+	size_t m_LastFramePeak = 0;
+	size_t m_MaxFramePeak = 0;
+};
+
+// The frame arena of the main thread.
+FrameArena& GetFrameArena();
+
+// Per thread arena for temporaries inside a function, always used through
+//	ScratchScope so the memory is given back when the scope ends.
+LinearArena& GetScratchArena();
+
+// STL allocator over a LinearArena. Deallocation only reclaims memory at the
+//	top of the arena, the rest waits for the arena to be rewound or reset.
+template<typename T>
+class ArenaAllocator {
+public:
+	using value_type = T;
+
+	ArenaAllocator(LinearArena& arena)
+		: m_pArena(&arena) {}
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other)
+		: m_pArena(other.GetArena()) {}
+
+	T* allocate(size_t count) {
+		return m_pArena->AllocateArray<T>(count);
+	}
+
+	void deallocate(T* p, size_t count) {
+		m_pArena->Free(p, sizeof(T) * count);
+	}
+
+	LinearArena* GetArena() const { return m_pArena; }
+
+	template<typename U>
+	bool operator==(const ArenaAllocator<U>& other) const { return m_pArena == other.GetArena(); }
+
+private:
+	LinearArena* m_pArena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+using ArenaWString = std::basic_string<wchar_t, std::char_traits<wchar_t>, ArenaAllocator<wchar_t>>;
+
+// Rewinds the thread's scratch arena to where it was when the scope began.
+//	Scopes nest, anything allocated from the scratch arena must not outlive
+//	the innermost scope it was made in.
+class ScratchScope {
+public:
+	ScratchScope()
+		: m_Arena(GetScratchArena()), m_Marker(m_Arena.GetMarker()) {}
+
+	~ScratchScope() {
+		m_Arena.Rewind(m_Marker);
+	}
+
+	ScratchScope(const ScratchScope&) = delete;
+	ScratchScope& operator=(const ScratchScope&) = delete;
+
+	LinearArena& GetArena() const { return m_Arena; }
+
+	template<typename T = char>
+	ArenaAllocator<T> GetAllocator() const { return ArenaAllocator<T>(m_Arena); }
+
+private:
+	LinearArena& m_Arena;
+	LinearArena::Marker_t m_Marker;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,424 @@
+#pragma once
+
+#include "mathlib/simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fe {
+
+namespace detail {
+
+struct BitOp {
+	enum Enum : uint32_t {
+		And,
+		Or,
+		Xor,
+		AndNot
+	};
+};
+
+template<BitOp::Enum Op>
+FE_FORCEINLINE uint64_t ApplyBitOp(uint64_t a, uint64_t b) {
+	if constexpr (Op == BitOp::And)
+		return a & b;
+	else if constexpr (Op == BitOp::Or)
+		return a | b;
+	else if constexpr (Op == BitOp::Xor)
+		return a ^ b;
+	else
+		return a & ~b;
+}
+
+#if FE_SIMD_SSE
+template<BitOp::Enum Op>
+FE_FORCEINLINE __m128i ApplyBitOp(__m128i a, __m128i b) {
+	if constexpr (Op == BitOp::And)
+		return _mm_and_si128(a, b);
+	else if constexpr (Op == BitOp::Or)
+		return _mm_or_si128(a, b);
+	else if constexpr (Op == BitOp::Xor)
+		return _mm_xor_si128(a, b);
+	else
+		return _mm_andnot_si128(b, a);
+}
+#endif
+
+#if FE_SIMD_AVX2
+template<BitOp::Enum Op>
+FE_FORCEINLINE __m256i ApplyBitOp(__m256i a, __m256i b) {
+	if constexpr (Op == BitOp::And)
+		return _mm256_and_si256(a, b);
+	else if constexpr (Op == BitOp::Or)
+		return _mm256_or_si256(a, b);
+	else if constexpr (Op == BitOp::Xor)
+		return _mm256_xor_si256(a, b);
+	else
+		return _mm256_andnot_si256(b, a);
+}
+#endif
+
+// pDst[i] = pDst[i] Op pSrc[i], 4 words at a time with AVX2 and 2 with SSE2.
+template<BitOp::Enum Op>
+inline void ApplyBitOp(uint64_t* pDst, const uint64_t* pSrc, size_t count) {
+	size_t i = 0;
+
+#if FE_SIMD_AVX2
+	for (; i + 4 <= count; i += 4) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDst + i));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), ApplyBitOp<Op>(a, b));
+	}
+#endif
+
+#if FE_SIMD_SSE
+	for (; i + 2 <= count; i += 2) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), ApplyBitOp<Op>(a, b));
+	}
+#endif
+
+	for (; i < count; i++) {
+		pDst[i] = ApplyBitOp<Op>(pDst[i], pSrc[i]);
+	}
+}
+
+// Bits set in pWords. The AVX2 path counts nibbles with a shuffle table
+//	and sums the bytes with sad, which beats popcnt once there are a few
+//	hundred words. Without it std::popcount is popcnt when the CPU has it.
+inline size_t CountBits(const uint64_t* pWords, size_t count) {
+	size_t i = 0;
+	size_t result = 0;
+
+#if FE_SIMD_AVX2
+	if (count >= 16) {
+		const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i lowMask = _mm256_set1_epi8(0x0F);
+		__m256i sums = _mm256_setzero_si256();
+
+		for (; i + 4 <= count; i += 4) {
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + i));
+			__m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, lowMask));
+			__m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask));
+
+			sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+		}
+
+		alignas(32) uint64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+		result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+#endif
+
+	for (; i < count; i++) {
+		result += std::popcount(pWords[i]);
+	}
+
+	return result;
+}
+
+// Shared by BitSet and DynamicBitSet. Bits past Size() in the last word are
+//	always 0, so counting and searching never need to mask them out.
+template<typename Derived>
+class BitSetBase {
+public:
+	static constexpr size_t WordBits = 64;
+
+	// Returned by the Find functions when there is no set bit.
+	static constexpr size_t NotFound = ~size_t(0);
+
+	// ===============================================
+	// Single bits
+	// ===============================================
+	bool Test(size_t index) const {
+		assert(index < GetDerived().Size());
+		return (GetWords()[index / WordBits] >> (index % WordBits)) & 1;
+	}
+
+	void Set(size_t index) {
+		assert(index < GetDerived().Size());
+		GetWords()[index / WordBits] |= GetBit(index);
+	}
+
+	void Set(size_t index, bool value) {
+		if (value)
+			Set(index);
+		else
+			Reset(index);
+	}
+
+	void Reset(size_t index) {
+		assert(index < GetDerived().Size());
+		GetWords()[index / WordBits] &= ~GetBit(index);
+	}
+
+	void Flip(size_t index) {
+		assert(index < GetDerived().Size());
+		GetWords()[index / WordBits] ^= GetBit(index);
+	}
+
+	// Sets the bit with an atomic or, so several threads can set bits in the
+	//	same set at once. Returns true for the thread that changed it. Plain
+	//	reads and writes must not run at the same time, the producers have to
+	//	be joined before the set is read.
+	bool AtomicSet(size_t index) {
+		assert(index < GetDerived().Size());
+
+		uint64_t bit = GetBit(index);
+		std::atomic_ref<uint64_t> word(GetWords()[index / WordBits]);
+
+		return !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+	}
+
+	bool AtomicReset(size_t index) {
+		assert(index < GetDerived().Size());
+
+		uint64_t bit = GetBit(index);
+		std::atomic_ref<uint64_t> word(GetWords()[index / WordBits]);
+
+		return word.fetch_and(~bit, std::memory_order_relaxed) & bit;
+	}
+
+	// ===============================================
+	// Whole set
+	// ===============================================
+	void SetAll() {
+		std::fill_n(GetWords(), GetWordCount(), ~uint64_t(0));
+		ClearTail();
+	}
+
+	void ResetAll() {
+		std::fill_n(GetWords(), GetWordCount(), uint64_t(0));
+	}
+
+	void FlipAll() {
+		uint64_t* pWords = GetWords();
+
+		for (size_t i = 0; i < GetWordCount(); i++) {
+			pWords[i] = ~pWords[i];
+		}
+
+		ClearTail();
+	}
+
+	size_t Count() const {
+		return CountBits(GetWords(), GetWordCount());
+	}
+
+	bool Any() const {
+		const uint64_t* pWords = GetWords();
+
+		for (size_t i = 0; i < GetWordCount(); i++) {
+			if (pWords[i])
+				return true;
+		}
+
+		return false;
+	}
+
+	bool None() const {
+		return !Any();
+	}
+
+	bool All() const {
+		return Count() == GetDerived().Size();
+	}
+
+	// The operands must have the same size.
+	Derived& operator&=(const Derived& other) { return Apply<BitOp::And>(other); }
+	Derived& operator|=(const Derived& other) { return Apply<BitOp::Or>(other); }
+	Derived& operator^=(const Derived& other) { return Apply<BitOp::Xor>(other); }
+
+	// Clears the bits that are set in other, this &= ~other.
+	Derived& AndNot(const Derived& other) { return Apply<BitOp::AndNot>(other); }
+
+	bool operator==(const Derived& other) const {
+		return GetDerived().Size() == other.Size() && std::equal(GetWords(), GetWords() + GetWordCount(), other.GetWords());
+	}
+
+	// ===============================================
+	// Searching
+	// ===============================================
+	size_t FindFirst() const {
+		return FindFrom(0);
+	}
+
+	// The first set bit after index.
+	size_t FindNext(size_t index) const {
+		return FindFrom(index + 1);
+	}
+
+	// Calls fn(index) for every set bit in increasing order. Skips whole
+	//	zero words and finds the bits within a word with tzcnt, so sparse
+	//	sets cost little more than reading them. fn may change the bit it
+	//	was called for, other bits of the same word are already read.
+	template<typename Fn>
+	void ForEachSetBit(Fn&& fn) const {
+		const uint64_t* pWords = GetWords();
+
+		for (size_t i = 0; i < GetWordCount(); i++) {
+			uint64_t word = pWords[i];
+
+			while (word) {
+				fn(i * WordBits + std::countr_zero(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+	// ===============================================
+	// Words
+	// ===============================================
+	uint64_t* GetWords() { return GetDerived().GetWordData(); }
+	const uint64_t* GetWords() const { return GetDerived().GetWordData(); }
+	size_t GetWordCount() const { return (GetDerived().Size() + WordBits - 1) / WordBits; }
+
+protected:
+	static uint64_t GetBit(size_t index) {
+		return uint64_t(1) << (index % WordBits);
+	}
+
+	// Restores the invariant after writing whole words.
+	void ClearTail() {
+		size_t usedBits = GetDerived().Size() % WordBits;
+
+		if (usedBits)
+			GetWords()[GetWordCount() - 1] &= (uint64_t(1) << usedBits) - 1;
+	}
+
+private:
+	Derived& GetDerived() { return static_cast<Derived&>(*this); }
+	const Derived& GetDerived() const { return static_cast<const Derived&>(*this); }
+
+	template<BitOp::Enum Op>
+	Derived& Apply(const Derived& other) {
+		assert(GetDerived().Size() == other.Size());
+
+		ApplyBitOp<Op>(GetWords(), other.GetWords(), GetWordCount());
+		return GetDerived();
+	}
+
+	size_t FindFrom(size_t index) const {
+		size_t size = GetDerived().Size();
+		if (index >= size)
+			return NotFound;
+
+		const uint64_t* pWords = GetWords();
+		size_t wordIndex = index / WordBits;
+		uint64_t word = pWords[wordIndex] & (~uint64_t(0) << (index % WordBits));
+
+		while (!word) {
+			if (++wordIndex == GetWordCount())
+				return NotFound;
+
+			word = pWords[wordIndex];
+		}
+
+		return wordIndex * WordBits + std::countr_zero(word);
+	}
+};
+
+}
+
+// ===============================================
+// BitSet
+// ===============================================
+// Fixed size bit array stored inside the object, for masks whose size is
+//	known up front, like component presence per type.
+template<size_t Bits>
+class BitSet : public detail::BitSetBase<BitSet<Bits>> {
+	static_assert(Bits > 0, "BitSet needs at least one bit.");
+
+	friend class detail::BitSetBase<BitSet<Bits>>;
+
+public:
+	static constexpr size_t WordCount = (Bits + 63) / 64;
+
+	constexpr size_t Size() const { return Bits; }
+
+private:
+	uint64_t* GetWordData() { return m_Words; }
+	const uint64_t* GetWordData() const { return m_Words; }
+
+	uint64_t m_Words[WordCount] = {};
+};
+
+template<size_t Bits>
+BitSet<Bits> operator&(BitSet<Bits> a, const BitSet<Bits>& b) { return a &= b; }
+
+template<size_t Bits>
+BitSet<Bits> operator|(BitSet<Bits> a, const BitSet<Bits>& b) { return a |= b; }
+
+template<size_t Bits>
+BitSet<Bits> operator^(BitSet<Bits> a, const BitSet<Bits>& b) { return a ^= b; }
+
+// ===============================================
+// DynamicBitSet
+// ===============================================
+// Bit array sized at runtime, for per object flags like culling results
+//	or dirty bits. A replacement for std::vector<bool> whose bulk operations
+//	work on whole words instead of single bits.
+template<typename Allocator = std::allocator<uint64_t>>
+class DynamicBitSet : public detail::BitSetBase<DynamicBitSet<Allocator>> {
+	friend class detail::BitSetBase<DynamicBitSet<Allocator>>;
+
+	using Base = detail::BitSetBase<DynamicBitSet<Allocator>>;
+
+public:
+	DynamicBitSet() = default;
+
+	explicit DynamicBitSet(size_t size, bool value = false) {
+		Resize(size, value);
+	}
+
+	size_t Size() const { return m_Size; }
+	bool IsEmpty() const { return m_Size == 0; }
+
+	// New bits get value. Shrinking keeps the capacity, like std::vector.
+	void Resize(size_t size, bool value = false) {
+		size_t oldSize = m_Size;
+
+		m_Words.resize((size + Base::WordBits - 1) / Base::WordBits, value ? ~uint64_t(0) : 0);
+		m_Size = size;
+
+		// The new bits in the old last word are 0 because of the invariant.
+		if (value && oldSize < size && oldSize % Base::WordBits)
+			m_Words[oldSize / Base::WordBits] |= ~uint64_t(0) << (oldSize % Base::WordBits);
+
+		this->ClearTail();
+	}
+
+	void Reserve(size_t size) {
+		m_Words.reserve((size + Base::WordBits - 1) / Base::WordBits);
+	}
+
+	void Clear() {
+		m_Words.clear();
+		m_Size = 0;
+	}
+
+private:
+	uint64_t* GetWordData() { return m_Words.data(); }
+	const uint64_t* GetWordData() const { return m_Words.data(); }
+
+	std::vector<uint64_t, Allocator> m_Words;
+	size_t m_Size = 0;
+};
+
+template<typename Allocator>
+DynamicBitSet<Allocator> operator&(DynamicBitSet<Allocator> a, const DynamicBitSet<Allocator>& b) { return a &= b; }
+
+template<typename Allocator>
+DynamicBitSet<Allocator> operator|(DynamicBitSet<Allocator> a, const DynamicBitSet<Allocator>& b) { return a |= b; }
+
+template<typename Allocator>
+DynamicBitSet<Allocator> operator^(DynamicBitSet<Allocator> a, const DynamicBitSet<Allocator>& b) { return a ^= b; }
+
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "threading.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace fe {
+
+// Adds waiting Push and Pop to SpscQueue or MpmcQueue. A thread that finds
+//	the queue full or empty spins and yields for a while, then sleeps in
+//	std::atomic::wait, which is a futex on Linux and WaitOnAddress on
+//	Windows, until the other side makes progress. Each successful push or
+//	pop bumps an epoch counter. The other side only pays for the wake up
+//	call while somebody is actually asleep.
+template<typename Queue>
+class BlockingQueue {
+public:
+	using value_type = typename Queue::value_type;
+
+	// Failed attempts spent spinning, then yielding to other threads, before
+	//	a thread goes to sleep. Yielding lets the other side run when both
+	//	share a core.
+	static constexpr int SpinCount = 64;
+	static constexpr int YieldCount = 16;
+
+	explicit BlockingQueue(size_t capacity)
+		: m_Queue(capacity) {}
+
+	BlockingQueue(const BlockingQueue&) = delete;
+	BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+	// ===============================================
+	// Waiting
+	// ===============================================
+	void Push(value_type value) {
+		Wait(m_PopEpoch, m_NumWaitingProducers, [&]() { return m_Queue.TryPush(std::move(value)); });
+		Signal(m_PushEpoch, m_NumWaitingConsumers);
+	}
+
+	value_type Pop() {
+		value_type value;
+
+		Wait(m_PushEpoch, m_NumWaitingConsumers, [&]() { return m_Queue.TryPop(value); });
+		Signal(m_PopEpoch, m_NumWaitingProducers);
+
+		return value;
+	}
+
+	// Waits for the first value only, then takes whatever else is there up
+	//	to maxCount. Returns how many were popped, at least one.
+	size_t PopBatch(value_type* pValues, size_t maxCount) {
+		size_t count = 0;
+
+		Wait(m_PushEpoch, m_NumWaitingConsumers, [&]() { return (count = m_Queue.TryPopBatch(pValues, maxCount)) != 0; });
+		Signal(m_PopEpoch, m_NumWaitingProducers);
+
+		return count;
+	}
+
+	// ===============================================
+	// Non-waiting
+	// ===============================================
+	bool TryPush(value_type&& value) {
+		if (!m_Queue.TryPush(std::move(value)))
+			return false;
+
+		Signal(m_PushEpoch, m_NumWaitingConsumers);
+		return true;
+	}
+
+	bool TryPop(value_type& value) {
+		if (!m_Queue.TryPop(value))
+			return false;
+
+		Signal(m_PopEpoch, m_NumWaitingProducers);
+		return true;
+	}
+
+	size_t TryPushBatch(value_type* pValues, size_t count) {
+		count = m_Queue.TryPushBatch(pValues, count);
+
+		if (count)
+			Signal(m_PushEpoch, m_NumWaitingConsumers);
+
+		return count;
+	}
+
+	size_t TryPopBatch(value_type* pValues, size_t maxCount) {
+		size_t count = m_Queue.TryPopBatch(pValues, maxCount);
+
+		if (count)
+			Signal(m_PopEpoch, m_NumWaitingProducers);
+
+		return count;
+	}
+
+	size_t GetSizeApprox() const { return m_Queue.GetSizeApprox(); }
+	size_t GetCapacity() const { return m_Queue.GetCapacity(); }
+
+private:
+	// Calls attempt until it succeeds. The waiter registers itself before
+	//	reading the epoch and tries once more before sleeping, so a signal
+	//	either happens before that last attempt or sees the waiter and
+	//	changes the epoch it sleeps on.
+	template<typename Attempt>
+	static void Wait(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& numWaiting, Attempt&& attempt) {
+		for (int i = 0; i < SpinCount + YieldCount; i++) {
+			if (attempt())
+				return;
+
+			if (i < SpinCount)
+				CpuRelax();
+			else
+				std::this_thread::yield();
+		}
+
+		for (;;) {
+			numWaiting.fetch_add(1);
+			uint32_t observed = epoch.load();
+
+			if (attempt()) {
+				numWaiting.fetch_sub(1, std::memory_order_relaxed);
+				return;
+			}
+
+			epoch.wait(observed);
+			numWaiting.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	static void Signal(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& numWaiting) {
+		epoch.fetch_add(1);
+
+		if (numWaiting.load() != 0)
+			epoch.notify_all();
+	}
+
+	Queue m_Queue;
+
+	// Bumped after every push, consumers sleep on it.
+	alignas(CacheLineSize) std::atomic<uint32_t> m_PushEpoch = 0;
+	std::atomic<uint32_t> m_NumWaitingConsumers = 0;
+
+	// Bumped after every pop, producers sleep on it.
+	alignas(CacheLineSize) std::atomic<uint32_t> m_PopEpoch = 0;
+	std::atomic<uint32_t> m_NumWaitingProducers = 0;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include "blockpool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+
+namespace fe {
+
+constexpr size_t NumSizeClasses = 16;
+
+static constexpr uint32_t sizeClassBlockSizes[NumSizeClasses] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+};
+
+// Size class of every size rounded up to 16 bytes, indexed by size / 16.
+static constexpr auto sizeClassLookup = []() {
+	std::array<uint8_t, PoolMaxBlockSize / 16 + 1> lookup = {};
+	uint8_t sizeClass = 0;
+
+	for (size_t i = 0; i < lookup.size(); i++) {
+		while (sizeClassBlockSizes[sizeClass] < i * 16) {
+			sizeClass++;
+		}
+
+		lookup[i] = sizeClass;
+	}
+
+	return lookup;
+}();
+
+static uint32_t GetSizeClass(size_t size) {
+	assert(size <= PoolMaxBlockSize);
+	return sizeClassLookup[(size + 15) / 16];
+}
+
+// Blocks moved between a thread list and the central list at once, about
+//	8KB worth.
+static uint32_t GetBatchCount(uint32_t sizeClass) {
+	return std::clamp<uint32_t>(8192 / sizeClassBlockSizes[sizeClass], 8, 64);
+}
+
+// Free blocks store the next free block in their first bytes.
+struct FreeBlock_t {
+	FreeBlock_t* pNext;
+};
+
+// ===============================================
+// Pages
+// ===============================================
+// Lives at the start of every page. Only touched under the central list's
+//	lock.
+struct alignas(PoolBlockAlignment) PoolPage_t {
+	// Links in the central list of pages with free blocks.
+	PoolPage_t* pPrevious;
+	PoolPage_t* pNext;
+	bool isLinked;
+
+	FreeBlock_t* pFreeBlocks;
+	// Blocks not given out, in pFreeBlocks or never carved.
+	uint32_t numAvailable;
+	uint32_t numCarved;
+	uint32_t numBlocks;
+	uint32_t blockSize;
+
+	MemoryTag::Enum tag;
+	uint32_t sizeClass;
+};
+
+// Pages come straight from operator new, the tags are only charged for the
+//	blocks in use. These are for GetPoolStats. threadBlockBytes counts the
+//	blocks taken out of the central lists and is updated once per batch.
+static std::atomic<size_t> numPages;
+static std::atomic<size_t> threadBlockBytes;
+
+constexpr size_t PageHeaderSize = (sizeof(PoolPage_t) + PoolBlockAlignment - 1) & ~(PoolBlockAlignment - 1);
+
+static PoolPage_t* GetPage(void* p) {
+	return reinterpret_cast<PoolPage_t*>(reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(PoolPageSize - 1));
+}
+
+static uint8_t* GetFirstBlock(PoolPage_t* pPage) {
+	return reinterpret_cast<uint8_t*>(pPage) + PageHeaderSize;
+}
+
+// ===============================================
+// Central lists
+// ===============================================
+struct CentralList_t {
+	std::mutex mutex;
+	PoolPage_t* pPages = nullptr;
+};
+
+// Allocated once and never destroyed, objects can still be freed during
+//	static destruction.
+static CentralList_t& GetCentralList(MemoryTag::Enum tag, uint32_t sizeClass) {
+	static CentralList_t* pCentralLists = new CentralList_t[MemoryTag::Count * NumSizeClasses];
+
+	return pCentralLists[tag * NumSizeClasses + sizeClass];
+}
+
+static void LinkPage(CentralList_t& list, PoolPage_t* pPage) {
+	pPage->pPrevious = nullptr;
+	pPage->pNext = list.pPages;
+	pPage->isLinked = true;
+
+	if (list.pPages)
+		list.pPages->pPrevious = pPage;
+
+	list.pPages = pPage;
+}
+
+static void UnlinkPage(CentralList_t& list, PoolPage_t* pPage) {
+	if (pPage->pPrevious)
+		pPage->pPrevious->pNext = pPage->pNext;
+	else
+		list.pPages = pPage->pNext;
+
+	if (pPage->pNext)
+		pPage->pNext->pPrevious = pPage->pPrevious;
+
+	pPage->pPrevious = nullptr;
+	pPage->pNext = nullptr;
+	pPage->isLinked = false;
+}
+
+static PoolPage_t* CreatePage(MemoryTag::Enum tag, uint32_t sizeClass) {
+	PoolPage_t* pPage = static_cast<PoolPage_t*>(::operator new(PoolPageSize, std::align_val_t(PoolPageSize)));
+	numPages.fetch_add(1, std::memory_order_relaxed);
+
+	pPage->pPrevious = nullptr;
+	pPage->pNext = nullptr;
+	pPage->isLinked = false;
+	pPage->pFreeBlocks = nullptr;
+	pPage->blockSize = sizeClassBlockSizes[sizeClass];
+	pPage->numBlocks = static_cast<uint32_t>((PoolPageSize - PageHeaderSize) / pPage->blockSize);
+	pPage->numAvailable = pPage->numBlocks;
+	pPage->numCarved = 0;
+	pPage->tag = tag;
+	pPage->sizeClass = sizeClass;
+
+	return pPage;
+}
+
+static void DestroyPage(PoolPage_t* pPage) {
+	numPages.fetch_sub(1, std::memory_order_relaxed);
+	::operator delete(pPage, std::align_val_t(PoolPageSize));
+}
+
+// Takes up to maxCount blocks, chained through FreeBlock_t. Fresh pages
+//	are carved lazily, so their memory is only touched when used.
+static FreeBlock_t* TakeBlocks(MemoryTag::Enum tag, uint32_t sizeClass, uint32_t maxCount, uint32_t& count) {
+	CentralList_t& list = GetCentralList(tag, sizeClass);
+	std::lock_guard lock(list.mutex);
+
+	FreeBlock_t* pHead = nullptr;
+	count = 0;
+
+	while (count < maxCount) {
+		PoolPage_t* pPage = list.pPages;
+
+		if (!pPage) {
+			pPage = CreatePage(tag, sizeClass);
+			LinkPage(list, pPage);
+		}
+
+		while (count < maxCount && pPage->numAvailable) {
+			FreeBlock_t* pBlock = pPage->pFreeBlocks;
+
+			if (pBlock)
+				pPage->pFreeBlocks = pBlock->pNext;
+			else
+				pBlock = reinterpret_cast<FreeBlock_t*>(GetFirstBlock(pPage) + pPage->numCarved++ * pPage->blockSize);
+
+			pBlock->pNext = pHead;
+			pHead = pBlock;
+
+			pPage->numAvailable--;
+			count++;
+		}
+
+		if (!pPage->numAvailable)
+			UnlinkPage(list, pPage);
+	}
+
+	threadBlockBytes.fetch_add(size_t(count) * sizeClassBlockSizes[sizeClass], std::memory_order_relaxed);
+
+	return pHead;
+}
+
+// Gives back a chain of blocks of one tag and size class, which may belong
+//	to different pages.
+static void ReturnBlocks(MemoryTag::Enum tag, uint32_t sizeClass, FreeBlock_t* pBlocks) {
+	CentralList_t& list = GetCentralList(tag, sizeClass);
+	std::lock_guard lock(list.mutex);
+
+	size_t count = 0;
+
+	while (pBlocks) {
+		FreeBlock_t* pBlock = pBlocks;
+		pBlocks = pBlock->pNext;
+		count++;
+
+		PoolPage_t* pPage = GetPage(pBlock);
+		pBlock->pNext = pPage->pFreeBlocks;
+		pPage->pFreeBlocks = pBlock;
+		pPage->numAvailable++;
+
+		if (!pPage->isLinked)
+			LinkPage(list, pPage);
+
+		// Keep one page around so a single object coming and going doesn't
+		//	allocate a page every time.
+		if (pPage->numAvailable == pPage->numBlocks && (pPage->pPrevious || pPage->pNext)) {
+			UnlinkPage(list, pPage);
+			DestroyPage(pPage);
+		}
+	}
+
+	threadBlockBytes.fetch_sub(count * sizeClassBlockSizes[sizeClass], std::memory_order_relaxed);
+}
+
+// ===============================================
+// Thread lists
+// ===============================================
+struct ThreadList_t {
+	FreeBlock_t* pHead = nullptr;
+	uint32_t count = 0;
+};
+
+struct ThreadCache_t {
+	ThreadList_t lists[MemoryTag::Count][NumSizeClasses];
+
+	~ThreadCache_t();
+};
+
+static thread_local ThreadCache_t threadCache;
+
+// Set once the thread's cache is destroyed. Frees after that, from
+//	thread_local destructors that run later, go to the central lists.
+static thread_local bool isThreadCacheDestroyed = false;
+
+ThreadCache_t::~ThreadCache_t() {
+	for (uint32_t tag = 0; tag < MemoryTag::Count; tag++) {
+		for (uint32_t sizeClass = 0; sizeClass < NumSizeClasses; sizeClass++) {
+			ThreadList_t& list = lists[tag][sizeClass];
+
+			if (list.pHead)
+				ReturnBlocks(static_cast<MemoryTag::Enum>(tag), sizeClass, list.pHead);
+
+			list.pHead = nullptr;
+			list.count = 0;
+		}
+	}
+
+	isThreadCacheDestroyed = true;
+}
+
+// ===============================================
+// Allocation
+// ===============================================
+void* PoolAllocate(MemoryTag::Enum tag, size_t size) {
+	assert(tag < MemoryTag::Count);
+	assert(size <= PoolMaxBlockSize);
+
+	uint32_t sizeClass = GetSizeClass(size);
+
+	TrackAllocation(tag, sizeClassBlockSizes[sizeClass]);
+
+	if (isThreadCacheDestroyed) {
+		uint32_t count;
+		return TakeBlocks(tag, sizeClass, 1, count);
+	}
+
+	ThreadList_t& list = threadCache.lists[tag][sizeClass];
+
+	if (!list.pHead)
+		list.pHead = TakeBlocks(tag, sizeClass, GetBatchCount(sizeClass), list.count);
+
+	FreeBlock_t* pBlock = list.pHead;
+	list.pHead = pBlock->pNext;
+	list.count--;
+
+	return pBlock;
+}
+
+void PoolFree(void* p) {
+	if (!p)
+		return;
+
+	PoolPage_t* pPage = GetPage(p);
+	assert((reinterpret_cast<uint8_t*>(p) - GetFirstBlock(pPage)) % pPage->blockSize == 0 && "Not a block from PoolAllocate");
+
+	TrackFree(pPage->tag, pPage->blockSize);
+
+	FreeBlock_t* pBlock = static_cast<FreeBlock_t*>(p);
+
+	if (isThreadCacheDestroyed) {
+		pBlock->pNext = nullptr;
+		ReturnBlocks(pPage->tag, pPage->sizeClass, pBlock);
+		return;
+	}
+
+	ThreadList_t& list = threadCache.lists[pPage->tag][pPage->sizeClass];
+
+	pBlock->pNext = list.pHead;
+	list.pHead = pBlock;
+	list.count++;
+
+	// Hand a batch back once the list holds two. The most recently freed
+	//	blocks are still in the cache, so those are kept.
+	uint32_t batchCount = GetBatchCount(pPage->sizeClass);
+
+	if (list.count >= batchCount * 2) {
+		FreeBlock_t* pLastKept = list.pHead;
+
+		for (uint32_t i = 1; i < batchCount; i++) {
+			pLastKept = pLastKept->pNext;
+		}
+
+		FreeBlock_t* pBatch = pLastKept->pNext;
+		pLastKept->pNext = nullptr;
+		list.count -= batchCount;
+
+		ReturnBlocks(pPage->tag, pPage->sizeClass, pBatch);
+	}
+}
+
+size_t GetPoolBlockSize(size_t size) {
+	return sizeClassBlockSizes[GetSizeClass(size)];
+}
+
+PoolStats_t GetPoolStats() {
+	PoolStats_t stats;
+	stats.numPages = numPages.load(std::memory_order_relaxed);
+	stats.pageBytes = stats.numPages * PoolPageSize;
+	stats.blockBytes = threadBlockBytes.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+}
\ No newline at end of file
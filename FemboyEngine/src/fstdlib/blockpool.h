@@ -0,0 +1,103 @@
+#pragma once
+
+#include "memorytracking.h"
+#include "pointers.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace fe {
+
+// Blocks come in size classes from 16 to PoolMaxBlockSize bytes, in steps
+//	of 16 up to 128 and of a quarter power of two above. Every block is
+//	aligned to PoolBlockAlignment.
+constexpr size_t PoolMaxBlockSize = 512;
+constexpr size_t PoolBlockAlignment = 16;
+
+// Pages are carved into blocks of one size class and one tag, and are
+//	aligned to their size, so a block finds its page by masking its address.
+constexpr size_t PoolPageSize = 64 * 1024;
+
+// Fixed size block allocator for small objects that are created and
+//	destroyed often, like components and render resource wrappers.
+//
+//	Each thread keeps a short free list per tag and size class, so most
+//	allocations and frees are a few instructions without any locking. An
+//	empty thread list takes a batch of blocks from the central list under
+//	its lock, and a thread list that grew too long gives a batch back. A
+//	page whose blocks are all back in the central list is freed, unless it
+//	is the last page of its size class with free blocks.
+//
+//	The tag is charged one allocation of the block size per block in use,
+//	so its counters and budget work like with TaggedAllocate. The pages
+//	themselves aren't charged to any tag, GetPoolStats reports them. A
+//	thread's cached blocks go back to the central lists when it exits.
+void* PoolAllocate(MemoryTag::Enum tag, size_t size);
+
+// p may come from any thread and any tag, the page knows both.
+void PoolFree(void* p);
+
+// The block size PoolAllocate uses for size.
+size_t GetPoolBlockSize(size_t size);
+
+struct PoolStats_t {
+	size_t numPages;
+	size_t pageBytes;
+	// Blocks in use, which the tags are charged for, and free blocks cached
+	//	by threads. The rest of pageBytes is overhead: page headers, the
+	//	unused ends of pages and free blocks in the central lists.
+	size_t blockBytes;
+};
+
+// Like GetMemoryStats, a snapshot taken while other threads allocate may
+//	be slightly off.
+PoolStats_t GetPoolStats();
+
+template<typename T>
+constexpr bool CanPoolAllocate = sizeof(T) <= PoolMaxBlockSize && alignof(T) <= PoolBlockAlignment;
+
+template<typename T, typename... Args>
+T* PoolNew(MemoryTag::Enum tag, Args&&... args) {
+	static_assert(CanPoolAllocate<T>, "Too large or too aligned for the block pool.");
+
+	void* p = PoolAllocate(tag, sizeof(T));
+
+	return new (p) T(std::forward<Args>(args)...);
+}
+
+// p may point to a base of what PoolNew created, as long as the destructor
+//	is virtual.
+template<typename T>
+void PoolDelete(T* p) {
+	if (!p)
+		return;
+
+	void* pBlock;
+
+	if constexpr (std::is_polymorphic_v<T>)
+		pBlock = dynamic_cast<void*>(const_cast<std::remove_cv_t<T>*>(p));
+	else
+		pBlock = const_cast<std::remove_cv_t<T>*>(p);
+
+	p->~T();
+	PoolFree(pBlock);
+}
+
+struct PoolDeleter_t {
+	template<typename T>
+	void operator()(T* p) const {
+		PoolDelete(p);
+	}
+};
+
+// Owns an object made by PoolNew. Converts to PoolPtr<Base> like a ScopedPtr.
+template<typename T>
+using PoolPtr = ScopedPtr<T, PoolDeleter_t>;
+
+template<typename T, typename... Args>
+PoolPtr<T> MakePoolPtr(MemoryTag::Enum tag, Args&&... args) {
+	return PoolPtr<T>(PoolNew<T>(tag, std::forward<Args>(args)...));
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace fe {
+
+// std::vector interface over inline storage for at most N elements, it
+//	never allocates. Going past N is a bug and asserts, use full() to check.
+//	For limits fixed by the API, e.g. the number of render targets.
+template<typename T, size_t N>
+class FixedVector {
+	static_assert(N > 0, "FixedVector needs a capacity.");
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	FixedVector() = default;
+
+	explicit FixedVector(size_t count) {
+		resize(count);
+	}
+
+	FixedVector(size_t count, const T& value) {
+		resize(count, value);
+	}
+
+	template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	FixedVector(InputIt first, InputIt last) {
+		assign(first, last);
+	}
+
+	FixedVector(std::initializer_list<T> values)
+		: FixedVector(values.begin(), values.end()) {}
+
+	FixedVector(const FixedVector& other)
+		: FixedVector(other.begin(), other.end()) {}
+
+	FixedVector(FixedVector&& other) noexcept {
+		std::uninitialized_move(other.begin(), other.end(), data());
+		m_Size = other.m_Size;
+		other.clear();
+	}
+
+	~FixedVector() {
+		clear();
+	}
+
+	FixedVector& operator=(const FixedVector& other) {
+		if (this != &other) {
+			assign(other.begin(), other.end());
+		}
+		return *this;
+	}
+
+	FixedVector& operator=(FixedVector&& other) noexcept {
+		if (this != &other) {
+			clear();
+			std::uninitialized_move(other.begin(), other.end(), data());
+			m_Size = other.m_Size;
+			other.clear();
+		}
+		return *this;
+	}
+
+	FixedVector& operator=(std::initializer_list<T> values) {
+		assign(values.begin(), values.end());
+		return *this;
+	}
+
+	template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	void assign(InputIt first, InputIt last) {
+		clear();
+		for (; first != last; ++first) {
+			emplace_back(*first);
+		}
+	}
+
+	// ===============================================
+	// Element access
+	// ===============================================
+	T& operator[](size_t index) { assert(index < m_Size); return data()[index]; }
+	const T& operator[](size_t index) const { assert(index < m_Size); return data()[index]; }
+
+	T& front() { return (*this)[0]; }
+	const T& front() const { return (*this)[0]; }
+	T& back() { return (*this)[m_Size - 1]; }
+	const T& back() const { return (*this)[m_Size - 1]; }
+
+	T* data() { return reinterpret_cast<T*>(m_Storage); }
+	const T* data() const { return reinterpret_cast<const T*>(m_Storage); }
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + m_Size; }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + m_Size; }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	// ===============================================
+	// Capacity
+	// ===============================================
+	bool empty() const { return m_Size == 0; }
+	bool full() const { return m_Size == N; }
+	size_t size() const { return m_Size; }
+	static constexpr size_t capacity() { return N; }
+	static constexpr size_t max_size() { return N; }
+
+	void reserve(size_t capacity) {
+		assert(capacity <= N);
+	}
+
+	// ===============================================
+	// Modifiers
+	// ===============================================
+	void clear() {
+		std::destroy(begin(), end());
+		m_Size = 0;
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		assert(m_Size < N);
+
+		T* pElement = new (data() + m_Size) T(std::forward<Args>(args)...);
+		m_Size++;
+
+		return *pElement;
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	void pop_back() {
+		assert(m_Size > 0);
+		data()[--m_Size].~T();
+	}
+
+	template<typename... Args>
+	iterator emplace(const_iterator position, Args&&... args) {
+		size_t index = position - begin();
+
+		emplace_back(std::forward<Args>(args)...);
+		std::rotate(begin() + index, end() - 1, end());
+
+		return begin() + index;
+	}
+
+	iterator insert(const_iterator position, const T& value) { return emplace(position, value); }
+	iterator insert(const_iterator position, T&& value) { return emplace(position, std::move(value)); }
+
+	iterator erase(const_iterator position) {
+		return erase(position, position + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		iterator pFirst = begin() + (first - begin());
+		iterator pLast = begin() + (last - begin());
+		iterator pNewEnd = std::move(pLast, end(), pFirst);
+
+		std::destroy(pNewEnd, end());
+		m_Size = pNewEnd - begin();
+
+		return pFirst;
+	}
+
+	void resize(size_t count) {
+		assert(count <= N);
+
+		if (count < m_Size) {
+			std::destroy(begin() + count, end());
+		}
+		else {
+			std::uninitialized_value_construct(end(), begin() + count);
+		}
+		m_Size = count;
+	}
+
+	void resize(size_t count, const T& value) {
+		assert(count <= N);
+
+		if (count < m_Size) {
+			std::destroy(begin() + count, end());
+		}
+		else {
+			std::uninitialized_fill(end(), begin() + count, value);
+		}
+		m_Size = count;
+	}
+
+	bool operator==(const FixedVector& other) const {
+		return std::equal(begin(), end(), other.begin(), other.end());
+	}
+
+private:
+	alignas(T) unsigned char m_Storage[sizeof(T) * N];
+	size_t m_Size = 0;
+};
+
+}
\ No newline at end of file
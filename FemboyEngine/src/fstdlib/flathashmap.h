@@ -0,0 +1,738 @@
+#pragma once
+
+#include "hash.h"
+
+#include "mathlib/simd.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fe {
+
+// std::hash with the bits mixed. The table takes the low 7 bits of the hash
+//	for the control bytes and the rest for the position, and std::hash of an
+//	integer is the integer itself on some standard libraries.
+template<typename T>
+struct FlatHash {
+	size_t operator()(const T& value) const {
+		uint64_t h = static_cast<uint64_t>(std::hash<T>{}(value)) * 0x9E3779B97F4A7C15ull;
+
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+};
+
+// Strings hash as string_view, so lookups can pass a string_view or a literal
+//	without building a std::string. Hash64 is already well mixed and, unlike
+//	some std::hash implementations, doesn't go a byte at a time.
+template<>
+struct FlatHash<std::string_view> {
+	using is_transparent = void;
+
+	size_t operator()(std::string_view value) const {
+		return static_cast<size_t>(Hash64(value));
+	}
+};
+
+template<>
+struct FlatHash<std::string> : FlatHash<std::string_view> {};
+
+namespace detail {
+
+// Control byte of a slot. Full slots hold the low 7 bits of their hash, so
+//	only empty and deleted slots have the sign bit set.
+using FlatCtrl_t = int8_t;
+
+constexpr FlatCtrl_t FlatCtrlEmpty = -128;
+constexpr FlatCtrl_t FlatCtrlDeleted = -2;
+
+constexpr size_t FlatGroupWidth = 16;
+
+// 16 control bytes looked at together. Every match is a bit mask with bit i
+//	set for the i'th byte.
+class FlatGroup_t {
+public:
+	explicit FlatGroup_t(const FlatCtrl_t* pCtrl) {
+#if FE_SIMD_SSE
+		m_Ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl));
+#else
+		memcpy(m_Ctrl, pCtrl, FlatGroupWidth);
+#endif
+	}
+
+	uint32_t Match(uint8_t h2) const {
+#if FE_SIMD_SSE
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Ctrl, _mm_set1_epi8(static_cast<char>(h2)))));
+#else
+		return MatchScalar([h2](FlatCtrl_t ctrl) { return ctrl == static_cast<FlatCtrl_t>(h2); });
+#endif
+	}
+
+	uint32_t MatchEmpty() const {
+#if FE_SIMD_SSE
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Ctrl, _mm_set1_epi8(FlatCtrlEmpty))));
+#else
+		return MatchScalar([](FlatCtrl_t ctrl) { return ctrl == FlatCtrlEmpty; });
+#endif
+	}
+
+	uint32_t MatchEmptyOrDeleted() const {
+#if FE_SIMD_SSE
+		return static_cast<uint32_t>(_mm_movemask_epi8(m_Ctrl));
+#else
+		return MatchScalar([](FlatCtrl_t ctrl) { return ctrl < 0; });
+#endif
+	}
+
+	uint32_t MatchFull() const {
+		return ~MatchEmptyOrDeleted() & 0xFFFF;
+	}
+
+private:
+#if FE_SIMD_SSE
+	__m128i m_Ctrl;
+#else
+	template<typename Predicate>
+	uint32_t MatchScalar(Predicate predicate) const {
+		uint32_t mask = 0;
+
+		for (size_t i = 0; i < FlatGroupWidth; i++) {
+			mask |= predicate(m_Ctrl[i]) ? 1u << i : 0u;
+		}
+
+		return mask;
+	}
+
+	FlatCtrl_t m_Ctrl[FlatGroupWidth];
+#endif
+};
+
+template<bool Transparent>
+struct FlatKeyArg {
+	template<typename K, typename Key>
+	using Type = K;
+};
+
+template<>
+struct FlatKeyArg<false> {
+	template<typename K, typename Key>
+	using Type = Key;
+};
+
+template<typename Key, typename Value>
+struct FlatMapPolicy {
+	using key_type = Key;
+	using value_type = std::pair<const Key, Value>;
+
+	static constexpr bool IsSet = false;
+
+	static const Key& GetKey(const value_type& value) { return value.first; }
+};
+
+template<typename Key>
+struct FlatSetPolicy {
+	using key_type = Key;
+	using value_type = Key;
+
+	static constexpr bool IsSet = true;
+
+	static const Key& GetKey(const value_type& value) { return value; }
+};
+
+// Open addressing table in the style of SwissTable. Next to the slots is an
+//	array of control bytes, which a lookup compares 16 at a time against the
+//	7 hash bits it is looking for, so it only touches the slots that are
+//	likely to match. Probing moves a group at a time and stops at the first
+//	group with an empty slot. The capacity is a power of two, at least 16,
+//	and the table grows at 7/8 full.
+//
+//	The first group of control bytes is mirrored past the end, so a group
+//	can be loaded from any position without wrapping.
+template<typename Policy, typename Hash, typename Equal>
+class FlatHashTable {
+protected:
+	static constexpr bool IsTransparent = requires {
+		typename Hash::is_transparent;
+		typename Equal::is_transparent;
+	};
+
+public:
+	using key_type = typename Policy::key_type;
+	using value_type = typename Policy::value_type;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using hasher = Hash;
+	using key_equal = Equal;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+
+	// With a transparent hash and equal the lookups take anything they
+	//	accept, otherwise only key_type.
+	template<typename K>
+	using KeyArg_t = typename FlatKeyArg<IsTransparent>::template Type<K, key_type>;
+
+	template<bool Const>
+	class Iterator {
+		friend class FlatHashTable;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename Policy::value_type;
+		using difference_type = ptrdiff_t;
+		using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+		using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+		Iterator() = default;
+
+		// iterator to const_iterator.
+		template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+		Iterator(const Iterator<OtherConst>& other)
+			: m_pCtrl(other.m_pCtrl), m_pEnd(other.m_pEnd), m_pSlot(other.m_pSlot) {}
+
+		reference operator*() const { return *m_pSlot; }
+		pointer operator->() const { return m_pSlot; }
+
+		Iterator& operator++() {
+			m_pCtrl++;
+			m_pSlot++;
+
+			// Usually the next slot is full, only search when it isn't.
+			if (m_pCtrl < m_pEnd && *m_pCtrl < 0)
+				SkipFree();
+
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		template<bool OtherConst>
+		bool operator==(const Iterator<OtherConst>& other) const { return m_pCtrl == other.m_pCtrl; }
+
+	private:
+		template<bool> friend class Iterator;
+
+		Iterator(const FlatCtrl_t* pCtrl, const FlatCtrl_t* pEnd, pointer pSlot)
+			: m_pCtrl(pCtrl), m_pEnd(pEnd), m_pSlot(pSlot) {}
+
+		// Moves to the next full slot, a group at a time.
+		void SkipFree() {
+			while (m_pCtrl < m_pEnd) {
+				size_t remaining = static_cast<size_t>(m_pEnd - m_pCtrl);
+				uint32_t full = FlatGroup_t(m_pCtrl).MatchFull();
+				size_t skip = full ? static_cast<size_t>(std::countr_zero(full)) : FlatGroupWidth;
+
+				if (skip >= remaining) {
+					m_pSlot += remaining;
+					m_pCtrl = m_pEnd;
+					return;
+				}
+
+				m_pCtrl += skip;
+				m_pSlot += skip;
+
+				if (full)
+					return;
+			}
+		}
+
+		const FlatCtrl_t* m_pCtrl = nullptr;
+		const FlatCtrl_t* m_pEnd = nullptr;
+		pointer m_pSlot = nullptr;
+	};
+
+	// Sets only hand out const elements, changing a key in place would
+	//	break the table.
+	using const_iterator = Iterator<true>;
+	using iterator = std::conditional_t<Policy::IsSet, const_iterator, Iterator<false>>;
+
+	FlatHashTable() = default;
+
+	explicit FlatHashTable(size_t count, const Hash& hash = Hash(), const Equal& equal = Equal())
+		: m_Hash(hash), m_Equal(equal) {
+		reserve(count);
+	}
+
+	FlatHashTable(const FlatHashTable& other)
+		: m_Hash(other.m_Hash), m_Equal(other.m_Equal) {
+		CopyFrom(other);
+	}
+
+	FlatHashTable(FlatHashTable&& other) noexcept
+		: m_Hash(std::move(other.m_Hash)), m_Equal(std::move(other.m_Equal)) {
+		StealFrom(other);
+	}
+
+	~FlatHashTable() {
+		DestroyAll();
+		Deallocate();
+	}
+
+	FlatHashTable& operator=(const FlatHashTable& other) {
+		if (this != &other) {
+			clear();
+			m_Hash = other.m_Hash;
+			m_Equal = other.m_Equal;
+			CopyFrom(other);
+		}
+		return *this;
+	}
+
+	FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+		if (this != &other) {
+			DestroyAll();
+			Deallocate();
+			m_Hash = std::move(other.m_Hash);
+			m_Equal = std::move(other.m_Equal);
+			StealFrom(other);
+		}
+		return *this;
+	}
+
+	// ===============================================
+	// Iterators
+	// ===============================================
+	iterator begin() { return MakeIterator<iterator>(0, true); }
+	iterator end() { return MakeIterator<iterator>(m_Capacity, false); }
+	const_iterator begin() const { return MakeIterator<const_iterator>(0, true); }
+	const_iterator end() const { return MakeIterator<const_iterator>(m_Capacity, false); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+
+	// ===============================================
+	// Capacity
+	// ===============================================
+	bool empty() const { return m_Size == 0; }
+	size_t size() const { return m_Size; }
+	// Number of slots, the table grows before all of them are used.
+	size_t capacity() const { return m_Capacity; }
+	float load_factor() const { return m_Capacity ? static_cast<float>(m_Size) / static_cast<float>(m_Capacity) : 0.0f; }
+
+	// Makes room for count elements without rehashing.
+	void reserve(size_t count) {
+		size_t capacity = CapacityFor(count);
+
+		if (capacity > m_Capacity)
+			Rehash(capacity);
+	}
+
+	// ===============================================
+	// Lookup
+	// ===============================================
+	template<typename K = key_type>
+	iterator find(const KeyArg_t<K>& key) {
+		size_t index = FindIndex(key, m_Hash(key));
+
+		return index != NotFound ? MakeIterator<iterator>(index, false) : end();
+	}
+
+	template<typename K = key_type>
+	const_iterator find(const KeyArg_t<K>& key) const {
+		size_t index = FindIndex(key, m_Hash(key));
+
+		return index != NotFound ? MakeIterator<const_iterator>(index, false) : end();
+	}
+
+	template<typename K = key_type>
+	bool contains(const KeyArg_t<K>& key) const {
+		return FindIndex(key, m_Hash(key)) != NotFound;
+	}
+
+	template<typename K = key_type>
+	size_t count(const KeyArg_t<K>& key) const {
+		return contains<K>(key) ? 1 : 0;
+	}
+
+	// ===============================================
+	// Modifiers
+	// ===============================================
+	// Keeps the allocation.
+	void clear() {
+		DestroyAll();
+
+		if (m_Capacity) {
+			memset(m_pCtrl, FlatCtrlEmpty, m_Capacity + FlatGroupWidth);
+		}
+
+		m_Size = 0;
+		m_GrowthLeft = MaxLoad(m_Capacity);
+	}
+
+	template<typename K = key_type>
+	size_t erase(const KeyArg_t<K>& key) {
+		size_t index = FindIndex(key, m_Hash(key));
+
+		if (index == NotFound)
+			return 0;
+
+		EraseIndex(index);
+		return 1;
+	}
+
+	// Erasing leaves the other elements where they are, so erase(it++)
+	//	keeps iterating.
+	void erase(const_iterator position) {
+		EraseIndex(static_cast<size_t>(position.m_pCtrl - m_pCtrl));
+	}
+
+	void swap(FlatHashTable& other) noexcept {
+		std::swap(m_Hash, other.m_Hash);
+		std::swap(m_Equal, other.m_Equal);
+		std::swap(m_pCtrl, other.m_pCtrl);
+		std::swap(m_pSlots, other.m_pSlots);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_GrowthLeft, other.m_GrowthLeft);
+	}
+
+	hasher hash_function() const { return m_Hash; }
+	key_equal key_eq() const { return m_Equal; }
+
+protected:
+	static constexpr size_t NotFound = ~static_cast<size_t>(0);
+	static constexpr size_t MinCapacity = FlatGroupWidth;
+
+	// Constructs the element from args unless key is already in the table.
+	//	args is only used when inserting.
+	template<typename K, typename... Args>
+	std::pair<iterator, bool> TryEmplace(const K& key, Args&&... args) {
+		size_t hash = m_Hash(key);
+		size_t index = FindIndex(key, hash);
+
+		if (index != NotFound)
+			return { MakeIterator<iterator>(index, false), false };
+
+		index = PrepareInsert(hash);
+
+		new (m_pSlots + index) value_type(std::forward<Args>(args)...);
+
+		if (m_pCtrl[index] == FlatCtrlEmpty)
+			m_GrowthLeft--;
+
+		SetCtrl(index, H2(hash));
+		m_Size++;
+
+		return { MakeIterator<iterator>(index, false), true };
+	}
+
+private:
+	static size_t H1(size_t hash) { return hash >> 7; }
+	static uint8_t H2(size_t hash) { return static_cast<uint8_t>(hash & 0x7F); }
+
+	static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+	static size_t CapacityFor(size_t count) {
+		if (count == 0)
+			return 0;
+
+		size_t capacity = std::bit_ceil(count + (count + 6) / 7);
+
+		return std::max(capacity, MinCapacity);
+	}
+
+	template<typename It>
+	It MakeIterator(size_t index, bool skipFree) const {
+		It it(m_pCtrl + index, m_pCtrl + m_Capacity, m_pSlots + index);
+
+		if (skipFree)
+			it.SkipFree();
+
+		return it;
+	}
+
+	template<typename K>
+	size_t FindIndex(const K& key, size_t hash) const {
+		if (m_Capacity == 0)
+			return NotFound;
+
+		size_t mask = m_Capacity - 1;
+		size_t position = H1(hash) & mask;
+		uint8_t h2 = H2(hash);
+
+		// Triangular steps over the groups reach every one of them once,
+		//	and there is always an empty slot to stop at.
+		for (size_t step = FlatGroupWidth;; step += FlatGroupWidth) {
+			FlatGroup_t group(m_pCtrl + position);
+
+			for (uint32_t match = group.Match(h2); match; match &= match - 1) {
+				size_t index = (position + std::countr_zero(match)) & mask;
+
+				if (m_Equal(Policy::GetKey(m_pSlots[index]), key))
+					return index;
+			}
+
+			if (group.MatchEmpty())
+				return NotFound;
+
+			position = (position + step) & mask;
+		}
+	}
+
+	// First empty or deleted slot on the probe sequence of hash.
+	size_t FindFreeIndex(size_t hash) const {
+		size_t mask = m_Capacity - 1;
+		size_t position = H1(hash) & mask;
+
+		for (size_t step = FlatGroupWidth;; step += FlatGroupWidth) {
+			uint32_t free = FlatGroup_t(m_pCtrl + position).MatchEmptyOrDeleted();
+
+			if (free)
+				return (position + std::countr_zero(free)) & mask;
+
+			position = (position + step) & mask;
+		}
+	}
+
+	size_t PrepareInsert(size_t hash) {
+		if (m_Capacity == 0)
+			Rehash(MinCapacity);
+
+		size_t index = FindFreeIndex(hash);
+
+		// Reusing a deleted slot doesn't take away an empty one.
+		if (m_GrowthLeft == 0 && m_pCtrl[index] != FlatCtrlDeleted) {
+			// Mostly tombstones, clean up in place instead of growing.
+			if (m_Size <= MaxLoad(m_Capacity) / 2)
+				Rehash(m_Capacity);
+			else
+				Rehash(m_Capacity * 2);
+
+			index = FindFreeIndex(hash);
+		}
+
+		return index;
+	}
+
+	void SetCtrl(size_t index, FlatCtrl_t ctrl) {
+		m_pCtrl[index] = ctrl;
+
+		if (index < FlatGroupWidth)
+			m_pCtrl[m_Capacity + index] = ctrl;
+	}
+
+	void SetCtrl(size_t index, uint8_t h2) {
+		SetCtrl(index, static_cast<FlatCtrl_t>(h2));
+	}
+
+	void EraseIndex(size_t index) {
+		m_pSlots[index].~value_type();
+		m_Size--;
+
+		// The slot can go back to empty if no probe ever went past it, which
+		//	is when every group that contains it also has an empty slot.
+		size_t mask = m_Capacity - 1;
+		uint32_t emptyBefore = FlatGroup_t(m_pCtrl + ((index - FlatGroupWidth) & mask)).MatchEmpty();
+		uint32_t emptyAfter = FlatGroup_t(m_pCtrl + index).MatchEmpty();
+
+		bool wasNeverFull = emptyBefore && emptyAfter &&
+			static_cast<size_t>(std::countr_zero(emptyAfter) + std::countl_zero(static_cast<uint16_t>(emptyBefore))) < FlatGroupWidth;
+
+		if (wasNeverFull) {
+			SetCtrl(index, FlatCtrlEmpty);
+			m_GrowthLeft++;
+		}
+		else {
+			SetCtrl(index, FlatCtrlDeleted);
+		}
+	}
+
+	// Control bytes first, then the slots.
+	static size_t CtrlBytes(size_t capacity) {
+		size_t alignment = alignof(value_type);
+
+		return (capacity + FlatGroupWidth + alignment - 1) & ~(alignment - 1);
+	}
+
+	static constexpr size_t StorageAlignment() {
+		return std::max(alignof(value_type), static_cast<size_t>(16));
+	}
+
+	void Allocate(size_t capacity) {
+		size_t ctrlBytes = CtrlBytes(capacity);
+		uint8_t* pStorage = static_cast<uint8_t*>(::operator new(ctrlBytes + sizeof(value_type) * capacity, std::align_val_t(StorageAlignment())));
+
+		m_pCtrl = reinterpret_cast<FlatCtrl_t*>(pStorage);
+		m_pSlots = reinterpret_cast<value_type*>(pStorage + ctrlBytes);
+		m_Capacity = capacity;
+		m_GrowthLeft = MaxLoad(capacity) - m_Size;
+
+		memset(m_pCtrl, FlatCtrlEmpty, capacity + FlatGroupWidth);
+	}
+
+	void Deallocate() {
+		if (m_Capacity) {
+			::operator delete(m_pCtrl, std::align_val_t(StorageAlignment()));
+		}
+
+		m_pCtrl = nullptr;
+		m_pSlots = nullptr;
+		m_Capacity = 0;
+		m_GrowthLeft = 0;
+	}
+
+	void Rehash(size_t newCapacity) {
+		FlatCtrl_t* pOldCtrl = m_pCtrl;
+		value_type* pOldSlots = m_pSlots;
+		size_t oldCapacity = m_Capacity;
+
+		Allocate(newCapacity);
+
+		for (size_t i = 0; i < oldCapacity; i++) {
+			if (pOldCtrl[i] < 0)
+				continue;
+
+			size_t hash = m_Hash(Policy::GetKey(pOldSlots[i]));
+			size_t index = FindFreeIndex(hash);
+
+			new (m_pSlots + index) value_type(std::move(pOldSlots[i]));
+			pOldSlots[i].~value_type();
+
+			SetCtrl(index, H2(hash));
+		}
+
+		if (oldCapacity) {
+			::operator delete(pOldCtrl, std::align_val_t(StorageAlignment()));
+		}
+	}
+
+	void DestroyAll() {
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (size_t i = 0; i < m_Capacity; i++) {
+				if (m_pCtrl[i] >= 0)
+					m_pSlots[i].~value_type();
+			}
+		}
+	}
+
+	// Expects this to be empty.
+	void CopyFrom(const FlatHashTable& other) {
+		reserve(other.m_Size);
+
+		for (size_t i = 0; i < other.m_Capacity; i++) {
+			if (other.m_pCtrl[i] < 0)
+				continue;
+
+			size_t hash = m_Hash(Policy::GetKey(other.m_pSlots[i]));
+			size_t index = FindFreeIndex(hash);
+
+			new (m_pSlots + index) value_type(other.m_pSlots[i]);
+
+			SetCtrl(index, H2(hash));
+			m_Size++;
+			m_GrowthLeft--;
+		}
+	}
+
+	// Expects this to hold no allocation.
+	void StealFrom(FlatHashTable& other) {
+		m_pCtrl = std::exchange(other.m_pCtrl, nullptr);
+		m_pSlots = std::exchange(other.m_pSlots, nullptr);
+		m_Capacity = std::exchange(other.m_Capacity, 0);
+		m_Size = std::exchange(other.m_Size, 0);
+		m_GrowthLeft = std::exchange(other.m_GrowthLeft, 0);
+	}
+
+	Hash m_Hash;
+	Equal m_Equal;
+
+	FlatCtrl_t* m_pCtrl = nullptr;
+	value_type* m_pSlots = nullptr;
+	size_t m_Capacity = 0;
+	size_t m_Size = 0;
+	// Empty slots that can still be filled before the table has to grow.
+	size_t m_GrowthLeft = 0;
+};
+
+}
+
+// Drop in for std::unordered_map where nothing holds on to element pointers,
+//	inserting and erasing may move the elements. Elements are stored inline,
+//	so lookups cost a few cache misses at most instead of a node walk.
+template<typename Key, typename Value, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>>
+class FlatHashMap : public detail::FlatHashTable<detail::FlatMapPolicy<Key, Value>, Hash, Equal> {
+	using Base = detail::FlatHashTable<detail::FlatMapPolicy<Key, Value>, Hash, Equal>;
+
+public:
+	using mapped_type = Value;
+	using typename Base::value_type;
+	using typename Base::iterator;
+
+	using Base::Base;
+
+	std::pair<iterator, bool> insert(const value_type& value) {
+		return this->TryEmplace(value.first, value);
+	}
+
+	std::pair<iterator, bool> insert(value_type&& value) {
+		return this->TryEmplace(value.first, std::move(value));
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+		return this->TryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+		return this->TryEmplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+	}
+
+	template<typename V>
+	std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value) {
+		auto result = try_emplace(key, std::forward<V>(value));
+
+		if (!result.second)
+			result.first->second = std::forward<V>(value);
+
+		return result;
+	}
+
+	Value& operator[](const Key& key) {
+		return try_emplace(key).first->second;
+	}
+
+	Value& operator[](Key&& key) {
+		return try_emplace(std::move(key)).first->second;
+	}
+};
+
+template<typename Key, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>>
+class FlatHashSet : public detail::FlatHashTable<detail::FlatSetPolicy<Key>, Hash, Equal> {
+	using Base = detail::FlatHashTable<detail::FlatSetPolicy<Key>, Hash, Equal>;
+
+public:
+	using typename Base::iterator;
+
+	using Base::Base;
+
+	std::pair<iterator, bool> insert(const Key& key) {
+		return this->TryEmplace(key, key);
+	}
+
+	std::pair<iterator, bool> insert(Key&& key) {
+		return this->TryEmplace(key, std::move(key));
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> emplace(Args&&... args) {
+		Key key(std::forward<Args>(args)...);
+
+		return this->TryEmplace(key, std::move(key));
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,507 @@
+#include "hash.h"
+
+#include "mathlib/simd.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace fe {
+
+// The primes of xxHash.
+constexpr uint64_t Prime32_1 = 0x9E3779B1u;
+constexpr uint64_t Prime32_2 = 0x85EBCA77u;
+constexpr uint64_t Prime32_3 = 0xC2B2AE3Du;
+constexpr uint64_t Prime64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t Prime64_3 = 0x165667B19E3779F9ull;
+constexpr uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t Prime64_5 = 0x27D4EB2F165667C5ull;
+
+constexpr size_t ShortMaxSize = 128;
+constexpr size_t StripeSize = Hasher::StripeSize;
+constexpr size_t SecretWords = Hasher::SecretWords;
+
+// The accumulators are scrambled after every block of stripes, before the
+//	sums can carry too much away.
+constexpr size_t StripesPerBlock = 16;
+
+// Where each use starts in the secret, in words. Stripe n of a block uses
+//	the 8 words from n on, so equal stripes in different places of a block
+//	add different products.
+constexpr size_t LastStripeSecret = StripesPerBlock + 7;
+constexpr size_t ScrambleSecret = LastStripeSecret + 8;
+constexpr size_t MergeLowSecret = ScrambleSecret + 8;
+constexpr size_t MergeHighSecret = MergeLowSecret + 8;
+static_assert(MergeHighSecret + 8 <= SecretWords);
+
+// splitmix64 of a fixed start, the fractional part of sqrt(2).
+static constexpr auto defaultSecret = []() {
+	std::array<uint64_t, SecretWords> secret = {};
+	uint64_t state = 0x6A09E667F3BCC908ull;
+
+	for (uint64_t& word : secret) {
+		state += 0x9E3779B97F4A7C15ull;
+
+		uint64_t z = state;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		word = z ^ (z >> 31);
+	}
+
+	return secret;
+}();
+
+static constexpr uint64_t initialAccumulators[8] = {
+	Prime32_3, Prime64_1, Prime64_2, Prime64_3,
+	Prime64_4, Prime32_2, Prime64_5, Prime32_1,
+};
+
+// ===============================================
+// Helpers
+// ===============================================
+// Reads are little endian, like every platform the engine runs on.
+static FE_FORCEINLINE uint64_t Read64(const uint8_t* p) {
+	uint64_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static FE_FORCEINLINE uint64_t Read32(const uint8_t* p) {
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static FE_FORCEINLINE void Multiply128(uint64_t a, uint64_t b, uint64_t& low, uint64_t& high) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	low = _umul128(a, b, &high);
+#else
+	unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+	low = static_cast<uint64_t>(product);
+	high = static_cast<uint64_t>(product >> 64);
+#endif
+}
+
+// Both halves of the full product folded together.
+static FE_FORCEINLINE uint64_t Mix(uint64_t a, uint64_t b) {
+	uint64_t low, high;
+	Multiply128(a, b, low, high);
+
+	return low ^ high;
+}
+
+static uint64_t Avalanche(uint64_t h) {
+	h ^= h >> 37;
+	h *= 0x165667919E3779F9ull;
+	return h ^ (h >> 32);
+}
+
+// Same secret layout for every seed, the words are only shifted by it.
+static void DeriveSecret(uint64_t seed, uint64_t* pSecret) {
+	for (size_t i = 0; i < SecretWords; i++) {
+		pSecret[i] = defaultSecret[i] + ((i & 1) ? 0 - seed : seed);
+	}
+}
+
+// ===============================================
+// Up to 128 bytes
+// ===============================================
+// Mix at compile time, from 32 bit halves.
+static constexpr uint64_t MixConstant(uint64_t a, uint64_t b) {
+	uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+	uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+
+	uint64_t lowLow = aLow * bLow;
+	uint64_t lowHigh = aLow * bHigh;
+	uint64_t highLow = aHigh * bLow;
+	uint64_t highHigh = aHigh * bHigh;
+
+	uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+	uint64_t low = (middle << 32) | (lowLow & 0xFFFFFFFFu);
+	uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+
+	return low ^ high;
+}
+
+// The seed HashShort starts from, for the secret words at pSecret. Seed 0,
+//	which nearly every call uses, is precomputed.
+static FE_FORCEINLINE uint64_t MixSeed(uint64_t seed, const uint64_t* pSecret) {
+	constexpr uint64_t zeroSeeds[2] = {
+		MixConstant(defaultSecret[0], defaultSecret[1]),
+		MixConstant(defaultSecret[4], defaultSecret[5]),
+	};
+
+	if (seed == 0 && (pSecret == defaultSecret.data() || pSecret == defaultSecret.data() + 4))
+		return zeroSeeds[pSecret != defaultSecret.data()];
+
+	return seed ^ Mix(seed ^ pSecret[0], pSecret[1]);
+}
+
+// wyhash's mixing with our own secret, whose first 4 words are used.
+//	Hash128 calls it again with the next 4 for the high half.
+static uint64_t HashShort(const uint8_t* p, size_t size, uint64_t seed, const uint64_t* pSecret) {
+	seed = MixSeed(seed, pSecret);
+
+	uint64_t a, b;
+
+	if (size <= 16) {
+		if (size >= 4) {
+			// Two overlapping pairs of 4 bytes, which together cover 4 to 16.
+			size_t offset = (size >> 3) << 2;
+
+			a = (Read32(p) << 32) | Read32(p + offset);
+			b = (Read32(p + size - 4) << 32) | Read32(p + size - 4 - offset);
+		}
+		else if (size > 0) {
+			a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+			b = 0;
+		}
+		else {
+			a = b = 0;
+		}
+	}
+	else {
+		size_t remaining = size;
+
+		if (remaining > 48) {
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+
+			do {
+				seed = Mix(Read64(p) ^ pSecret[1], Read64(p + 8) ^ seed);
+				seed1 = Mix(Read64(p + 16) ^ pSecret[2], Read64(p + 24) ^ seed1);
+				seed2 = Mix(Read64(p + 32) ^ pSecret[3], Read64(p + 40) ^ seed2);
+				p += 48;
+				remaining -= 48;
+			} while (remaining > 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (remaining > 16) {
+			seed = Mix(Read64(p) ^ pSecret[1], Read64(p + 8) ^ seed);
+			p += 16;
+			remaining -= 16;
+		}
+
+		// The last 16 bytes, which can reach back into the ones mixed above.
+		a = Read64(p + remaining - 16);
+		b = Read64(p + remaining - 8);
+	}
+
+	Multiply128(a ^ pSecret[1], b ^ seed, a, b);
+
+	return Mix(a ^ pSecret[0] ^ size, b ^ pSecret[1]);
+}
+
+// ===============================================
+// Stripes
+// ===============================================
+// Per 64 bit lane i of a stripe: the low times the high half of the data
+//	xor secret goes into lane i, the data itself into the neighbouring lane
+//	so it isn't lost when the product is 0. SSE2 and AVX2 do the same with
+//	_mul_epu32, 2 and 4 lanes at a time.
+static void AccumulateStripes(uint64_t* pAccumulators, const uint8_t* p, size_t numStripes, const uint64_t* pSecret) {
+#if FE_SIMD_AVX2
+	__m256i acc[2];
+
+	for (size_t j = 0; j < 2; j++) {
+		acc[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pAccumulators + j * 4));
+	}
+
+	for (size_t n = 0; n < numStripes; n++, p += StripeSize, pSecret++) {
+		for (size_t j = 0; j < 2; j++) {
+			__m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + j * 32));
+			__m256i key = _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSecret + j * 4)));
+			__m256i product = _mm256_mul_epu32(key, _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+			__m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+			acc[j] = _mm256_add_epi64(acc[j], _mm256_add_epi64(product, swapped));
+		}
+	}
+
+	for (size_t j = 0; j < 2; j++) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pAccumulators + j * 4), acc[j]);
+	}
+#elif FE_SIMD_SSE
+	__m128i acc[4];
+
+	for (size_t j = 0; j < 4; j++) {
+		acc[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAccumulators + j * 2));
+	}
+
+	for (size_t n = 0; n < numStripes; n++, p += StripeSize, pSecret++) {
+		for (size_t j = 0; j < 4; j++) {
+			__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + j * 16));
+			__m128i key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSecret + j * 2)));
+			__m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+			__m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+			acc[j] = _mm_add_epi64(acc[j], _mm_add_epi64(product, swapped));
+		}
+	}
+
+	for (size_t j = 0; j < 4; j++) {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pAccumulators + j * 2), acc[j]);
+	}
+#else
+	for (size_t n = 0; n < numStripes; n++, p += StripeSize, pSecret++) {
+		for (size_t i = 0; i < 8; i++) {
+			uint64_t data = Read64(p + i * 8);
+			uint64_t key = data ^ pSecret[i];
+
+			pAccumulators[i ^ 1] += data;
+			pAccumulators[i] += (key & 0xFFFFFFFFu) * (key >> 32);
+		}
+	}
+#endif
+}
+
+// Spreads the high bits of every lane over its low ones, which the next
+//	block's products start from.
+static void ScrambleAccumulators(uint64_t* pAccumulators, const uint64_t* pSecret) {
+#if FE_SIMD_SSE
+	const __m128i prime = _mm_set1_epi32(static_cast<int>(Prime32_1));
+
+	for (size_t j = 0; j < 4; j++) {
+		__m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAccumulators + j * 2));
+		acc = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+		acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSecret + j * 2)));
+
+		// 64 bit times 32 bit, from the two 32 bit halves.
+		__m128i low = _mm_mul_epu32(acc, prime);
+		__m128i high = _mm_mul_epu32(_mm_shuffle_epi32(acc, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+		acc = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pAccumulators + j * 2), acc);
+	}
+#else
+	for (size_t i = 0; i < 8; i++) {
+		uint64_t acc = pAccumulators[i];
+		acc ^= acc >> 47;
+		acc ^= pSecret[i];
+		pAccumulators[i] = acc * Prime32_1;
+	}
+#endif
+}
+
+// Continues the block that stripesInBlock stripes were already added to.
+static void ConsumeStripes(uint64_t* pAccumulators, uint32_t& stripesInBlock, const uint8_t* p, size_t numStripes, const uint64_t* pSecret) {
+	while (numStripes > 0) {
+		size_t count = std::min<size_t>(numStripes, StripesPerBlock - stripesInBlock);
+
+		AccumulateStripes(pAccumulators, p, count, pSecret + stripesInBlock);
+
+		p += count * StripeSize;
+		numStripes -= count;
+		stripesInBlock += static_cast<uint32_t>(count);
+
+		if (stripesInBlock == StripesPerBlock) {
+			ScrambleAccumulators(pAccumulators, pSecret + ScrambleSecret);
+			stripesInBlock = 0;
+		}
+	}
+}
+
+static uint64_t MergeAccumulators(const uint64_t* pAccumulators, const uint64_t* pSecret, uint64_t start) {
+	uint64_t result = start;
+
+	for (size_t i = 0; i < 8; i += 2) {
+		result += Mix(pAccumulators[i] ^ pSecret[i], pAccumulators[i + 1] ^ pSecret[i + 1]);
+	}
+
+	return Avalanche(result);
+}
+
+static uint64_t MergeLow(const uint64_t* pAccumulators, const uint64_t* pSecret, uint64_t size) {
+	return MergeAccumulators(pAccumulators, pSecret + MergeLowSecret, size * Prime64_1);
+}
+
+static uint64_t MergeHigh(const uint64_t* pAccumulators, const uint64_t* pSecret, uint64_t size) {
+	return MergeAccumulators(pAccumulators, pSecret + MergeHighSecret, ~(size * Prime64_2));
+}
+
+// Every full stripe before the last byte, then the last 64 bytes on their
+//	own, which may overlap the stripes before.
+static void AccumulateLong(uint64_t* pAccumulators, const uint8_t* p, size_t size, const uint64_t* pSecret) {
+	uint32_t stripesInBlock = 0;
+
+	std::copy_n(initialAccumulators, 8, pAccumulators);
+	ConsumeStripes(pAccumulators, stripesInBlock, p, (size - 1) / StripeSize, pSecret);
+	AccumulateStripes(pAccumulators, p + size - StripeSize, 1, pSecret + LastStripeSecret);
+}
+
+// ===============================================
+// One-shot hashing
+// ===============================================
+uint64_t Hash64(const void* pData, size_t size, uint64_t seed) {
+	const uint8_t* p = static_cast<const uint8_t*>(pData);
+
+	if (size <= ShortMaxSize)
+		return HashShort(p, size, seed, defaultSecret.data());
+
+	uint64_t seededSecret[SecretWords];
+	const uint64_t* pSecret = defaultSecret.data();
+
+	if (seed) {
+		DeriveSecret(seed, seededSecret);
+		pSecret = seededSecret;
+	}
+
+	alignas(32) uint64_t accumulators[8];
+	AccumulateLong(accumulators, p, size, pSecret);
+
+	return MergeLow(accumulators, pSecret, size);
+}
+
+Hash128_t Hash128(const void* pData, size_t size, uint64_t seed) {
+	const uint8_t* p = static_cast<const uint8_t*>(pData);
+
+	if (size <= ShortMaxSize)
+		return { HashShort(p, size, seed, defaultSecret.data()), HashShort(p, size, seed, defaultSecret.data() + 4) };
+
+	uint64_t seededSecret[SecretWords];
+	const uint64_t* pSecret = defaultSecret.data();
+
+	if (seed) {
+		DeriveSecret(seed, seededSecret);
+		pSecret = seededSecret;
+	}
+
+	alignas(32) uint64_t accumulators[8];
+	AccumulateLong(accumulators, p, size, pSecret);
+
+	return { MergeLow(accumulators, pSecret, size), MergeHigh(accumulators, pSecret, size) };
+}
+
+uint64_t HashFloats(const float* pValues, size_t count, uint64_t seed) {
+	constexpr size_t ChunkSize = 64;
+	uint32_t bits[ChunkSize];
+
+	auto normalize = [&](const float* pChunk, size_t chunkCount) {
+		for (size_t i = 0; i < chunkCount; i++) {
+			uint32_t value = std::bit_cast<uint32_t>(pChunk[i]);
+
+			// -0 has only the sign bit set.
+			bits[i] = (value << 1) ? value : 0;
+		}
+	};
+
+	if (count <= ChunkSize) {
+		normalize(pValues, count);
+		return Hash64(bits, count * sizeof(uint32_t), seed);
+	}
+
+	Hasher hasher(seed);
+
+	for (size_t i = 0; i < count; i += ChunkSize) {
+		size_t chunkCount = std::min(ChunkSize, count - i);
+
+		normalize(pValues + i, chunkCount);
+		hasher.Update(bits, chunkCount * sizeof(uint32_t));
+	}
+
+	return hasher.Finish();
+}
+
+// ===============================================
+// Hasher
+// ===============================================
+Hasher::Hasher(uint64_t seed) {
+	Reset(seed);
+}
+
+void Hasher::Reset(uint64_t seed) {
+	if (seed)
+		DeriveSecret(seed, m_Secret);
+	else
+		std::copy(defaultSecret.begin(), defaultSecret.end(), m_Secret);
+
+	std::copy_n(initialAccumulators, 8, m_Accumulators);
+	m_Seed = seed;
+	m_TotalSize = 0;
+	m_BufferedSize = 0;
+	m_StripesInBlock = 0;
+}
+
+// Bytes are only consumed once more input follows them, so the buffer
+//	always holds the end of the input, and everything while the input still
+//	fits the short path.
+void Hasher::Update(const void* pData, size_t size) {
+	if (size == 0)
+		return;
+
+	const uint8_t* p = static_cast<const uint8_t*>(pData);
+	uint8_t* pBuffer = m_Buffer + StripeSize;
+
+	m_TotalSize += size;
+
+	if (m_BufferedSize + size <= BufferSize) {
+		memcpy(pBuffer + m_BufferedSize, p, size);
+		m_BufferedSize += static_cast<uint32_t>(size);
+		return;
+	}
+
+	if (m_BufferedSize) {
+		size_t fill = BufferSize - m_BufferedSize;
+
+		memcpy(pBuffer + m_BufferedSize, p, fill);
+		p += fill;
+		size -= fill;
+
+		ConsumeStripes(m_Accumulators, m_StripesInBlock, pBuffer, BufferSize / StripeSize, m_Secret);
+		memcpy(m_Buffer, pBuffer + BufferSize - StripeSize, StripeSize);
+	}
+
+	if (size > BufferSize) {
+		size_t numStripes = (size - 1) / StripeSize;
+
+		ConsumeStripes(m_Accumulators, m_StripesInBlock, p, numStripes, m_Secret);
+		p += numStripes * StripeSize;
+		size -= numStripes * StripeSize;
+
+		memcpy(m_Buffer, p - StripeSize, StripeSize);
+	}
+
+	memcpy(pBuffer, p, size);
+	m_BufferedSize = static_cast<uint32_t>(size);
+}
+
+void Hasher::AccumulateRemaining(uint64_t* pAccumulators) const {
+	const uint8_t* pBuffer = m_Buffer + StripeSize;
+	uint32_t stripesInBlock = m_StripesInBlock;
+
+	std::copy_n(m_Accumulators, 8, pAccumulators);
+	ConsumeStripes(pAccumulators, stripesInBlock, pBuffer, (m_BufferedSize - 1) / StripeSize, m_Secret);
+	AccumulateStripes(pAccumulators, pBuffer + m_BufferedSize - StripeSize, 1, m_Secret + LastStripeSecret);
+}
+
+uint64_t Hasher::Finish() const {
+	if (m_TotalSize <= ShortMaxSize)
+		return HashShort(m_Buffer + StripeSize, m_TotalSize, m_Seed, defaultSecret.data());
+
+	alignas(32) uint64_t accumulators[8];
+	AccumulateRemaining(accumulators);
+
+	return MergeLow(accumulators, m_Secret, m_TotalSize);
+}
+
+Hash128_t Hasher::Finish128() const {
+	const uint8_t* pBuffer = m_Buffer + StripeSize;
+
+	if (m_TotalSize <= ShortMaxSize)
+		return { HashShort(pBuffer, m_TotalSize, m_Seed, defaultSecret.data()), HashShort(pBuffer, m_TotalSize, m_Seed, defaultSecret.data() + 4) };
+
+	alignas(32) uint64_t accumulators[8];
+	AccumulateRemaining(accumulators);
+
+	return { MergeLow(accumulators, m_Secret, m_TotalSize), MergeHigh(accumulators, m_Secret, m_TotalSize) };
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace fe {
+
+// ===============================================
+// One-shot hashing
+// ===============================================
+// Fast non-cryptographic hashes of byte ranges, for hash tables and cache
+//	keys. Not for anything an attacker controls.
+//
+//	Up to 128 bytes are mixed with 64x64->128 bit multiplies, in the style
+//	of wyhash. Longer ranges go through 8 64 bit accumulators that take a
+//	64 byte stripe at a time, in the style of XXH3, which is what the SSE2
+//	and AVX2 paths speed up. Every path gives the same result, so hashes
+//	can be stored on disk, but they may change between engine versions.
+uint64_t Hash64(const void* pData, size_t size, uint64_t seed = 0);
+
+inline uint64_t Hash64(std::string_view str, uint64_t seed = 0) {
+	return Hash64(str.data(), str.size(), seed);
+}
+
+struct Hash128_t {
+	uint64_t low;
+	uint64_t high;
+
+	bool operator==(const Hash128_t& other) const = default;
+};
+
+// For content addressed keys, where a collision would silently hand out
+//	the wrong data. The low half is Hash64 of the same bytes and seed.
+Hash128_t Hash128(const void* pData, size_t size, uint64_t seed = 0);
+
+inline Hash128_t Hash128(std::string_view str, uint64_t seed = 0) {
+	return Hash128(str.data(), str.size(), seed);
+}
+
+// Hashes the bytes of value. Only for types without padding, whose equal
+//	values have equal bytes.
+template<typename T>
+uint64_t HashBytesOf(const T& value, uint64_t seed = 0) {
+	static_assert(std::has_unique_object_representations_v<T>, "The bytes of T don't identify its value, hash its members.");
+	return Hash64(&value, sizeof(T), seed);
+}
+
+// Hashes floats by value, so -0 and +0 hash the same.
+uint64_t HashFloats(const float* pValues, size_t count, uint64_t seed = 0);
+
+// Folds a hash into seed, for combining the hashes of members.
+inline uint64_t HashCombine(uint64_t seed, uint64_t hash) {
+	seed ^= hash + 0x9E3779B97F4A7C15ull + (seed << 12) + (seed >> 4);
+	return seed;
+}
+
+// ===============================================
+// Streaming
+// ===============================================
+// Hashes data that arrives in pieces, like a file read in chunks or a key
+//	built from several fields. The result only depends on the bytes, not on
+//	how they were split, and equals Hash64 and Hash128 of all of them at
+//	once with the same seed.
+//
+//	Keeps the accumulators, the seeded secret and up to 256 unprocessed
+//	bytes, under 1KB in total, so it can live on the stack.
+class Hasher {
+public:
+	explicit Hasher(uint64_t seed = 0);
+
+	void Update(const void* pData, size_t size);
+
+	void Update(std::string_view str) {
+		Update(str.data(), str.size());
+	}
+
+	// Appends the bytes of value, see HashBytesOf.
+	template<typename T>
+	void UpdateBytesOf(const T& value) {
+		static_assert(std::has_unique_object_representations_v<T>, "The bytes of T don't identify its value, hash its members.");
+		Update(&value, sizeof(T));
+	}
+
+	// Can be called more than once, and Update can continue afterwards.
+	uint64_t Finish() const;
+	Hash128_t Finish128() const;
+
+	void Reset(uint64_t seed = 0);
+
+	static constexpr size_t StripeSize = 64;
+	static constexpr size_t BufferSize = 256;
+	static constexpr size_t SecretWords = 56;
+
+private:
+	// Accumulators of everything so far, as if the input ended here.
+	void AccumulateRemaining(uint64_t* pAccumulators) const;
+
+	alignas(64) uint64_t m_Accumulators[8];
+	// The last consumed stripe followed by the unprocessed bytes. Finish
+	//	needs the last 64 bytes of the input, which can start in the stripe.
+	alignas(64) uint8_t m_Buffer[StripeSize + BufferSize];
+	uint64_t m_Secret[SecretWords];
+	uint64_t m_Seed;
+	uint64_t m_TotalSize;
+	uint32_t m_BufferedSize;
+	uint32_t m_StripesInBlock;
+};
+
+}
+
+template<>
+struct std::hash<fe::Hash128_t> {
+	size_t operator()(const fe::Hash128_t& hash) const noexcept {
+		return static_cast<size_t>(hash.low);
+	}
+};
\ No newline at end of file
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace fe {
+
+// Room for a lambda capturing 4 pointers, or a pointer to member function
+//	and an object.
+constexpr size_t InplaceFunctionDefaultCapacity = 4 * sizeof(void*);
+
+template<typename Signature, size_t Capacity = InplaceFunctionDefaultCapacity>
+class InplaceFunction;
+
+namespace detail {
+
+template<typename T>
+struct IsInplaceFunction : std::false_type {};
+
+template<typename Signature, size_t Capacity>
+struct IsInplaceFunction<InplaceFunction<Signature, Capacity>> : std::true_type {};
+
+}
+
+// std::function that stores the callable inside itself and never
+//	allocates. A callable larger than Capacity, or aligned more than
+//	std::max_align_t, fails to compile instead of falling back to the heap,
+//	raise Capacity or capture less.
+//
+//	It is move-only, so it can hold move-only callables like lambdas
+//	capturing a ScopedPtr. A call goes through one function pointer stored
+//	next to the callable. Callables that are trivially copyable need no
+//	code to move or destroy, so moving the wrapper is a memcpy.
+//
+//	Like std::function the stored callable is called as non-const, even
+//	through a const InplaceFunction. Calling an empty one asserts.
+template<typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+	static_assert(Capacity >= sizeof(void*), "InplaceFunction needs room for at least a function pointer.");
+
+public:
+	InplaceFunction() = default;
+
+	InplaceFunction(std::nullptr_t) {}
+
+	template<typename F, typename Callable = std::decay_t<F>,
+		typename = std::enable_if_t<!detail::IsInplaceFunction<Callable>::value && std::is_invocable_r_v<R, Callable&, Args...>>>
+	InplaceFunction(F&& function) {
+		static_assert(sizeof(Callable) <= Capacity, "Callable doesn't fit the InplaceFunction, raise its Capacity.");
+		static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is aligned too much for an InplaceFunction.");
+		static_assert(std::is_nothrow_move_constructible_v<Callable>, "InplaceFunction moves its callable and can't handle a throwing move.");
+
+		// A null function pointer makes an empty function, like std::function.
+		if constexpr (std::is_pointer_v<Callable> || std::is_member_pointer_v<Callable>) {
+			if (!function)
+				return;
+		}
+
+		new (m_Storage) Callable(std::forward<F>(function));
+		m_pInvoke = &Invoke<Callable>;
+
+		if constexpr (!std::is_trivially_copyable_v<Callable>)
+			m_pManage = &Manage<Callable>;
+	}
+
+	InplaceFunction(InplaceFunction&& other) noexcept {
+		MoveFrom(other);
+	}
+
+	InplaceFunction(const InplaceFunction&) = delete;
+
+	~InplaceFunction() {
+		Destroy();
+	}
+
+	InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+		if (this != &other) {
+			Destroy();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+	InplaceFunction& operator=(std::nullptr_t) {
+		Destroy();
+		return *this;
+	}
+
+	template<typename F, typename = std::enable_if_t<!detail::IsInplaceFunction<std::decay_t<F>>::value>>
+	InplaceFunction& operator=(F&& function) {
+		return *this = InplaceFunction(std::forward<F>(function));
+	}
+
+	R operator()(Args... args) const {
+		assert(m_pInvoke && "Calling an empty InplaceFunction");
+		return m_pInvoke(const_cast<std::byte*>(m_Storage), std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const {
+		return m_pInvoke != nullptr;
+	}
+
+	void swap(InplaceFunction& other) noexcept {
+		InplaceFunction temp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(temp);
+	}
+
+	friend bool operator==(const InplaceFunction& function, std::nullptr_t) {
+		return !function;
+	}
+
+private:
+	enum class Operation {
+		Move,
+		Destroy,
+	};
+
+	using InvokeFn = R(*)(void*, Args&&...);
+	using ManageFn = void(*)(Operation, void* pThis, void* pOther);
+
+	template<typename Callable>
+	static R Invoke(void* pStorage, Args&&... args) {
+		if constexpr (std::is_void_v<R>)
+			std::invoke(*static_cast<Callable*>(pStorage), std::forward<Args>(args)...);
+		else
+			return std::invoke(*static_cast<Callable*>(pStorage), std::forward<Args>(args)...);
+	}
+
+	template<typename Callable>
+	static void Manage(Operation operation, void* pThis, void* pOther) {
+		switch (operation) {
+		case Operation::Move: {
+			Callable* pOtherCallable = static_cast<Callable*>(pOther);
+
+			new (pThis) Callable(std::move(*pOtherCallable));
+			pOtherCallable->~Callable();
+			break;
+		}
+		case Operation::Destroy:
+			static_cast<Callable*>(pThis)->~Callable();
+			break;
+		}
+	}
+
+	// Leaves other empty.
+	void MoveFrom(InplaceFunction& other) {
+		if (!other.m_pInvoke)
+			return;
+
+		if (other.m_pManage)
+			other.m_pManage(Operation::Move, m_Storage, other.m_Storage);
+		else
+			std::memcpy(m_Storage, other.m_Storage, Capacity);
+
+		m_pInvoke = other.m_pInvoke;
+		m_pManage = other.m_pManage;
+		other.m_pInvoke = nullptr;
+		other.m_pManage = nullptr;
+	}
+
+	void Destroy() {
+		if (m_pManage)
+			m_pManage(Operation::Destroy, m_Storage, nullptr);
+
+		m_pInvoke = nullptr;
+		m_pManage = nullptr;
+	}
+
+	alignas(std::max_align_t) std::byte m_Storage[Capacity];
+	InvokeFn m_pInvoke = nullptr;
+	// nullptr for trivially copyable callables.
+	ManageFn m_pManage = nullptr;
+};
+
+template<typename Signature, size_t Capacity>
+void swap(InplaceFunction<Signature, Capacity>& a, InplaceFunction<Signature, Capacity>& b) noexcept {
+	a.swap(b);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+namespace fe {
+
+template<typename T, typename Tag>
+class IntrusiveList;
+
+// Derive from this to put T into an IntrusiveList<T, Tag>. The links live
+//	in the element itself, so adding and removing never allocates.
+//	Use one hook per Tag for each list an element can be in at the same time.
+template<typename T, typename Tag = void>
+class IntrusiveListHook {
+	friend class IntrusiveList<T, Tag>;
+
+public:
+	IntrusiveListHook() = default;
+
+	// Copies start out unlinked, the links belong to the original.
+	IntrusiveListHook(const IntrusiveListHook&) {}
+	IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+
+	bool IsLinked() const {
+		return m_Linked;
+	}
+
+private:
+	T* m_pPrevious = nullptr;
+	T* m_pNext = nullptr;
+	bool m_Linked = false;
+};
+
+// Doubly linked list over elements deriving from IntrusiveListHook<T, Tag>.
+//	The list does not own its elements, an element has to be removed before
+//	it is destroyed.
+template<typename T, typename Tag = void>
+class IntrusiveList {
+public:
+	using Hook_t = IntrusiveListHook<T, Tag>;
+
+	IntrusiveList() {
+		m_pHead = nullptr;
+		m_pTail = nullptr;
+	}
+
+	IntrusiveList(const IntrusiveList&) = delete;
+	IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+	// The hooks only point at each other, so the elements can stay where
+	//	they are and only the ends change hands.
+	IntrusiveList(IntrusiveList&& other) noexcept {
+		m_pHead = other.m_pHead;
+		m_pTail = other.m_pTail;
+
+		other.m_pHead = nullptr;
+		other.m_pTail = nullptr;
+	}
+
+	IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+		if (this != &other) {
+			Clear();
+
+			m_pHead = other.m_pHead;
+			m_pTail = other.m_pTail;
+
+			other.m_pHead = nullptr;
+			other.m_pTail = nullptr;
+		}
+		return *this;
+	}
+
+	~IntrusiveList() {
+		Clear();
+	}
+
+	T* GetHead() const {
+		return m_pHead;
+	}
+
+	T* GetTail() const {
+		return m_pTail;
+	}
+
+	static T* GetNext(const T* pElement) {
+		return GetHook(pElement).m_pNext;
+	}
+
+	static T* GetPrevious(const T* pElement) {
+		return GetHook(pElement).m_pPrevious;
+	}
+
+	bool IsEmpty() const {
+		return m_pHead == nullptr;
+	}
+
+	// Unlinks every element without destroying it.
+	void Clear() {
+		while (m_pHead) {
+			T* pNext = GetHook(m_pHead).m_pNext;
+
+			Unlink(GetHook(m_pHead));
+			m_pHead = pNext;
+		}
+
+		m_pTail = nullptr;
+	}
+
+	// Elements are unlinked before they are deleted, so a destructor
+	//	that calls Remove on this list is fine.
+	void ClearAndDeleteElements() {
+		while (m_pHead) {
+			T* pElement = m_pHead;
+
+			Remove(pElement);
+			delete pElement;
+		}
+	}
+
+	void AddToHead(T* pElement) {
+		Hook_t& hook = GetHook(pElement);
+
+		hook.m_pPrevious = nullptr;
+		hook.m_pNext = m_pHead;
+		hook.m_Linked = true;
+
+		if (m_pHead) {
+			GetHook(m_pHead).m_pPrevious = pElement;
+		}
+		else {
+			m_pTail = pElement;
+		}
+
+		m_pHead = pElement;
+	}
+
+	void AddToTail(T* pElement) {
+		Hook_t& hook = GetHook(pElement);
+
+		hook.m_pPrevious = m_pTail;
+		hook.m_pNext = nullptr;
+		hook.m_Linked = true;
+
+		if (m_pTail) {
+			GetHook(m_pTail).m_pNext = pElement;
+		}
+		else {
+			m_pHead = pElement;
+		}
+
+		m_pTail = pElement;
+	}
+
+	// Calling this on an element that is in another list
+	//	will cause unidentified behavior. Unlinked elements are ignored.
+	void Remove(T* pElement) {
+		Hook_t& hook = GetHook(pElement);
+
+		if (!hook.m_Linked)
+			return;
+
+		if (hook.m_pNext) {
+			GetHook(hook.m_pNext).m_pPrevious = hook.m_pPrevious;
+		}
+		else {
+			m_pTail = hook.m_pPrevious;
+		}
+
+		if (hook.m_pPrevious) {
+			GetHook(hook.m_pPrevious).m_pNext = hook.m_pNext;
+		}
+		else {
+			m_pHead = hook.m_pNext;
+		}
+
+		Unlink(hook);
+	}
+
+private:
+	static Hook_t& GetHook(T* pElement) {
+		return static_cast<Hook_t&>(*pElement);
+	}
+
+	static const Hook_t& GetHook(const T* pElement) {
+		return static_cast<const Hook_t&>(*pElement);
+	}
+
+	static void Unlink(Hook_t& hook) {
+		hook.m_pPrevious = nullptr;
+		hook.m_pNext = nullptr;
+		hook.m_Linked = false;
+	}
+
+	T* m_pHead;
+	T* m_pTail;
+};
+
+}
\ No newline at end of file
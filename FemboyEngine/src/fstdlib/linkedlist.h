@@ -1,8 +1,11 @@
 #pragma once
 
+#include "blockpool.h"
+
 namespace fe {
 
-template<typename T>
+// Nodes come from the block pool under Tag, the elements are not.
+template<typename T, MemoryTag::Enum Tag = MemoryTag::General>
 class LinkedList {
 public:
 	struct Iterator_t {
@@ -32,7 +35,7 @@ public:
 		while (m_pHead) {
 			Iterator_t* pNextIter = m_pHead->pNext;
 
-			delete m_pHead;
+			PoolDelete(m_pHead);
 			m_pHead = pNextIter;
 		}
 
@@ -49,7 +52,7 @@ public:
 
 				// Remove was not called by the destructor of iterated element.
 				if (m_pHead->pNext) {
-					delete m_pHead;
+					PoolDelete(m_pHead);
 				}
 			}
 
@@ -63,7 +66,7 @@ public:
 	Iterator_t* AddToHead(T* pData) {
 		Iterator_t* pPreviousHead = m_pHead;
 
-		m_pHead = new Iterator_t();
+		m_pHead = PoolNew<Iterator_t>(Tag);
 		m_pHead->pData = pData;
 		m_pHead->pNext = nullptr;
 		m_pHead->pPrevious = nullptr;
@@ -83,7 +86,7 @@ public:
 	Iterator_t* AddToTail(T* pData) {
 		Iterator_t* pPreviousTail = m_pTail;
 
-		m_pTail = new Iterator_t();
+		m_pTail = PoolNew<Iterator_t>(Tag);
 		m_pTail->pData = pData;
 		m_pTail->pNext = nullptr;
 		m_pTail->pPrevious = nullptr;
@@ -123,7 +126,7 @@ public:
 			m_pTail = pPrevious;
 		}
 
-		delete pIterator;
+		PoolDelete(pIterator);
 	}
 
 private:
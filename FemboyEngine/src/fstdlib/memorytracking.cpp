@@ -0,0 +1,169 @@
+#include "memorytracking.h"
+#include "blockpool.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+
+namespace fe {
+
+struct TagCounters_t {
+	std::atomic<size_t> liveBytes;
+	std::atomic<size_t> peakBytes;
+	std::atomic<size_t> liveAllocations;
+	std::atomic<size_t> totalAllocations;
+
+	std::atomic<size_t> budgetBytes;
+	std::atomic<uint32_t> budgetAction;
+	// Set while over budget, so each overrun is reported once.
+	std::atomic<bool> overBudget;
+};
+
+// Constant initialized, so types registered during static initialization
+//	can already allocate.
+static TagCounters_t tagCounters[MemoryTag::Count];
+
+static const char* tagNames[MemoryTag::Count] = {
+	"General",
+	"Render",
+	"Scene",
+	"TypeInfo",
+	"Assets",
+	"Arena",
+	"Strings",
+};
+
+static void OnOverBudget(MemoryTag::Enum tag, size_t liveBytes, size_t budgetBytes, uint32_t action) {
+	printf("Memory tag %s is over budget: %zu of %zu bytes\n", tagNames[tag], liveBytes, budgetBytes);
+
+	if (action == MemoryBudgetAction::Assert) {
+		assert(!"Memory budget exceeded");
+	}
+}
+
+void TrackAllocation(MemoryTag::Enum tag, size_t size) {
+	assert(tag < MemoryTag::Count);
+
+	TagCounters_t& counters = tagCounters[tag];
+
+	size_t liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	size_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	while (liveBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {}
+
+	size_t budgetBytes = counters.budgetBytes.load(std::memory_order_relaxed);
+	if (budgetBytes && liveBytes > budgetBytes && !counters.overBudget.exchange(true, std::memory_order_relaxed)) {
+		OnOverBudget(tag, liveBytes, budgetBytes, counters.budgetAction.load(std::memory_order_relaxed));
+	}
+}
+
+void TrackFree(MemoryTag::Enum tag, size_t size) {
+	assert(tag < MemoryTag::Count);
+
+	TagCounters_t& counters = tagCounters[tag];
+
+	size_t liveBytes = counters.liveBytes.fetch_sub(size, std::memory_order_relaxed) - size;
+	counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+	if (counters.overBudget.load(std::memory_order_relaxed) && liveBytes <= counters.budgetBytes.load(std::memory_order_relaxed)) {
+		counters.overBudget.store(false, std::memory_order_relaxed);
+	}
+}
+
+// ===============================================
+// Allocation
+// ===============================================
+void* TaggedAllocate(MemoryTag::Enum tag, size_t size, size_t alignment) {
+	assert(tag < MemoryTag::Count);
+
+	void* p = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+		? ::operator new(size, std::align_val_t(alignment))
+		: ::operator new(size);
+
+	TrackAllocation(tag, size);
+
+	return p;
+}
+
+void TaggedFree(MemoryTag::Enum tag, void* p, size_t size, size_t alignment) {
+	assert(tag < MemoryTag::Count);
+
+	if (!p)
+		return;
+
+	TrackFree(tag, size);
+
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		::operator delete(p, std::align_val_t(alignment));
+	else
+		::operator delete(p);
+}
+
+void* TaggedAllocateObject(MemoryTag::Enum tag, size_t size) {
+	if (size <= PoolMaxBlockSize)
+		return PoolAllocate(tag, size);
+
+	return TaggedAllocate(tag, size);
+}
+
+void TaggedFreeObject(MemoryTag::Enum tag, void* p, size_t size) {
+	if (size <= PoolMaxBlockSize)
+		PoolFree(p);
+	else
+		TaggedFree(tag, p, size);
+}
+
+// ===============================================
+// Stats
+// ===============================================
+const char* GetMemoryTagName(MemoryTag::Enum tag) {
+	return tag < MemoryTag::Count ? tagNames[tag] : "Unknown";
+}
+
+MemoryStats_t GetMemoryStats(MemoryTag::Enum tag) {
+	const TagCounters_t& counters = tagCounters[tag];
+
+	MemoryStats_t stats;
+	stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+	stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+	stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+	stats.budgetBytes = counters.budgetBytes.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+void SetMemoryBudget(MemoryTag::Enum tag, size_t bytes, MemoryBudgetAction::Enum action) {
+	TagCounters_t& counters = tagCounters[tag];
+
+	counters.budgetAction.store(action, std::memory_order_relaxed);
+	counters.budgetBytes.store(bytes, std::memory_order_relaxed);
+	counters.overBudget.store(false, std::memory_order_relaxed);
+}
+
+void DumpMemoryStats() {
+	printf("%-10s %14s %14s %12s %12s %14s\n", "Tag", "Live bytes", "Peak bytes", "Live allocs", "Total allocs", "Budget");
+
+	for (uint32_t i = 0; i < MemoryTag::Count; i++) {
+		MemoryStats_t stats = GetMemoryStats(static_cast<MemoryTag::Enum>(i));
+
+		printf("%-10s %14zu %14zu %12zu %12zu ", tagNames[i], stats.liveBytes, stats.peakBytes, stats.liveAllocations, stats.totalAllocations);
+
+		if (stats.budgetBytes)
+			printf("%14zu%s\n", stats.budgetBytes, stats.liveBytes > stats.budgetBytes ? " (over)" : "");
+		else
+			printf("%14s\n", "-");
+	}
+
+	// Not part of any tag, the tags only count the blocks in use.
+	PoolStats_t pool = GetPoolStats();
+
+	size_t overheadBytes = pool.pageBytes > pool.blockBytes ? pool.pageBytes - pool.blockBytes : 0;
+
+	printf("Block pool: %zu pages, %zu bytes, %zu in blocks used or cached by threads, %zu overhead\n",
+		pool.numPages, pool.pageBytes, pool.blockBytes, overheadBytes);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace fe {
+
+// Who an allocation belongs to. Every tag counts its live and peak bytes
+//	and allocations, which DumpMemoryStats prints.
+struct MemoryTag {
+	enum Enum : uint32_t {
+		General,
+		Render,
+		Scene,
+		TypeInfo,
+		Assets,
+		Arena,
+		Strings,
+		Count
+	};
+};
+
+struct MemoryBudgetAction {
+	enum Enum : uint32_t {
+		Log,
+		Assert
+	};
+};
+
+struct MemoryStats_t {
+	size_t liveBytes;
+	size_t peakBytes;
+	size_t liveAllocations;
+	size_t totalAllocations;
+	// 0 when the tag has no budget.
+	size_t budgetBytes;
+};
+
+const char* GetMemoryTagName(MemoryTag::Enum tag);
+
+// The counters are updated with relaxed atomics, so a snapshot taken while
+//	other threads allocate may be slightly off.
+MemoryStats_t GetMemoryStats(MemoryTag::Enum tag);
+
+// Logs, or asserts, the first time the tag's live bytes go over budget.
+//	It can trigger again after going back under. 0 removes the budget.
+void SetMemoryBudget(MemoryTag::Enum tag, size_t bytes, MemoryBudgetAction::Enum action = MemoryBudgetAction::Log);
+
+// Prints the stats of every tag, for the F8 debug key.
+void DumpMemoryStats();
+
+// Frees must pass the same tag, size and alignment as the allocation, the
+//	size isn't stored anywhere. Never returns nullptr.
+void* TaggedAllocate(MemoryTag::Enum tag, size_t size, size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+void TaggedFree(MemoryTag::Enum tag, void* p, size_t size, size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+// Count memory that an allocator hands out from its own, untracked memory,
+//	like the blocks of the block pool. Same counters and budget checks as
+//	TaggedAllocate and TaggedFree.
+void TrackAllocation(MemoryTag::Enum tag, size_t size);
+void TrackFree(MemoryTag::Enum tag, size_t size);
+
+// new and delete for types without a virtual destructor. Classes that are
+//	deleted through a base pointer use FE_MEMORY_TAG instead.
+template<typename T, typename... Args>
+T* TaggedNew(MemoryTag::Enum tag, Args&&... args) {
+	void* p = TaggedAllocate(tag, sizeof(T), alignof(T));
+
+	return new (p) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void TaggedDelete(MemoryTag::Enum tag, T* p) {
+	if (p) {
+		p->~T();
+		TaggedFree(tag, p, sizeof(T), alignof(T));
+	}
+}
+
+// STL allocator that counts against Tag.
+template<typename T, MemoryTag::Enum Tag>
+class TaggedAllocator {
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind {
+		using other = TaggedAllocator<U, Tag>;
+	};
+
+	TaggedAllocator() = default;
+
+	template<typename U>
+	TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+	T* allocate(size_t count) {
+		return static_cast<T*>(TaggedAllocate(Tag, sizeof(T) * count, alignof(T)));
+	}
+
+	void deallocate(T* p, size_t count) {
+		TaggedFree(Tag, p, sizeof(T) * count, alignof(T));
+	}
+
+	template<typename U>
+	bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+};
+
+// new and delete of FE_MEMORY_TAG classes. Objects up to PoolMaxBlockSize
+//	come from the block pool in blockpool.h, which charges the tag one
+//	allocation of the block size per object. Larger ones go through
+//	TaggedAllocate.
+void* TaggedAllocateObject(MemoryTag::Enum tag, size_t size);
+void TaggedFreeObject(MemoryTag::Enum tag, void* p, size_t size);
+
+// Routes new and delete of a class, and everything derived from it, through
+//	the tag. The sized delete gets the size of the most derived type as long
+//	as the destructor is virtual. Placement new is declared again because a
+//	class operator new hides the global one.
+#define FE_MEMORY_TAG(tag) \
+	static void* operator new(size_t size) { return ::fe::TaggedAllocateObject(tag, size); } \
+	static void* operator new(size_t size, std::align_val_t alignment) { return ::fe::TaggedAllocate(tag, size, static_cast<size_t>(alignment)); } \
+	static void* operator new(size_t, void* p) noexcept { return p; } \
+	static void operator delete(void* p, size_t size) { ::fe::TaggedFreeObject(tag, p, size); } \
+	static void operator delete(void* p, size_t size, std::align_val_t alignment) { ::fe::TaggedFree(tag, p, size, static_cast<size_t>(alignment)); } \
+	static void operator delete(void*, void*) noexcept {}
+
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "threading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace fe {
+
+// Bounded queue for any number of producer and consumer threads, after
+//	Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence number
+//	that says whose turn it is: a producer may fill the cell at position
+//	pos when its sequence is pos, a consumer may empty it when it is pos + 1.
+//	Claiming a position is one compare and swap on the shared index, after
+//	that the cell belongs to the thread. Lock-free, not wait-free: a thread
+//	that stalls between claiming a cell and publishing it holds up the
+//	threads that wrap around to that cell.
+template<typename T>
+class MpmcQueue {
+public:
+	using value_type = T;
+
+	// capacity is rounded up to a power of two.
+	explicit MpmcQueue(size_t capacity) {
+		m_Capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+		m_Mask = m_Capacity - 1;
+		m_pCells = static_cast<Cell_t*>(::operator new(sizeof(Cell_t) * m_Capacity, std::align_val_t(alignof(Cell_t))));
+
+		for (size_t i = 0; i < m_Capacity; i++) {
+			new (&m_pCells[i].sequence) std::atomic<size_t>(i);
+		}
+	}
+
+	~MpmcQueue() {
+		size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+		size_t end = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+		for (; position != end; position++) {
+			m_pCells[position & m_Mask].GetValue()->~T();
+		}
+
+		for (size_t i = 0; i < m_Capacity; i++) {
+			m_pCells[i].sequence.~atomic();
+		}
+
+		::operator delete(m_pCells, std::align_val_t(alignof(Cell_t)));
+	}
+
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+	// ===============================================
+	// Producers
+	// ===============================================
+	// Returns false when the queue is full, args are left untouched then.
+	template<typename... Args>
+	bool TryEmplace(Args&&... args) {
+		size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		Cell_t* pCell;
+
+		for (;;) {
+			pCell = &m_pCells[position & m_Mask];
+
+			size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - position);
+
+			if (difference == 0) {
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			// The cell still holds the value from one lap ago.
+			else if (difference < 0) {
+				return false;
+			}
+			else {
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (pCell->GetValue()) T(std::forward<Args>(args)...);
+		pCell->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool TryPush(const T& value) { return TryEmplace(value); }
+	bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+
+	// Claims as many consecutive cells as are free, up to count, with one
+	//	compare and swap and moves the values in. Returns how many were
+	//	pushed, they stay in order relative to each other.
+	size_t TryPushBatch(T* pValues, size_t count) {
+		if (count == 0)
+			return 0;
+
+		size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		size_t claimed;
+
+		for (;;) {
+			claimed = 0;
+
+			while (claimed < count && claimed < m_Capacity) {
+				size_t sequence = m_pCells[(position + claimed) & m_Mask].sequence.load(std::memory_order_acquire);
+
+				if (sequence != position + claimed)
+					break;
+
+				claimed++;
+			}
+
+			if (claimed == 0) {
+				size_t sequence = m_pCells[position & m_Mask].sequence.load(std::memory_order_relaxed);
+
+				// Full, or another producer took the position.
+				if (static_cast<ptrdiff_t>(sequence - position) < 0)
+					return 0;
+
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			if (m_EnqueuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+				break;
+		}
+
+		for (size_t i = 0; i < claimed; i++) {
+			Cell_t& cell = m_pCells[(position + i) & m_Mask];
+
+			new (cell.GetValue()) T(std::move(pValues[i]));
+			cell.sequence.store(position + i + 1, std::memory_order_release);
+		}
+
+		return claimed;
+	}
+
+	// ===============================================
+	// Consumers
+	// ===============================================
+	// Returns false when the queue is empty.
+	bool TryPop(T& value) {
+		size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+		Cell_t* pCell;
+
+		for (;;) {
+			pCell = &m_pCells[position & m_Mask];
+
+			size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - (position + 1));
+
+			if (difference == 0) {
+				if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			// Nothing was pushed at this position yet.
+			else if (difference < 0) {
+				return false;
+			}
+			else {
+				position = m_DequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		ReleaseCell(*pCell, position, value);
+
+		return true;
+	}
+
+	// Claims up to maxCount consecutive filled cells with one compare and
+	//	swap and moves them into pValues. Returns how many were popped.
+	size_t TryPopBatch(T* pValues, size_t maxCount) {
+		if (maxCount == 0)
+			return 0;
+
+		size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+		size_t claimed;
+
+		for (;;) {
+			claimed = 0;
+
+			while (claimed < maxCount && claimed < m_Capacity) {
+				size_t sequence = m_pCells[(position + claimed) & m_Mask].sequence.load(std::memory_order_acquire);
+
+				if (sequence != position + claimed + 1)
+					break;
+
+				claimed++;
+			}
+
+			if (claimed == 0) {
+				size_t sequence = m_pCells[position & m_Mask].sequence.load(std::memory_order_relaxed);
+
+				if (static_cast<ptrdiff_t>(sequence - (position + 1)) < 0)
+					return 0;
+
+				position = m_DequeuePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			if (m_DequeuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+				break;
+		}
+
+		for (size_t i = 0; i < claimed; i++) {
+			ReleaseCell(m_pCells[(position + i) & m_Mask], position + i, pValues[i]);
+		}
+
+		return claimed;
+	}
+
+	// ===============================================
+	// Any thread
+	// ===============================================
+	// Only a snapshot while other threads are running, counts values that
+	//	are still being pushed.
+	size_t GetSizeApprox() const {
+		size_t dequeue = m_DequeuePosition.load(std::memory_order_acquire);
+		size_t enqueue = m_EnqueuePosition.load(std::memory_order_acquire);
+
+		return enqueue > dequeue ? enqueue - dequeue : 0;
+	}
+
+	bool IsEmptyApprox() const { return GetSizeApprox() == 0; }
+	size_t GetCapacity() const { return m_Capacity; }
+
+private:
+	struct Cell_t {
+		std::atomic<size_t> sequence;
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* GetValue() { return reinterpret_cast<T*>(storage); }
+	};
+
+	// Moves the value out and hands the cell to the producer of the next lap.
+	void ReleaseCell(Cell_t& cell, size_t position, T& value) {
+		T* pValue = cell.GetValue();
+
+		value = std::move(*pValue);
+		pValue->~T();
+
+		cell.sequence.store(position + m_Mask + 1, std::memory_order_release);
+	}
+
+	// Read only after construction.
+	Cell_t* m_pCells;
+	size_t m_Capacity;
+	size_t m_Mask;
+
+	alignas(CacheLineSize) std::atomic<size_t> m_EnqueuePosition = 0;
+	alignas(CacheLineSize) std::atomic<size_t> m_DequeuePosition = 0;
+};
+
+}
\ No newline at end of file
@@ -1,13 +1,147 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace fe {
 
+template<typename T, typename Deleter = std::default_delete<T>>
+using ScopedPtr = std::unique_ptr<T, Deleter>;
+
+// ===============================================
+// Reference counting
+// ===============================================
+// Base for types shared through RefPtr, T is the type deriving from it.
+//	The count lives in the object, so there is no separate control block to
+//	allocate and a RefPtr is a single pointer. The last Release deletes the
+//	object as a T, which goes through T's class operator delete if it has
+//	one.
+//
+//	Non-atomic counts are for objects that only one thread references at a
+//	time, or that are only shared during startup. Use AtomicRefCounted when
+//	RefPtrs to the same object are copied on several threads.
+template<typename T, bool Atomic = false>
+class RefCounted {
+public:
+	void AddRef() const {
+		if constexpr (Atomic)
+			m_RefCount.fetch_add(1, std::memory_order_relaxed);
+		else
+			m_RefCount++;
+	}
+
+	void Release() const {
+		bool isLast;
+
+		// acq_rel so the deleting thread sees every other thread's writes.
+		if constexpr (Atomic)
+			isLast = m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		else
+			isLast = --m_RefCount == 0;
+
+		if (isLast)
+			delete static_cast<const T*>(this);
+	}
+
+	uint32_t GetRefCount() const {
+		if constexpr (Atomic)
+			return m_RefCount.load(std::memory_order_relaxed);
+		else
+			return m_RefCount;
+	}
+
+protected:
+	RefCounted() = default;
+
+	// A copy is a new object, nothing references it yet.
+	RefCounted(const RefCounted&) {}
+	RefCounted& operator=(const RefCounted&) { return *this; }
+
+	~RefCounted() = default;
+
+private:
+	mutable std::conditional_t<Atomic, std::atomic<uint32_t>, uint32_t> m_RefCount = 0;
+};
+
 template<typename T>
-using ScopedPtr = std::unique_ptr<T>;
+using AtomicRefCounted = RefCounted<T, true>;
 
+// Shared pointer to a RefCounted object. Since the count is in the object,
+//	a RefPtr can be made from any raw pointer to it, not only from another
+//	RefPtr.
 template<typename T>
-using RefPtr = std::shared_ptr<T>;
+class RefPtr {
+public:
+	using element_type = T;
+
+	RefPtr() = default;
+	RefPtr(std::nullptr_t) {}
+
+	// Adds a reference, a freshly allocated object starts at 0.
+	explicit RefPtr(T* pObject)
+		: m_pObject(pObject) {
+		if (m_pObject)
+			m_pObject->AddRef();
+	}
+
+	RefPtr(const RefPtr& other)
+		: RefPtr(other.m_pObject) {}
+
+	RefPtr(RefPtr&& other) noexcept
+		: m_pObject(std::exchange(other.m_pObject, nullptr)) {}
+
+	template<typename U> requires std::is_convertible_v<U*, T*>
+	RefPtr(const RefPtr<U>& other)
+		: RefPtr(other.m_pObject) {}
+
+	template<typename U> requires std::is_convertible_v<U*, T*>
+	RefPtr(RefPtr<U>&& other) noexcept
+		: m_pObject(std::exchange(other.m_pObject, nullptr)) {}
+
+	~RefPtr() {
+		if (m_pObject)
+			m_pObject->Release();
+	}
+
+	// Takes other by value, so copies, moves and self assignment all work.
+	RefPtr& operator=(RefPtr other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	void reset(T* pObject = nullptr) {
+		RefPtr(pObject).swap(*this);
+	}
+
+	void swap(RefPtr& other) noexcept {
+		std::swap(m_pObject, other.m_pObject);
+	}
+
+	T* get() const { return m_pObject; }
+	T& operator*() const { return *m_pObject; }
+	T* operator->() const { return m_pObject; }
+	explicit operator bool() const { return m_pObject != nullptr; }
+
+	template<typename U>
+	bool operator==(const RefPtr<U>& other) const { return m_pObject == other.get(); }
+	bool operator==(std::nullptr_t) const { return m_pObject == nullptr; }
+
+private:
+	template<typename U>
+	friend class RefPtr;
+
+	T* m_pObject = nullptr;
+};
+
+// The RefPtr counterpart of std::make_shared. The object and its count are
+//	one allocation either way, this only saves spelling out the type twice.
+template<typename T, typename... Args>
+RefPtr<T> MakeRef(Args&&... args) {
+	return RefPtr<T>(new T(std::forward<Args>(args)...));
+}
 
 }
\ No newline at end of file
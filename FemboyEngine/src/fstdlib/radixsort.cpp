@@ -0,0 +1,348 @@
+#include "radixsort.h"
+
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cassert>
+#include <thread>
+
+namespace fe {
+
+// Wide digits take fewer passes, but every pass clears and sums a histogram
+//	of 2048 counts. Below SmallSortCount elements 8 bit digits win.
+constexpr uint32_t SmallDigitBits = 8;
+constexpr uint32_t LargeDigitBits = 11;
+constexpr size_t SmallSortCount = 16 * 1024;
+
+// Below this clearing even the small histograms costs more than an
+//	insertion sort.
+constexpr size_t InsertionSortCount = 64;
+
+// Fewer elements per thread than this sort faster on fewer threads, the
+//	barriers and thread starts cost more than they save.
+constexpr size_t MinCountPerThread = 64 * 1024;
+
+template<uint32_t DigitBits>
+constexpr uint32_t Radix = 1u << DigitBits;
+
+template<typename Key, uint32_t DigitBits>
+constexpr uint32_t NumDigits = (sizeof(Key) * 8 + DigitBits - 1) / DigitBits;
+
+template<uint32_t DigitBits, typename Key>
+static uint32_t GetDigit(Key key, uint32_t digit) {
+	return static_cast<uint32_t>(key >> (digit * DigitBits)) & (Radix<DigitBits> - 1);
+}
+
+// Negative floats get all bits flipped and positive ones only the sign bit,
+//	after which they order like unsigned integers.
+static uint32_t FloatToKey(float value) {
+	uint32_t bits = std::bit_cast<uint32_t>(value);
+	uint32_t mask = static_cast<uint32_t>(-static_cast<int32_t>(bits >> 31)) | 0x80000000u;
+
+	return bits ^ mask;
+}
+
+static float KeyToFloat(uint32_t key) {
+	uint32_t mask = ((key >> 31) - 1) | 0x80000000u;
+
+	return std::bit_cast<float>(key ^ mask);
+}
+
+template<typename Key>
+static void InsertionSort(Key* pKeys, uint32_t* pValues, size_t count) {
+	for (size_t i = 1; i < count; i++) {
+		Key key = pKeys[i];
+		uint32_t value = pValues ? pValues[i] : 0;
+		size_t j = i;
+
+		for (; j > 0 && pKeys[j - 1] > key; j--) {
+			pKeys[j] = pKeys[j - 1];
+
+			if (pValues)
+				pValues[j] = pValues[j - 1];
+		}
+
+		pKeys[j] = key;
+
+		if (pValues)
+			pValues[j] = value;
+	}
+}
+
+// Moves elements [begin, end) to their digit's next offset.
+template<uint32_t DigitBits, typename Key>
+static void Scatter(const Key* pSrcKeys, const uint32_t* pSrcValues, Key* pDstKeys, uint32_t* pDstValues,
+	size_t begin, size_t end, uint32_t digit, uint32_t* pOffsets)
+{
+	if (pSrcValues) {
+		for (size_t i = begin; i < end; i++) {
+			Key key = pSrcKeys[i];
+			uint32_t offset = pOffsets[GetDigit<DigitBits>(key, digit)]++;
+
+			pDstKeys[offset] = key;
+			pDstValues[offset] = pSrcValues[i];
+		}
+	}
+	else {
+		for (size_t i = begin; i < end; i++) {
+			Key key = pSrcKeys[i];
+
+			pDstKeys[pOffsets[GetDigit<DigitBits>(key, digit)]++] = key;
+		}
+	}
+}
+
+// Turns counts into offsets. A digit that every key has needs no pass.
+template<uint32_t DigitBits>
+static bool PrefixSum(uint32_t* pCounts, size_t count) {
+	uint32_t sum = 0;
+
+	for (uint32_t i = 0; i < Radix<DigitBits>; i++) {
+		if (pCounts[i] == count)
+			return false;
+
+		uint32_t digitCount = pCounts[i];
+		pCounts[i] = sum;
+		sum += digitCount;
+	}
+
+	return true;
+}
+
+// ===============================================
+// Single thread
+// ===============================================
+// Counts every digit in one read, then does the passes that are needed.
+//	Returns true when the result ended up in the temporaries.
+template<uint32_t DigitBits, typename Key>
+static bool SortSingleThreaded(Key* pKeys, uint32_t* pValues, size_t count, Key* pTempKeys, uint32_t* pTempValues, uint32_t* pHistograms) {
+	constexpr uint32_t numDigits = NumDigits<Key, DigitBits>;
+	constexpr uint32_t radix = Radix<DigitBits>;
+
+	std::fill_n(pHistograms, numDigits * radix, 0u);
+
+	for (size_t i = 0; i < count; i++) {
+		Key key = pKeys[i];
+
+		for (uint32_t digit = 0; digit < numDigits; digit++) {
+			pHistograms[digit * radix + GetDigit<DigitBits>(key, digit)]++;
+		}
+	}
+
+	bool isInTemp = false;
+
+	for (uint32_t digit = 0; digit < numDigits; digit++) {
+		uint32_t* pOffsets = pHistograms + digit * radix;
+
+		if (!PrefixSum<DigitBits>(pOffsets, count))
+			continue;
+
+		Scatter<DigitBits>(pKeys, pValues, pTempKeys, pTempValues, 0, count, digit, pOffsets);
+
+		std::swap(pKeys, pTempKeys);
+		std::swap(pValues, pTempValues);
+		isInTemp = !isInTemp;
+	}
+
+	return isInTemp;
+}
+
+// ===============================================
+// Multiple threads
+// ===============================================
+// Each thread owns a fixed part of the array positions. Per pass it counts
+//	the digits in its part of the source, waits for the others, works out
+//	where its elements of each digit go, after the smaller digits and after
+//	the same digit from earlier parts, and scatters them. The counts are
+//	double buffered by pass, so a skipped pass needs no second barrier.
+template<uint32_t DigitBits, typename Key>
+static void SortMultiThreaded(Key* pKeys, uint32_t* pValues, size_t count, Key* pTempKeys, uint32_t* pTempValues,
+	uint32_t* pHistograms, uint32_t numThreads)
+{
+	constexpr uint32_t numDigits = NumDigits<Key, DigitBits>;
+	constexpr uint32_t radix = Radix<DigitBits>;
+
+	std::barrier sync(numThreads);
+
+	auto sortPart = [&](uint32_t thread) {
+		size_t begin = count * thread / numThreads;
+		size_t end = count * (thread + 1) / numThreads;
+
+		Key* pSrcKeys = pKeys;
+		uint32_t* pSrcValues = pValues;
+		Key* pDstKeys = pTempKeys;
+		uint32_t* pDstValues = pTempValues;
+
+		uint32_t offsets[radix];
+
+		for (uint32_t digit = 0; digit < numDigits; digit++) {
+			uint32_t* pCountsOfPass = pHistograms + (digit & 1) * numThreads * radix;
+			uint32_t* pCounts = pCountsOfPass + thread * radix;
+
+			std::fill_n(pCounts, radix, 0u);
+
+			for (size_t i = begin; i < end; i++) {
+				pCounts[GetDigit<DigitBits>(pSrcKeys[i], digit)]++;
+			}
+
+			sync.arrive_and_wait();
+
+			uint32_t sum = 0;
+			bool isSkipped = false;
+
+			for (uint32_t i = 0; i < radix && !isSkipped; i++) {
+				uint32_t digitStart = sum;
+
+				for (uint32_t t = 0; t < numThreads; t++) {
+					if (t == thread)
+						offsets[i] = sum;
+
+					sum += pCountsOfPass[t * radix + i];
+				}
+
+				isSkipped = sum - digitStart == count;
+			}
+
+			// Every thread comes to the same conclusion.
+			if (isSkipped)
+				continue;
+
+			Scatter<DigitBits>(pSrcKeys, pSrcValues, pDstKeys, pDstValues, begin, end, digit, offsets);
+
+			sync.arrive_and_wait();
+
+			std::swap(pSrcKeys, pDstKeys);
+			std::swap(pSrcValues, pDstValues);
+		}
+
+		if (pSrcKeys != pKeys) {
+			std::copy(pSrcKeys + begin, pSrcKeys + end, pKeys + begin);
+
+			if (pValues)
+				std::copy(pSrcValues + begin, pSrcValues + end, pValues + begin);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads - 1);
+
+	for (uint32_t t = 1; t < numThreads; t++) {
+		threads.emplace_back(sortPart, t);
+	}
+
+	sortPart(0);
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+// ===============================================
+// RadixSorter
+// ===============================================
+RadixSorter::RadixSorter(uint32_t numThreads) {
+	if (numThreads == 0)
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	m_NumThreads = numThreads;
+}
+
+uint32_t RadixSorter::GetNumThreadsFor(size_t count) const {
+	return static_cast<uint32_t>(std::clamp<size_t>(count / MinCountPerThread, 1, m_NumThreads));
+}
+
+template<typename Key>
+void RadixSorter::SortKeys(Key* pKeys, uint32_t* pValues, size_t count, Key* pTempKeys) {
+	assert(count <= UINT32_MAX);
+
+	if (count <= InsertionSortCount) {
+		InsertionSort(pKeys, pValues, count);
+		return;
+	}
+
+	uint32_t* pTempValues = nullptr;
+
+	if (pValues) {
+		if (m_TempValues.size() < count)
+			m_TempValues.resize(count);
+
+		pTempValues = m_TempValues.data();
+	}
+
+	uint32_t numThreads = GetNumThreadsFor(count);
+	size_t histogramSize = std::max<size_t>(NumDigits<Key, LargeDigitBits>, 2 * numThreads) * Radix<LargeDigitBits>;
+
+	if (m_Histograms.size() < histogramSize)
+		m_Histograms.resize(histogramSize);
+
+	bool isInTemp = false;
+
+	if (numThreads > 1)
+		SortMultiThreaded<LargeDigitBits>(pKeys, pValues, count, pTempKeys, pTempValues, m_Histograms.data(), numThreads);
+	else if (count < SmallSortCount)
+		isInTemp = SortSingleThreaded<SmallDigitBits>(pKeys, pValues, count, pTempKeys, pTempValues, m_Histograms.data());
+	else
+		isInTemp = SortSingleThreaded<LargeDigitBits>(pKeys, pValues, count, pTempKeys, pTempValues, m_Histograms.data());
+
+	if (isInTemp) {
+		std::copy(pTempKeys, pTempKeys + count, pKeys);
+
+		if (pValues)
+			std::copy(pTempValues, pTempValues + count, pValues);
+	}
+}
+
+void RadixSorter::Sort(uint32_t* pKeys, uint32_t* pValues, size_t count) {
+	if (m_TempKeys32.size() < count)
+		m_TempKeys32.resize(count);
+
+	SortKeys(pKeys, pValues, count, m_TempKeys32.data());
+}
+
+void RadixSorter::Sort(uint64_t* pKeys, uint32_t* pValues, size_t count) {
+	if (m_TempKeys64.size() < count)
+		m_TempKeys64.resize(count);
+
+	SortKeys(pKeys, pValues, count, m_TempKeys64.data());
+}
+
+void RadixSorter::Sort(float* pKeys, uint32_t* pValues, size_t count) {
+	if (m_TempKeys32.size() < count * 2)
+		m_TempKeys32.resize(count * 2);
+
+	uint32_t* pConverted = m_TempKeys32.data();
+
+	for (size_t i = 0; i < count; i++) {
+		pConverted[i] = FloatToKey(pKeys[i]);
+	}
+
+	SortKeys(pConverted, pValues, count, pConverted + count);
+
+	for (size_t i = 0; i < count; i++) {
+		pKeys[i] = KeyToFloat(pConverted[i]);
+	}
+}
+
+void RadixSorter::ReleaseMemory() {
+	m_TempKeys32 = {};
+	m_TempKeys64 = {};
+	m_TempValues = {};
+	m_Histograms = {};
+}
+
+// ===============================================
+// One-off sorts
+// ===============================================
+void RadixSort(uint32_t* pKeys, uint32_t* pValues, size_t count, uint32_t numThreads) {
+	RadixSorter(numThreads).Sort(pKeys, pValues, count);
+}
+
+void RadixSort(uint64_t* pKeys, uint32_t* pValues, size_t count, uint32_t numThreads) {
+	RadixSorter(numThreads).Sort(pKeys, pValues, count);
+}
+
+void RadixSort(float* pKeys, uint32_t* pValues, size_t count, uint32_t numThreads) {
+	RadixSorter(numThreads).Sort(pKeys, pValues, count);
+}
+
+}
\ No newline at end of file
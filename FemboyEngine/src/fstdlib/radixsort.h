@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// LSD radix sort over 11 bit digits, so 32 bit keys take 3 passes and 64
+//	bit keys 6, or 8 bit digits for small arrays, where clearing the larger
+//	histograms would dominate. Digits that are the same in every key are
+//	skipped, which makes keys with unused high bits, like draw keys or
+//	Morton codes, cheaper. The sort is stable. pValues, usually indices
+//	into the sorted objects, is permuted along with the keys and may be
+//	nullptr.
+//
+//	With more than one thread every thread counts and scatters its own
+//	contiguous part of the array, with a barrier between the passes. Arrays
+//	too small to be worth it use fewer threads, down to one.
+//
+//	The sorter keeps its scratch buffers, 2 keys and values per element, so
+//	sorting the same amount every frame doesn't allocate.
+class RadixSorter {
+public:
+	// 0 uses one thread per hardware thread.
+	explicit RadixSorter(uint32_t numThreads = 1);
+
+	void Sort(uint32_t* pKeys, uint32_t* pValues, size_t count);
+	void Sort(uint64_t* pKeys, uint32_t* pValues, size_t count);
+
+	// Sorts by value with -0 before +0. NaNs go to the end, or to the start
+	//	when their sign bit is set.
+	void Sort(float* pKeys, uint32_t* pValues, size_t count);
+
+	uint32_t GetNumThreads() const { return m_NumThreads; }
+
+	// The threads sorting count elements actually uses, at most GetNumThreads.
+	uint32_t GetNumThreadsFor(size_t count) const;
+
+	// Gives the scratch buffers back.
+	void ReleaseMemory();
+
+private:
+	template<typename Key>
+	void SortKeys(Key* pKeys, uint32_t* pValues, size_t count, Key* pTempKeys);
+
+	uint32_t m_NumThreads;
+
+	// Floats are sorted as converted copies, so this holds 2 keys per element
+	//	for them.
+	std::vector<uint32_t> m_TempKeys32;
+	std::vector<uint64_t> m_TempKeys64;
+	std::vector<uint32_t> m_TempValues;
+	std::vector<uint32_t> m_Histograms;
+};
+
+// One-off sorts with a temporary RadixSorter.
+void RadixSort(uint32_t* pKeys, uint32_t* pValues, size_t count, uint32_t numThreads = 1);
+void RadixSort(uint64_t* pKeys, uint32_t* pValues, size_t count, uint32_t numThreads = 1);
+void RadixSort(float* pKeys, uint32_t* pValues, size_t count, uint32_t numThreads = 1);
+
+}
\ No newline at end of file
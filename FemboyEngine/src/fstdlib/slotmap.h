@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fe {
+
+// Reference to an element of a SlotMap. The generation changes every time
+//	a slot is reused, so a handle to an erased element stays invalid instead
+//	of pointing at whatever took its place. Tag only keeps handles of
+//	different maps apart.
+template<typename Tag>
+struct SlotHandle_t {
+	uint32_t index = 0;
+	// Live slots never have generation 0, default handles are always invalid.
+	uint32_t generation = 0;
+
+	bool IsValid() const {
+		return generation != 0;
+	}
+
+	bool operator==(const SlotHandle_t& other) const = default;
+};
+
+// Values are kept packed in one array, so iterating is a linear walk.
+//	Insert, Erase and Get are O(1). Erase moves the last value into the hole,
+//	which invalidates pointers to values and changes the iteration order.
+template<typename T, typename Tag = T, typename Allocator = std::allocator<T>>
+class SlotMap {
+public:
+	using Handle_t = SlotHandle_t<Tag>;
+
+	template<typename... Args>
+	Handle_t Emplace(Args&&... args) {
+		uint32_t slotIndex;
+
+		if (m_FirstFree != InvalidIndex) {
+			slotIndex = m_FirstFree;
+			m_FirstFree = m_Slots[slotIndex].denseIndex;
+		}
+		else {
+			slotIndex = static_cast<uint32_t>(m_Slots.size());
+			m_Slots.push_back({ InvalidIndex, 1 });
+		}
+
+		m_Values.emplace_back(std::forward<Args>(args)...);
+		m_DenseToSlot.push_back(slotIndex);
+		m_Slots[slotIndex].denseIndex = static_cast<uint32_t>(m_Values.size() - 1);
+
+		return { slotIndex, m_Slots[slotIndex].generation };
+	}
+
+	Handle_t Insert(T&& value) {
+		return Emplace(std::move(value));
+	}
+
+	Handle_t Insert(const T& value) {
+		return Emplace(value);
+	}
+
+	// Returns false for stale handles. The value is destroyed after the map
+	//	is consistent again, so its destructor may use the map.
+	bool Erase(Handle_t handle) {
+		if (!Contains(handle))
+			return false;
+
+		Slot_t& slot = m_Slots[handle.index];
+		uint32_t denseIndex = slot.denseIndex;
+		uint32_t lastIndex = static_cast<uint32_t>(m_Values.size() - 1);
+
+		T removed = std::move(m_Values[denseIndex]);
+
+		if (denseIndex != lastIndex) {
+			m_Values[denseIndex] = std::move(m_Values[lastIndex]);
+			m_DenseToSlot[denseIndex] = m_DenseToSlot[lastIndex];
+			m_Slots[m_DenseToSlot[denseIndex]].denseIndex = denseIndex;
+		}
+
+		m_Values.pop_back();
+		m_DenseToSlot.pop_back();
+
+		slot.generation++;
+		if (slot.generation == 0) {
+			slot.generation = 1;
+		}
+
+		slot.denseIndex = m_FirstFree;
+		m_FirstFree = handle.index;
+
+		return true;
+	}
+
+	bool Contains(Handle_t handle) const {
+		return handle.index < m_Slots.size() && handle.generation != 0 && m_Slots[handle.index].generation == handle.generation;
+	}
+
+	// Returns nullptr for stale handles.
+	T* Get(Handle_t handle) {
+		return Contains(handle) ? &m_Values[m_Slots[handle.index].denseIndex] : nullptr;
+	}
+
+	const T* Get(Handle_t handle) const {
+		return Contains(handle) ? &m_Values[m_Slots[handle.index].denseIndex] : nullptr;
+	}
+
+	// Handle of the value at a position in the packed array.
+	Handle_t GetHandle(size_t denseIndex) const {
+		uint32_t slotIndex = m_DenseToSlot[denseIndex];
+
+		return { slotIndex, m_Slots[slotIndex].generation };
+	}
+
+	// Erases everything, all handles given out so far become invalid.
+	void Clear() {
+		while (!m_Values.empty()) {
+			Erase(GetHandle(m_Values.size() - 1));
+		}
+	}
+
+	void Reserve(size_t capacity) {
+		m_Values.reserve(capacity);
+		m_DenseToSlot.reserve(capacity);
+		m_Slots.reserve(capacity);
+	}
+
+	size_t Size() const {
+		return m_Values.size();
+	}
+
+	bool IsEmpty() const {
+		return m_Values.empty();
+	}
+
+	T* GetData() { return m_Values.data(); }
+	const T* GetData() const { return m_Values.data(); }
+
+	T* begin() { return m_Values.data(); }
+	T* end() { return m_Values.data() + m_Values.size(); }
+	const T* begin() const { return m_Values.data(); }
+	const T* end() const { return m_Values.data() + m_Values.size(); }
+
+private:
+	static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+	struct Slot_t {
+		// Position in m_Values, or the next free slot while unused.
+		uint32_t denseIndex;
+		uint32_t generation;
+	};
+
+	template<typename U>
+	using Vector_t = std::vector<U, typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+
+	Vector_t<T> m_Values;
+	Vector_t<uint32_t> m_DenseToSlot;
+	Vector_t<Slot_t> m_Slots;
+	uint32_t m_FirstFree = InvalidIndex;
+};
+
+}
\ No newline at end of file
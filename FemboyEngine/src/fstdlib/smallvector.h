@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace fe {
+
+// std::vector with room for N elements inside the object itself. Only
+//	going past N allocates, after which it behaves like a std::vector.
+//	Moving a SmallVector that still uses its inline storage moves the
+//	elements one by one, so pointers into it don't survive a move.
+template<typename T, size_t N>
+class SmallVector {
+	static_assert(N > 0, "Use std::vector without inline storage.");
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	SmallVector()
+		: m_pData(GetInline()), m_Size(0), m_Capacity(N) {}
+
+	explicit SmallVector(size_t count)
+		: SmallVector() {
+		resize(count);
+	}
+
+	SmallVector(size_t count, const T& value)
+		: SmallVector() {
+		resize(count, value);
+	}
+
+	template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	SmallVector(InputIt first, InputIt last)
+		: SmallVector() {
+		assign(first, last);
+	}
+
+	SmallVector(std::initializer_list<T> values)
+		: SmallVector(values.begin(), values.end()) {}
+
+	SmallVector(const SmallVector& other)
+		: SmallVector(other.begin(), other.end()) {}
+
+	SmallVector(SmallVector&& other) noexcept
+		: SmallVector() {
+		MoveFrom(std::move(other));
+	}
+
+	~SmallVector() {
+		clear();
+		FreeHeap();
+	}
+
+	SmallVector& operator=(const SmallVector& other) {
+		if (this != &other) {
+			assign(other.begin(), other.end());
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept {
+		if (this != &other) {
+			clear();
+			MoveFrom(std::move(other));
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(std::initializer_list<T> values) {
+		assign(values.begin(), values.end());
+		return *this;
+	}
+
+	template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	void assign(InputIt first, InputIt last) {
+		clear();
+		for (; first != last; ++first) {
+			emplace_back(*first);
+		}
+	}
+
+	// ===============================================
+	// Element access
+	// ===============================================
+	T& operator[](size_t index) { assert(index < m_Size); return m_pData[index]; }
+	const T& operator[](size_t index) const { assert(index < m_Size); return m_pData[index]; }
+
+	T& front() { return (*this)[0]; }
+	const T& front() const { return (*this)[0]; }
+	T& back() { return (*this)[m_Size - 1]; }
+	const T& back() const { return (*this)[m_Size - 1]; }
+
+	T* data() { return m_pData; }
+	const T* data() const { return m_pData; }
+
+	iterator begin() { return m_pData; }
+	iterator end() { return m_pData + m_Size; }
+	const_iterator begin() const { return m_pData; }
+	const_iterator end() const { return m_pData + m_Size; }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	// ===============================================
+	// Capacity
+	// ===============================================
+	bool empty() const { return m_Size == 0; }
+	size_t size() const { return m_Size; }
+	size_t capacity() const { return m_Capacity; }
+	static constexpr size_t inline_capacity() { return N; }
+
+	// True while the elements are in the inline storage.
+	bool is_inline() const { return m_pData == GetInline(); }
+
+	void reserve(size_t capacity) {
+		if (capacity > m_Capacity) {
+			Reallocate(capacity);
+		}
+	}
+
+	// Moves the elements back inline when they fit.
+	void shrink_to_fit() {
+		if (!is_inline() && m_Size <= N) {
+			T* pHeap = m_pData;
+
+			std::uninitialized_move(pHeap, pHeap + m_Size, GetInline());
+			std::destroy(pHeap, pHeap + m_Size);
+			Deallocate(pHeap);
+
+			m_pData = GetInline();
+			m_Capacity = N;
+		}
+		else if (m_Size < m_Capacity && !is_inline()) {
+			Reallocate(m_Size);
+		}
+	}
+
+	// ===============================================
+	// Modifiers
+	// ===============================================
+	void clear() {
+		std::destroy(m_pData, m_pData + m_Size);
+		m_Size = 0;
+	}
+
+	// args may refer to an element of this vector.
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		if (m_Size < m_Capacity) {
+			new (m_pData + m_Size) T(std::forward<Args>(args)...);
+		}
+		else {
+			// Build the new element before the old ones move out.
+			size_t newCapacity = GrowCapacity(m_Size + 1);
+			T* pNewData = Allocate(newCapacity);
+
+			new (pNewData + m_Size) T(std::forward<Args>(args)...);
+			Relocate(pNewData, newCapacity);
+		}
+
+		return m_pData[m_Size++];
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	void pop_back() {
+		assert(m_Size > 0);
+		m_pData[--m_Size].~T();
+	}
+
+	template<typename... Args>
+	iterator emplace(const_iterator position, Args&&... args) {
+		size_t index = position - begin();
+
+		emplace_back(std::forward<Args>(args)...);
+		std::rotate(begin() + index, end() - 1, end());
+
+		return begin() + index;
+	}
+
+	iterator insert(const_iterator position, const T& value) { return emplace(position, value); }
+	iterator insert(const_iterator position, T&& value) { return emplace(position, std::move(value)); }
+
+	iterator erase(const_iterator position) {
+		return erase(position, position + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		iterator pFirst = begin() + (first - begin());
+		iterator pLast = begin() + (last - begin());
+		iterator pNewEnd = std::move(pLast, end(), pFirst);
+
+		std::destroy(pNewEnd, end());
+		m_Size = pNewEnd - begin();
+
+		return pFirst;
+	}
+
+	void resize(size_t count) {
+		if (count < m_Size) {
+			std::destroy(m_pData + count, m_pData + m_Size);
+		}
+		else {
+			reserve(count);
+			std::uninitialized_value_construct(m_pData + m_Size, m_pData + count);
+		}
+		m_Size = count;
+	}
+
+	void resize(size_t count, const T& value) {
+		if (count < m_Size) {
+			std::destroy(m_pData + count, m_pData + m_Size);
+			m_Size = count;
+		}
+		else {
+			while (m_Size < count) {
+				emplace_back(value);
+			}
+		}
+	}
+
+	bool operator==(const SmallVector& other) const {
+		return std::equal(begin(), end(), other.begin(), other.end());
+	}
+
+private:
+	T* GetInline() { return reinterpret_cast<T*>(m_Inline); }
+	const T* GetInline() const { return reinterpret_cast<const T*>(m_Inline); }
+
+	static T* Allocate(size_t capacity) {
+		return static_cast<T*>(::operator new(sizeof(T) * capacity, std::align_val_t(alignof(T))));
+	}
+
+	static void Deallocate(T* p) {
+		::operator delete(p, std::align_val_t(alignof(T)));
+	}
+
+	void FreeHeap() {
+		if (!is_inline()) {
+			Deallocate(m_pData);
+		}
+	}
+
+	size_t GrowCapacity(size_t minCapacity) const {
+		return std::max(m_Capacity * 2, minCapacity);
+	}
+
+	// Moves the elements into pNewData, which becomes the storage.
+	void Relocate(T* pNewData, size_t newCapacity) {
+		std::uninitialized_move(m_pData, m_pData + m_Size, pNewData);
+		std::destroy(m_pData, m_pData + m_Size);
+		FreeHeap();
+
+		m_pData = pNewData;
+		m_Capacity = newCapacity;
+	}
+
+	void Reallocate(size_t newCapacity) {
+		Relocate(Allocate(newCapacity), newCapacity);
+	}
+
+	// Expects this to be empty.
+	void MoveFrom(SmallVector&& other) {
+		if (other.is_inline()) {
+			reserve(other.m_Size);
+			std::uninitialized_move(other.begin(), other.end(), m_pData);
+			m_Size = other.m_Size;
+			other.clear();
+		}
+		else {
+			FreeHeap();
+
+			m_pData = other.m_pData;
+			m_Size = other.m_Size;
+			m_Capacity = other.m_Capacity;
+
+			other.m_pData = other.GetInline();
+			other.m_Size = 0;
+			other.m_Capacity = N;
+		}
+	}
+
+	T* m_pData;
+	size_t m_Size;
+	size_t m_Capacity;
+	alignas(T) unsigned char m_Inline[sizeof(T) * N];
+};
+
+}
\ No newline at end of file
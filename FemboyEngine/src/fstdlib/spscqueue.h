@@ -0,0 +1,169 @@
+#pragma once
+
+#include "threading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace fe {
+
+// Bounded queue for exactly one producer thread and one consumer thread.
+//	Both sides are wait-free, a push or pop is a few loads and one release
+//	store. Each side keeps a copy of the other's index and only reads the
+//	shared one when the copy says the queue is full or empty, so the two
+//	threads rarely touch each other's cache lines.
+template<typename T>
+class SpscQueue {
+public:
+	using value_type = T;
+
+	// capacity is rounded up to a power of two.
+	explicit SpscQueue(size_t capacity) {
+		m_Capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+		m_Mask = m_Capacity - 1;
+		m_pSlots = static_cast<T*>(::operator new(sizeof(T) * m_Capacity, std::align_val_t(alignof(T))));
+	}
+
+	~SpscQueue() {
+		size_t head = m_Head.load(std::memory_order_relaxed);
+		size_t tail = m_Tail.load(std::memory_order_relaxed);
+
+		for (; head != tail; head++) {
+			m_pSlots[head & m_Mask].~T();
+		}
+
+		::operator delete(m_pSlots, std::align_val_t(alignof(T)));
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// ===============================================
+	// Producer
+	// ===============================================
+	// Returns false when the queue is full, args are left untouched then.
+	template<typename... Args>
+	bool TryEmplace(Args&&... args) {
+		size_t tail = m_Tail.load(std::memory_order_relaxed);
+
+		if (tail - m_CachedHead == m_Capacity) {
+			m_CachedHead = m_Head.load(std::memory_order_acquire);
+
+			if (tail - m_CachedHead == m_Capacity)
+				return false;
+		}
+
+		new (m_pSlots + (tail & m_Mask)) T(std::forward<Args>(args)...);
+		m_Tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool TryPush(const T& value) { return TryEmplace(value); }
+	bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+
+	// Moves as many of the count values as fit and publishes them at once.
+	//	Returns how many were pushed.
+	size_t TryPushBatch(T* pValues, size_t count) {
+		size_t tail = m_Tail.load(std::memory_order_relaxed);
+		size_t free = m_Capacity - (tail - m_CachedHead);
+
+		if (free < count) {
+			m_CachedHead = m_Head.load(std::memory_order_acquire);
+			free = m_Capacity - (tail - m_CachedHead);
+		}
+
+		count = std::min(count, free);
+
+		for (size_t i = 0; i < count; i++) {
+			new (m_pSlots + ((tail + i) & m_Mask)) T(std::move(pValues[i]));
+		}
+
+		if (count)
+			m_Tail.store(tail + count, std::memory_order_release);
+
+		return count;
+	}
+
+	// ===============================================
+	// Consumer
+	// ===============================================
+	// Returns false when the queue is empty.
+	bool TryPop(T& value) {
+		size_t head = m_Head.load(std::memory_order_relaxed);
+
+		if (head == m_CachedTail) {
+			m_CachedTail = m_Tail.load(std::memory_order_acquire);
+
+			if (head == m_CachedTail)
+				return false;
+		}
+
+		T* pSlot = m_pSlots + (head & m_Mask);
+		value = std::move(*pSlot);
+		pSlot->~T();
+
+		m_Head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Pops up to maxCount values into pValues and frees their slots at once.
+	//	Returns how many were popped.
+	size_t TryPopBatch(T* pValues, size_t maxCount) {
+		size_t head = m_Head.load(std::memory_order_relaxed);
+		size_t available = m_CachedTail - head;
+
+		if (available < maxCount) {
+			m_CachedTail = m_Tail.load(std::memory_order_acquire);
+			available = m_CachedTail - head;
+		}
+
+		size_t count = std::min(maxCount, available);
+
+		for (size_t i = 0; i < count; i++) {
+			T* pSlot = m_pSlots + ((head + i) & m_Mask);
+			pValues[i] = std::move(*pSlot);
+			pSlot->~T();
+		}
+
+		if (count)
+			m_Head.store(head + count, std::memory_order_release);
+
+		return count;
+	}
+
+	// ===============================================
+	// Either side
+	// ===============================================
+	// Only a snapshot while the other side is running.
+	size_t GetSizeApprox() const {
+		size_t head = m_Head.load(std::memory_order_acquire);
+		size_t tail = m_Tail.load(std::memory_order_acquire);
+
+		return tail - head;
+	}
+
+	bool IsEmptyApprox() const { return GetSizeApprox() == 0; }
+	size_t GetCapacity() const { return m_Capacity; }
+
+private:
+	// Read only after construction.
+	T* m_pSlots;
+	size_t m_Capacity;
+	size_t m_Mask;
+
+	// Consumer side.
+	alignas(CacheLineSize) std::atomic<size_t> m_Head = 0;
+	size_t m_CachedTail = 0;
+
+	// Producer side.
+	alignas(CacheLineSize) std::atomic<size_t> m_Tail = 0;
+	size_t m_CachedHead = 0;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "stringid.h"
+#include "flathashmap.h"
+#include "memorytracking.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace fe {
+
+constexpr size_t StringBlockSize = 16 * 1024;
+
+// Interned strings are never freed. They are packed into blocks, so
+//	GetString pointers stay valid and small strings cost no allocation.
+class StringTable {
+public:
+	~StringTable() {
+		for (const Block_t& block : m_Blocks) {
+			TaggedFree(MemoryTag::Strings, block.pMemory, block.size);
+		}
+	}
+
+	// The stored string, a null data pointer when hash isn't in the table.
+	std::string_view Find(uint32_t hash) const {
+		std::shared_lock lock(m_Mutex);
+
+		auto it = m_Strings.find(hash);
+		return it != m_Strings.end() ? it->second : std::string_view();
+	}
+
+	void Intern(uint32_t hash, std::string_view str) {
+		// Most strings are already in the table.
+		std::string_view existing = Find(hash);
+
+		if (!existing.data()) {
+			std::unique_lock lock(m_Mutex);
+
+			auto [it, inserted] = m_Strings.try_emplace(hash);
+			if (inserted) {
+				it->second = Store(str);
+			}
+
+			existing = it->second;
+		}
+
+		// Fatal in every build, otherwise the two strings would silently
+		//	compare equal everywhere. Compared with their lengths, strings
+		//	can contain null characters.
+		if (str != existing) {
+			printf("StringId hash collision: \"%.*s\" and \"%.*s\" both hash to 0x%08X\n",
+				static_cast<int>(str.size()), str.data(), static_cast<int>(existing.size()), existing.data(), hash);
+			fflush(stdout);
+			abort();
+		}
+	}
+
+private:
+	struct Block_t {
+		char* pMemory;
+		size_t size;
+	};
+
+	// Copies str with a terminator into the current block.
+	std::string_view Store(std::string_view str) {
+		size_t size = str.size() + 1;
+
+		if (size > m_BlockSpaceLeft) {
+			size_t blockSize = size > StringBlockSize ? size : StringBlockSize;
+			char* pBlock = static_cast<char*>(TaggedAllocate(MemoryTag::Strings, blockSize, 1));
+
+			m_Blocks.push_back({ pBlock, blockSize });
+			m_pBlockCursor = pBlock;
+			m_BlockSpaceLeft = blockSize;
+		}
+
+		char* pString = m_pBlockCursor;
+		memcpy(pString, str.data(), str.size());
+		pString[str.size()] = '\0';
+
+		m_pBlockCursor += size;
+		m_BlockSpaceLeft -= size;
+
+		return std::string_view(pString, str.size());
+	}
+
+	mutable std::shared_mutex m_Mutex;
+	FlatHashMap<uint32_t, std::string_view> m_Strings;
+
+	std::vector<Block_t> m_Blocks;
+	char* m_pBlockCursor = nullptr;
+	size_t m_BlockSpaceLeft = 0;
+};
+
+// Constructed on first use, type names are interned during static
+//	initialization.
+static StringTable& GetStringTable() {
+	static StringTable stringTable;
+
+	return stringTable;
+}
+
+StringId::StringId(std::string_view str) {
+	m_Hash = HashStringId(str);
+
+	if (!IsEmpty()) {
+		GetStringTable().Intern(m_Hash, str);
+	}
+}
+
+const char* StringId::GetString() const {
+	if (IsEmpty())
+		return "";
+
+	// Stored strings are null terminated.
+	std::string_view str = GetStringTable().Find(m_Hash);
+	return str.data() ? str.data() : "";
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace fe {
+
+// 32 bit FNV-1a, usable at compile time. Returns 0, the empty StringId,
+//	only for the empty string.
+constexpr uint32_t HashStringId(std::string_view str) {
+	if (str.empty())
+		return 0;
+
+	uint32_t hash = 0x811C9DC5u;
+
+	for (char c : str) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x01000193u;
+	}
+
+	return hash ? hash : 1u;
+}
+
+// A string reduced to its 32 bit hash. Comparing and hashing StringIds are
+//	integer operations and storing one takes 4 bytes. Constructing one from
+//	a string interns the string in a global, thread-safe table, so GetString
+//	can give it back later. Two different strings with the same hash are a
+//	fatal error in every build, interning the second one logs both and
+//	aborts.
+//
+//	"Name"_sid makes the same id at compile time without touching the table,
+//	for comparing against. Its GetString only works once the same string was
+//	interned somewhere else.
+class StringId {
+public:
+	constexpr StringId() = default;
+
+	// Interns str. Costs a hash and a table lookup under a shared lock, keep
+	//	the result instead of constructing it again. The empty string gives
+	//	the empty id and isn't interned.
+	explicit StringId(std::string_view str);
+
+	// An id from a hash computed by HashStringId, doesn't intern anything.
+	static constexpr StringId FromHash(uint32_t hash) {
+		StringId id;
+		id.m_Hash = hash;
+		return id;
+	}
+
+	constexpr uint32_t GetHash() const { return m_Hash; }
+	constexpr bool IsEmpty() const { return m_Hash == 0; }
+
+	// The interned string, "" for the empty id and for ids that were never
+	//	interned. Stays valid for the rest of the program.
+	const char* GetString() const;
+
+	constexpr bool operator==(const StringId& other) const = default;
+	constexpr bool operator<(const StringId& other) const { return m_Hash < other.m_Hash; }
+
+private:
+	uint32_t m_Hash = 0;
+};
+
+consteval StringId operator""_sid(const char* str, size_t length) {
+	return StringId::FromHash(HashStringId(std::string_view(str, length)));
+}
+
+}
+
+template<>
+struct std::hash<fe::StringId> {
+	size_t operator()(const fe::StringId& id) const noexcept {
+		return id.GetHash();
+	}
+};
\ No newline at end of file
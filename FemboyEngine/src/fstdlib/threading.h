@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace fe {
+
+// Atomics written by different threads are kept this far apart, so they
+//	don't share a cache line. std::hardware_destructive_interference_size
+//	would do, but GCC warns when it is used in a header.
+constexpr size_t CacheLineSize = 64;
+
+// Tells the CPU it is in a spin loop, which saves power and lets the other
+//	hyperthread run.
+inline void CpuRelax() {
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+	_mm_pause();
+#endif
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,679 @@
+#include "approxmath.h"
+#include "dispatch.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace fe::math {
+
+static ApproxMathMode::Enum approxMathMode = ApproxMathMode::Fast;
+
+void SetApproxMathMode(ApproxMathMode::Enum mode) {
+	approxMathMode = mode;
+}
+
+ApproxMathMode::Enum GetApproxMathMode() {
+	return approxMathMode;
+}
+
+// ===============================================
+// Scalar implementations
+// ===============================================
+// These are also the Precise mode, they just call libm.
+static void Sin_Scalar(const float* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = sinf(pIn[i]);
+	}
+}
+
+static void Cos_Scalar(const float* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = cosf(pIn[i]);
+	}
+}
+
+static void SinCos_Scalar(const float* pIn, size_t count, float* pOutSin, float* pOutCos) {
+	for (size_t i = 0; i < count; i++) {
+		float x = pIn[i];
+
+		pOutSin[i] = sinf(x);
+		pOutCos[i] = cosf(x);
+	}
+}
+
+static void Exp_Scalar(const float* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = expf(pIn[i]);
+	}
+}
+
+static void Log_Scalar(const float* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = logf(pIn[i]);
+	}
+}
+
+static void Atan2_Scalar(const float* pYs, const float* pXs, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = atan2f(pYs[i], pXs[i]);
+	}
+}
+
+static void Rsqrt_Scalar(const float* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = 1.f / sqrtf(pIn[i]);
+	}
+}
+
+static void Rcp_Scalar(const float* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = 1.f / pIn[i];
+	}
+}
+
+#if FE_SIMD_SSE
+// ===============================================
+// Polynomial constants
+// ===============================================
+// Coefficients are the single precision minimax fits from Cephes.
+
+// pi/2 split into three parts, the first ones have few enough mantissa bits
+//	that q * part is exact for the documented range.
+static constexpr float TwoOverPi = 0.636619772367581f;
+static constexpr float PiOver2A = 1.5703125f;
+static constexpr float PiOver2B = 4.837512969970703125e-4f;
+static constexpr float PiOver2C = 7.54978995489188216e-8f;
+
+// sin(r) = r + r^3 * (S0 + S1 r^2 + S2 r^4) on [-pi/4, pi/4]
+static constexpr float SinCoeff0 = -1.6666654611e-1f;
+static constexpr float SinCoeff1 = 8.3321608736e-3f;
+static constexpr float SinCoeff2 = -1.9515295891e-4f;
+
+// cos(r) = 1 - r^2 / 2 + r^4 * (C0 + C1 r^2 + C2 r^4) on [-pi/4, pi/4]
+static constexpr float CosCoeff0 = 4.166664568298827e-2f;
+static constexpr float CosCoeff1 = -1.388731625493765e-3f;
+static constexpr float CosCoeff2 = 2.443315711809948e-5f;
+
+static constexpr float ExpMax = 88.3762626647949f;
+static constexpr float ExpMin = -87.3365447505531f;
+static constexpr float Log2E = 1.44269504088896341f;
+static constexpr float Ln2A = 0.693359375f;
+static constexpr float Ln2B = -2.12194440e-4f;
+
+static constexpr float ExpCoeff[6] = {
+	1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+	4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f,
+};
+
+static constexpr float SqrtHalf = 0.707106781186547524f;
+
+static constexpr float LogCoeff[9] = {
+	7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f,
+	-1.2420140846e-1f, 1.4249322787e-1f, -1.6668057665e-1f,
+	2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f,
+};
+
+// atan(a) = a + a^3 * P(a^2) on [-tan(pi/8), tan(pi/8)]
+static constexpr float TanPiOver8 = 0.414213562373095f;
+static constexpr float AtanCoeff[4] = {
+	8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f,
+};
+
+static constexpr float PiOver4 = 0.785398163397448f;
+static constexpr float PiOver2 = 1.57079632679490f;
+static constexpr float PiF = 3.14159265358979f;
+
+// ===============================================
+// SSE implementations
+// ===============================================
+FE_FORCEINLINE __m128 Select_SSE(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+FE_FORCEINLINE __m128 Polynomial_SSE(__m128 x, const float* pCoeffs, int numCoeffs) {
+	__m128 result = _mm_set1_ps(pCoeffs[0]);
+
+	for (int i = 1; i < numCoeffs; i++) {
+		result = _mm_add_ps(_mm_mul_ps(result, x), _mm_set1_ps(pCoeffs[i]));
+	}
+
+	return result;
+}
+
+FE_FORCEINLINE void SinCos_SSE(__m128 x, __m128& s, __m128& c) {
+	__m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TwoOverPi)));
+	__m128 qf = _mm_cvtepi32_ps(q);
+
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(qf, _mm_set1_ps(PiOver2A)));
+	r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(PiOver2B)));
+	r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(PiOver2C)));
+
+	__m128 r2 = _mm_mul_ps(r, r);
+
+	__m128 sinR = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(SinCoeff2)), _mm_set1_ps(SinCoeff1));
+	sinR = _mm_add_ps(_mm_mul_ps(sinR, r2), _mm_set1_ps(SinCoeff0));
+	sinR = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinR, r2), r), r);
+
+	__m128 cosR = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(CosCoeff2)), _mm_set1_ps(CosCoeff1));
+	cosR = _mm_add_ps(_mm_mul_ps(cosR, r2), _mm_set1_ps(CosCoeff0));
+	cosR = _mm_mul_ps(_mm_mul_ps(cosR, r2), r2);
+	cosR = _mm_add_ps(_mm_sub_ps(cosR, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.f));
+
+	// Odd quadrants swap sin and cos, the sign follows bit 1 of the quadrant.
+	__m128i one = _mm_set1_epi32(1);
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+	__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), _mm_set1_epi32(2)), 30));
+
+	s = _mm_xor_ps(Select_SSE(swap, cosR, sinR), sinSign);
+	c = _mm_xor_ps(Select_SSE(swap, sinR, cosR), cosSign);
+}
+
+FE_FORCEINLINE __m128 Sin_SSE(__m128 x) {
+	__m128 s, c;
+	SinCos_SSE(x, s, c);
+
+	return s;
+}
+
+FE_FORCEINLINE __m128 Cos_SSE(__m128 x) {
+	__m128 s, c;
+	SinCos_SSE(x, s, c);
+
+	return c;
+}
+
+FE_FORCEINLINE __m128 Exp_SSE(__m128 x) {
+	__m128 overflow = _mm_cmpgt_ps(x, _mm_set1_ps(ExpMax));
+	__m128 underflow = _mm_cmplt_ps(x, _mm_set1_ps(ExpMin));
+	x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(ExpMin)), _mm_set1_ps(ExpMax));
+
+	__m128i n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(Log2E)));
+	__m128 nf = _mm_cvtepi32_ps(n);
+
+	// nf * Ln2A and the first subtraction are exact, the second one rounds.
+	//	Its error is kept in rLow and added back at the end.
+	__m128 r1 = _mm_sub_ps(x, _mm_mul_ps(nf, _mm_set1_ps(Ln2A)));
+	__m128 nLn2B = _mm_mul_ps(nf, _mm_set1_ps(Ln2B));
+	__m128 r = _mm_sub_ps(r1, nLn2B);
+	__m128 rLow = _mm_sub_ps(_mm_sub_ps(r1, r), nLn2B);
+
+	__m128 p = Polynomial_SSE(r, ExpCoeff, 6);
+	p = _mm_mul_ps(p, _mm_mul_ps(r, r));
+
+	// 1 + r as the rounded sum and its exact error, so the final add is the
+	//	only rounding on the order of 1 ulp.
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 sum = _mm_add_ps(one, r);
+	__m128 sumLow = _mm_add_ps(_mm_sub_ps(one, sum), r);
+	p = _mm_add_ps(sum, _mm_add_ps(_mm_add_ps(sumLow, rLow), p));
+
+	__m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+	__m128 result = _mm_mul_ps(p, scale);
+
+	result = _mm_andnot_ps(underflow, result);
+
+	return Select_SSE(overflow, _mm_set1_ps(HUGE_VALF), result);
+}
+
+FE_FORCEINLINE __m128 Log_SSE(__m128 x) {
+	__m128 negative = _mm_cmplt_ps(x, _mm_setzero_ps());
+	__m128 zero = _mm_cmpeq_ps(x, _mm_setzero_ps());
+
+	// Split into exponent and mantissa in [0.5, 1).
+	__m128i bits = _mm_castps_si128(x);
+	__m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+	__m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000)));
+
+	// Shift the mantissa to [sqrt(0.5), sqrt(2)) and subtract 1.
+	__m128 small = _mm_cmplt_ps(m, _mm_set1_ps(SqrtHalf));
+	e = _mm_sub_ps(e, _mm_and_ps(small, _mm_set1_ps(1.f)));
+	m = _mm_add_ps(_mm_sub_ps(m, _mm_set1_ps(1.f)), _mm_and_ps(small, m));
+
+	__m128 m2 = _mm_mul_ps(m, m);
+	__m128 y = _mm_mul_ps(_mm_mul_ps(Polynomial_SSE(m, LogCoeff, 9), m), m2);
+
+	y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(Ln2B)));
+	y = _mm_sub_ps(y, _mm_mul_ps(m2, _mm_set1_ps(0.5f)));
+
+	__m128 result = _mm_add_ps(_mm_add_ps(m, y), _mm_mul_ps(e, _mm_set1_ps(Ln2A)));
+
+	result = Select_SSE(zero, _mm_set1_ps(-HUGE_VALF), result);
+
+	return _mm_or_ps(result, negative); // All bits set is a NaN.
+}
+
+FE_FORCEINLINE __m128 Atan2_SSE(__m128 y, __m128 x) {
+	__m128 signMask = _mm_set1_ps(-0.f);
+	__m128 absY = _mm_andnot_ps(signMask, y);
+	__m128 absX = _mm_andnot_ps(signMask, x);
+
+	// atan of the smaller over the larger, then mirror around pi/4.
+	__m128 minXY = _mm_min_ps(absX, absY);
+	__m128 maxXY = _mm_max_ps(absX, absY);
+	__m128 a = _mm_div_ps(minXY, maxXY);
+	a = _mm_andnot_ps(_mm_cmpeq_ps(maxXY, _mm_setzero_ps()), a);
+
+	__m128 reduce = _mm_cmpgt_ps(a, _mm_set1_ps(TanPiOver8));
+	a = Select_SSE(reduce, _mm_div_ps(_mm_sub_ps(a, _mm_set1_ps(1.f)), _mm_add_ps(a, _mm_set1_ps(1.f))), a);
+
+	__m128 a2 = _mm_mul_ps(a, a);
+	__m128 result = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(Polynomial_SSE(a2, AtanCoeff, 4), a2), a), a);
+	result = _mm_add_ps(result, _mm_and_ps(reduce, _mm_set1_ps(PiOver4)));
+
+	result = Select_SSE(_mm_cmpgt_ps(absY, absX), _mm_sub_ps(_mm_set1_ps(PiOver2), result), result);
+	result = Select_SSE(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(PiF), result), result);
+
+	// Also covers -0 for y, same as atan2f.
+	return _mm_or_ps(result, _mm_and_ps(y, signMask));
+}
+
+// One Newton-Raphson step on top of the 12 bit hardware estimates.
+FE_FORCEINLINE __m128 Rsqrt_SSE(__m128 x) {
+	__m128 y = _mm_rsqrt_ps(x);
+	__m128 yyx = _mm_mul_ps(_mm_mul_ps(y, y), x);
+
+	return _mm_mul_ps(_mm_mul_ps(y, _mm_set1_ps(0.5f)), _mm_sub_ps(_mm_set1_ps(3.f), yyx));
+}
+
+FE_FORCEINLINE __m128 Rcp_SSE(__m128 x) {
+	__m128 y = _mm_rcp_ps(x);
+
+	return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(2.f), _mm_mul_ps(x, y)));
+}
+
+// The leftover elements go through a padded register so every element
+//	gets the same approximation.
+template<__m128(*Op)(__m128)>
+static void UnaryKernel_SSE(const float* pIn, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(pOut + i, Op(_mm_loadu_ps(pIn + i)));
+	}
+
+	if (i < count) {
+		float in[4] = { 1.f, 1.f, 1.f, 1.f };
+		float out[4];
+
+		memcpy(in, pIn + i, (count - i) * sizeof(float));
+		_mm_storeu_ps(out, Op(_mm_loadu_ps(in)));
+		memcpy(pOut + i, out, (count - i) * sizeof(float));
+	}
+}
+
+static void Sin_SSE(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_SSE<Sin_SSE>(pIn, count, pOut);
+}
+
+static void Cos_SSE(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_SSE<Cos_SSE>(pIn, count, pOut);
+}
+
+static void SinCos_SSE(const float* pIn, size_t count, float* pOutSin, float* pOutCos) {
+	size_t i = 0;
+	__m128 s, c;
+
+	for (; i + 4 <= count; i += 4) {
+		SinCos_SSE(_mm_loadu_ps(pIn + i), s, c);
+		_mm_storeu_ps(pOutSin + i, s);
+		_mm_storeu_ps(pOutCos + i, c);
+	}
+
+	if (i < count) {
+		float in[4] = {};
+		float outSin[4], outCos[4];
+
+		memcpy(in, pIn + i, (count - i) * sizeof(float));
+		SinCos_SSE(_mm_loadu_ps(in), s, c);
+		_mm_storeu_ps(outSin, s);
+		_mm_storeu_ps(outCos, c);
+		memcpy(pOutSin + i, outSin, (count - i) * sizeof(float));
+		memcpy(pOutCos + i, outCos, (count - i) * sizeof(float));
+	}
+}
+
+static void Exp_SSE(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_SSE<Exp_SSE>(pIn, count, pOut);
+}
+
+static void Log_SSE(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_SSE<Log_SSE>(pIn, count, pOut);
+}
+
+static void Atan2_SSE(const float* pYs, const float* pXs, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(pOut + i, Atan2_SSE(_mm_loadu_ps(pYs + i), _mm_loadu_ps(pXs + i)));
+	}
+
+	if (i < count) {
+		float ys[4] = {}, xs[4] = {};
+		float out[4];
+
+		memcpy(ys, pYs + i, (count - i) * sizeof(float));
+		memcpy(xs, pXs + i, (count - i) * sizeof(float));
+		_mm_storeu_ps(out, Atan2_SSE(_mm_loadu_ps(ys), _mm_loadu_ps(xs)));
+		memcpy(pOut + i, out, (count - i) * sizeof(float));
+	}
+}
+
+static void Rsqrt_SSE(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_SSE<Rsqrt_SSE>(pIn, count, pOut);
+}
+
+static void Rcp_SSE(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_SSE<Rcp_SSE>(pIn, count, pOut);
+}
+
+// ===============================================
+// AVX2 implementations
+// ===============================================
+// Same algorithms as the SSE versions with FMA, results can differ from
+//	them in the last bit.
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Select_AVX2(__m256 mask, __m256 a, __m256 b) {
+	return _mm256_blendv_ps(b, a, mask);
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Polynomial_AVX2(__m256 x, const float* pCoeffs, int numCoeffs) {
+	__m256 result = _mm256_set1_ps(pCoeffs[0]);
+
+	for (int i = 1; i < numCoeffs; i++) {
+		result = _mm256_fmadd_ps(result, x, _mm256_set1_ps(pCoeffs[i]));
+	}
+
+	return result;
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE void SinCos_AVX2(__m256 x, __m256& s, __m256& c) {
+	__m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(TwoOverPi)));
+	__m256 qf = _mm256_cvtepi32_ps(q);
+
+	__m256 r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(PiOver2A), x);
+	r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(PiOver2B), r);
+	r = _mm256_fnmadd_ps(qf, _mm256_set1_ps(PiOver2C), r);
+
+	__m256 r2 = _mm256_mul_ps(r, r);
+
+	__m256 sinR = _mm256_fmadd_ps(r2, _mm256_set1_ps(SinCoeff2), _mm256_set1_ps(SinCoeff1));
+	sinR = _mm256_fmadd_ps(sinR, r2, _mm256_set1_ps(SinCoeff0));
+	sinR = _mm256_fmadd_ps(_mm256_mul_ps(sinR, r2), r, r);
+
+	__m256 cosR = _mm256_fmadd_ps(r2, _mm256_set1_ps(CosCoeff2), _mm256_set1_ps(CosCoeff1));
+	cosR = _mm256_fmadd_ps(cosR, r2, _mm256_set1_ps(CosCoeff0));
+	cosR = _mm256_mul_ps(_mm256_mul_ps(cosR, r2), r2);
+	cosR = _mm256_add_ps(_mm256_fnmadd_ps(r2, _mm256_set1_ps(0.5f), cosR), _mm256_set1_ps(1.f));
+
+	__m256i one = _mm256_set1_epi32(1);
+	__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+	__m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30));
+	__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), _mm256_set1_epi32(2)), 30));
+
+	s = _mm256_xor_ps(Select_AVX2(swap, cosR, sinR), sinSign);
+	c = _mm256_xor_ps(Select_AVX2(swap, sinR, cosR), cosSign);
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Sin_AVX2(__m256 x) {
+	__m256 s, c;
+	SinCos_AVX2(x, s, c);
+
+	return s;
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Cos_AVX2(__m256 x) {
+	__m256 s, c;
+	SinCos_AVX2(x, s, c);
+
+	return c;
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Exp_AVX2(__m256 x) {
+	__m256 overflow = _mm256_cmp_ps(x, _mm256_set1_ps(ExpMax), _CMP_GT_OQ);
+	__m256 underflow = _mm256_cmp_ps(x, _mm256_set1_ps(ExpMin), _CMP_LT_OQ);
+	x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(ExpMin)), _mm256_set1_ps(ExpMax));
+
+	__m256i n = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(Log2E)));
+	__m256 nf = _mm256_cvtepi32_ps(n);
+
+	// Same as Exp_SSE, the fused multiply-adds make rLow exact.
+	__m256 r1 = _mm256_fnmadd_ps(nf, _mm256_set1_ps(Ln2A), x);
+	__m256 r = _mm256_fnmadd_ps(nf, _mm256_set1_ps(Ln2B), r1);
+	__m256 rLow = _mm256_fnmadd_ps(nf, _mm256_set1_ps(Ln2B), _mm256_sub_ps(r1, r));
+
+	__m256 p = Polynomial_AVX2(r, ExpCoeff, 6);
+
+	__m256 one = _mm256_set1_ps(1.f);
+	__m256 sum = _mm256_add_ps(one, r);
+	__m256 sumLow = _mm256_add_ps(_mm256_sub_ps(one, sum), r);
+	p = _mm256_add_ps(sum, _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(sumLow, rLow)));
+
+	__m256 scale = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23));
+	__m256 result = _mm256_mul_ps(p, scale);
+
+	result = _mm256_andnot_ps(underflow, result);
+
+	return Select_AVX2(overflow, _mm256_set1_ps(HUGE_VALF), result);
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Log_AVX2(__m256 x) {
+	__m256 negative = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+	__m256 zero = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+	__m256i bits = _mm256_castps_si256(x);
+	__m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+	__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+
+	__m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(SqrtHalf), _CMP_LT_OQ);
+	e = _mm256_sub_ps(e, _mm256_and_ps(small, _mm256_set1_ps(1.f)));
+	m = _mm256_add_ps(_mm256_sub_ps(m, _mm256_set1_ps(1.f)), _mm256_and_ps(small, m));
+
+	__m256 m2 = _mm256_mul_ps(m, m);
+	__m256 y = _mm256_mul_ps(_mm256_mul_ps(Polynomial_AVX2(m, LogCoeff, 9), m), m2);
+
+	y = _mm256_fmadd_ps(e, _mm256_set1_ps(Ln2B), y);
+	y = _mm256_fnmadd_ps(m2, _mm256_set1_ps(0.5f), y);
+
+	__m256 result = _mm256_fmadd_ps(e, _mm256_set1_ps(Ln2A), _mm256_add_ps(m, y));
+
+	result = Select_AVX2(zero, _mm256_set1_ps(-HUGE_VALF), result);
+
+	return _mm256_or_ps(result, negative);
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Atan2_AVX2(__m256 y, __m256 x) {
+	__m256 signMask = _mm256_set1_ps(-0.f);
+	__m256 absY = _mm256_andnot_ps(signMask, y);
+	__m256 absX = _mm256_andnot_ps(signMask, x);
+
+	__m256 minXY = _mm256_min_ps(absX, absY);
+	__m256 maxXY = _mm256_max_ps(absX, absY);
+	__m256 a = _mm256_div_ps(minXY, maxXY);
+	a = _mm256_andnot_ps(_mm256_cmp_ps(maxXY, _mm256_setzero_ps(), _CMP_EQ_OQ), a);
+
+	__m256 reduce = _mm256_cmp_ps(a, _mm256_set1_ps(TanPiOver8), _CMP_GT_OQ);
+	a = Select_AVX2(reduce, _mm256_div_ps(_mm256_sub_ps(a, _mm256_set1_ps(1.f)), _mm256_add_ps(a, _mm256_set1_ps(1.f))), a);
+
+	__m256 a2 = _mm256_mul_ps(a, a);
+	__m256 result = _mm256_fmadd_ps(_mm256_mul_ps(Polynomial_AVX2(a2, AtanCoeff, 4), a2), a, a);
+	result = _mm256_add_ps(result, _mm256_and_ps(reduce, _mm256_set1_ps(PiOver4)));
+
+	result = Select_AVX2(_mm256_cmp_ps(absY, absX, _CMP_GT_OQ), _mm256_sub_ps(_mm256_set1_ps(PiOver2), result), result);
+	result = Select_AVX2(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_sub_ps(_mm256_set1_ps(PiF), result), result);
+
+	return _mm256_or_ps(result, _mm256_and_ps(y, signMask));
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Rsqrt_AVX2(__m256 x) {
+	__m256 y = _mm256_rsqrt_ps(x);
+	__m256 yyx = _mm256_mul_ps(_mm256_mul_ps(y, y), x);
+
+	return _mm256_mul_ps(_mm256_mul_ps(y, _mm256_set1_ps(0.5f)), _mm256_sub_ps(_mm256_set1_ps(3.f), yyx));
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 Rcp_AVX2(__m256 x) {
+	__m256 y = _mm256_rcp_ps(x);
+
+	return _mm256_mul_ps(y, _mm256_fnmadd_ps(x, y, _mm256_set1_ps(2.f)));
+}
+
+template<__m256(*Op)(__m256)>
+static FE_TARGET_AVX2 void UnaryKernel_AVX2(const float* pIn, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(pOut + i, Op(_mm256_loadu_ps(pIn + i)));
+	}
+
+	if (i < count) {
+		float in[8] = { 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f };
+		float out[8];
+
+		memcpy(in, pIn + i, (count - i) * sizeof(float));
+		_mm256_storeu_ps(out, Op(_mm256_loadu_ps(in)));
+		memcpy(pOut + i, out, (count - i) * sizeof(float));
+	}
+}
+
+static FE_TARGET_AVX2 void Sin_AVX2(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_AVX2<Sin_AVX2>(pIn, count, pOut);
+}
+
+static FE_TARGET_AVX2 void Cos_AVX2(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_AVX2<Cos_AVX2>(pIn, count, pOut);
+}
+
+static FE_TARGET_AVX2 void SinCos_AVX2(const float* pIn, size_t count, float* pOutSin, float* pOutCos) {
+	size_t i = 0;
+	__m256 s, c;
+
+	for (; i + 8 <= count; i += 8) {
+		SinCos_AVX2(_mm256_loadu_ps(pIn + i), s, c);
+		_mm256_storeu_ps(pOutSin + i, s);
+		_mm256_storeu_ps(pOutCos + i, c);
+	}
+
+	if (i < count) {
+		float in[8] = {};
+		float outSin[8], outCos[8];
+
+		memcpy(in, pIn + i, (count - i) * sizeof(float));
+		SinCos_AVX2(_mm256_loadu_ps(in), s, c);
+		_mm256_storeu_ps(outSin, s);
+		_mm256_storeu_ps(outCos, c);
+		memcpy(pOutSin + i, outSin, (count - i) * sizeof(float));
+		memcpy(pOutCos + i, outCos, (count - i) * sizeof(float));
+	}
+}
+
+static FE_TARGET_AVX2 void Exp_AVX2(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_AVX2<Exp_AVX2>(pIn, count, pOut);
+}
+
+static FE_TARGET_AVX2 void Log_AVX2(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_AVX2<Log_AVX2>(pIn, count, pOut);
+}
+
+static FE_TARGET_AVX2 void Atan2_AVX2(const float* pYs, const float* pXs, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(pOut + i, Atan2_AVX2(_mm256_loadu_ps(pYs + i), _mm256_loadu_ps(pXs + i)));
+	}
+
+	if (i < count) {
+		float ys[8] = {}, xs[8] = {};
+		float out[8];
+
+		memcpy(ys, pYs + i, (count - i) * sizeof(float));
+		memcpy(xs, pXs + i, (count - i) * sizeof(float));
+		_mm256_storeu_ps(out, Atan2_AVX2(_mm256_loadu_ps(ys), _mm256_loadu_ps(xs)));
+		memcpy(pOut + i, out, (count - i) * sizeof(float));
+	}
+}
+
+static FE_TARGET_AVX2 void Rsqrt_AVX2(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_AVX2<Rsqrt_AVX2>(pIn, count, pOut);
+}
+
+static FE_TARGET_AVX2 void Rcp_AVX2(const float* pIn, size_t count, float* pOut) {
+	UnaryKernel_AVX2<Rcp_AVX2>(pIn, count, pOut);
+}
+#endif
+
+// ===============================================
+// Dispatch
+// ===============================================
+using UnaryKernel_t = void(*)(const float* pIn, size_t count, float* pOut);
+using SinCosKernel_t = void(*)(const float* pIn, size_t count, float* pOutSin, float* pOutCos);
+using Atan2Kernel_t = void(*)(const float* pYs, const float* pXs, size_t count, float* pOut);
+
+static SimdDispatch<UnaryKernel_t> sinArray(FE_SIMD_VARIANTS(Sin));
+static SimdDispatch<UnaryKernel_t> cosArray(FE_SIMD_VARIANTS(Cos));
+static SimdDispatch<SinCosKernel_t> sinCosArray(FE_SIMD_VARIANTS(SinCos));
+static SimdDispatch<UnaryKernel_t> expArray(FE_SIMD_VARIANTS(Exp));
+static SimdDispatch<UnaryKernel_t> logArray(FE_SIMD_VARIANTS(Log));
+static SimdDispatch<Atan2Kernel_t> atan2Array(FE_SIMD_VARIANTS(Atan2));
+static SimdDispatch<UnaryKernel_t> rsqrtArray(FE_SIMD_VARIANTS(Rsqrt));
+static SimdDispatch<UnaryKernel_t> rcpArray(FE_SIMD_VARIANTS(Rcp));
+
+// ===============================================
+// Public interface
+// ===============================================
+void SinArray(const float* pIn, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Sin_Scalar(pIn, count, pOut);
+
+	sinArray(pIn, count, pOut);
+}
+
+void CosArray(const float* pIn, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Cos_Scalar(pIn, count, pOut);
+
+	cosArray(pIn, count, pOut);
+}
+
+void SinCosArray(const float* pIn, size_t count, float* pOutSin, float* pOutCos) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return SinCos_Scalar(pIn, count, pOutSin, pOutCos);
+
+	sinCosArray(pIn, count, pOutSin, pOutCos);
+}
+
+void ExpArray(const float* pIn, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Exp_Scalar(pIn, count, pOut);
+
+	expArray(pIn, count, pOut);
+}
+
+void LogArray(const float* pIn, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Log_Scalar(pIn, count, pOut);
+
+	logArray(pIn, count, pOut);
+}
+
+void Atan2Array(const float* pYs, const float* pXs, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Atan2_Scalar(pYs, pXs, count, pOut);
+
+	atan2Array(pYs, pXs, count, pOut);
+}
+
+void RsqrtArray(const float* pIn, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Rsqrt_Scalar(pIn, count, pOut);
+
+	rsqrtArray(pIn, count, pOut);
+}
+
+void RcpArray(const float* pIn, size_t count, float* pOut) {
+	if (approxMathMode == ApproxMathMode::Precise)
+		return Rcp_Scalar(pIn, count, pOut);
+
+	rcpArray(pIn, count, pOut);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fe::math {
+
+// Batch versions of the libm functions for animation and procedural code.
+//	In Fast mode they use polynomial approximations on SSE2 or AVX2, picked
+//	through the SIMD dispatch. Precise mode and the scalar SIMD level call
+//	libm per element instead.
+//	Output arrays may be the same as the input arrays.
+//
+//	Max errors of the Fast mode over the stated input range:
+//	  SinArray, CosArray, SinCosArray  |x| <= 8192            1e-7 absolute
+//	  ExpArray                         any x                  1 ulp, 0 below -87.33, inf above 88.37
+//	  LogArray                         normal x > 0           1 ulp, -inf for 0, NaN below 0
+//	  Atan2Array                       finite y, x            3e-7 radians
+//	  RsqrtArray                       normal x > 0           2.5e-7 relative
+//	  RcpArray                         normal |x| < 2^126     2e-7 relative
+//	Subnormal inputs are not handled, the results for them are undefined.
+struct ApproxMathMode {
+	enum Enum : uint32_t {
+		Fast,
+		Precise
+	};
+};
+
+// Global for all batch functions below, defaults to Fast.
+void SetApproxMathMode(ApproxMathMode::Enum mode);
+ApproxMathMode::Enum GetApproxMathMode();
+
+void SinArray(const float* pIn, size_t count, float* pOut);
+void CosArray(const float* pIn, size_t count, float* pOut);
+void SinCosArray(const float* pIn, size_t count, float* pOutSin, float* pOutCos);
+void ExpArray(const float* pIn, size_t count, float* pOut);
+void LogArray(const float* pIn, size_t count, float* pOut);
+void Atan2Array(const float* pYs, const float* pXs, size_t count, float* pOut);
+void RsqrtArray(const float* pIn, size_t count, float* pOut);
+void RcpArray(const float* pIn, size_t count, float* pOut);
+
+}
\ No newline at end of file
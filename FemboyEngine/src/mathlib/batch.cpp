@@ -0,0 +1,250 @@
+#include "batch.h"
+#include "widevector.h"
+#include "dispatch.h"
+
+namespace fe::math {
+
+// ===============================================
+// Scalar implementations
+// ===============================================
+static void TransformPoints_Scalar(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	for (size_t i = 0; i < count; i++) {
+		Vector3 p = TransformPoint(M, Vector3(pXs[i], pYs[i], pZs[i]));
+
+		pOutXs[i] = p.x;
+		pOutYs[i] = p.y;
+		pOutZs[i] = p.z;
+	}
+}
+
+static void TransformDirections_Scalar(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	for (size_t i = 0; i < count; i++) {
+		Vector3 d = TransformDirection(M, Vector3(pXs[i], pYs[i], pZs[i]));
+
+		pOutXs[i] = d.x;
+		pOutYs[i] = d.y;
+		pOutZs[i] = d.z;
+	}
+}
+
+static void NormalizeVectors_Scalar(const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	for (size_t i = 0; i < count; i++) {
+		Vector3 v = NormalizeVector(Vector3(pXs[i], pYs[i], pZs[i]));
+
+		pOutXs[i] = v.x;
+		pOutYs[i] = v.y;
+		pOutZs[i] = v.z;
+	}
+}
+
+// ===============================================
+// SSE implementations
+// ===============================================
+#if FE_SIMD_SSE
+// Matrix rows with every element broadcast to a full register.
+struct WideMatrix3x4_SSE {
+	Vector3x4 r[3];
+	__m128 t[3];
+
+	explicit WideMatrix3x4_SSE(const Matrix3x4& M) {
+		for (int i = 0; i < 3; i++) {
+			r[i] = Vector3x4(M[i].XYZ());
+			t[i] = _mm_set1_ps(M[i].w);
+		}
+	}
+};
+
+static void TransformPoints_SSE(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	WideMatrix3x4_SSE wideM(M);
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		Vector3x4 p = Vector3x4::Load(pXs + i, pYs + i, pZs + i);
+
+		Vector3x4 result(
+			_mm_add_ps(DotProduct(wideM.r[0], p), wideM.t[0]),
+			_mm_add_ps(DotProduct(wideM.r[1], p), wideM.t[1]),
+			_mm_add_ps(DotProduct(wideM.r[2], p), wideM.t[2])
+		);
+
+		result.Store(pOutXs + i, pOutYs + i, pOutZs + i);
+	}
+
+	TransformPoints_Scalar(M, pXs + i, pYs + i, pZs + i, count - i, pOutXs + i, pOutYs + i, pOutZs + i);
+}
+
+static void TransformDirections_SSE(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	WideMatrix3x4_SSE wideM(M);
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		Vector3x4 d = Vector3x4::Load(pXs + i, pYs + i, pZs + i);
+
+		Vector3x4 result(DotProduct(wideM.r[0], d), DotProduct(wideM.r[1], d), DotProduct(wideM.r[2], d));
+
+		result.Store(pOutXs + i, pOutYs + i, pOutZs + i);
+	}
+
+	TransformDirections_Scalar(M, pXs + i, pYs + i, pZs + i, count - i, pOutXs + i, pOutYs + i, pOutZs + i);
+}
+
+static void NormalizeVectors_SSE(const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		NormalizeVector(Vector3x4::Load(pXs + i, pYs + i, pZs + i)).Store(pOutXs + i, pOutYs + i, pOutZs + i);
+	}
+
+	NormalizeVectors_Scalar(pXs + i, pYs + i, pZs + i, count - i, pOutXs + i, pOutYs + i, pOutZs + i);
+}
+#endif
+
+// ===============================================
+// AVX2 implementations
+// ===============================================
+// These use FMA, results can differ from the scalar versions in the last bit.
+//	They are always compiled for x64 and only run when the CPU has AVX2.
+#if FE_SIMD_SSE
+static FE_TARGET_AVX2 void TransformPoints_AVX2(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	__m256 m[3][4];
+	for (int r = 0; r < 3; r++) {
+		for (int c = 0; c < 4; c++) {
+			m[r][c] = _mm256_set1_ps(M[r][c]);
+		}
+	}
+
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		Vector3x8 p = Vector3x8::Load(pXs + i, pYs + i, pZs + i);
+		__m256 result[3];
+
+		for (int r = 0; r < 3; r++) {
+			result[r] = _mm256_fmadd_ps(m[r][0], p.x, _mm256_fmadd_ps(m[r][1], p.y, _mm256_fmadd_ps(m[r][2], p.z, m[r][3])));
+		}
+
+		Vector3x8(result[0], result[1], result[2]).Store(pOutXs + i, pOutYs + i, pOutZs + i);
+	}
+
+	TransformPoints_Scalar(M, pXs + i, pYs + i, pZs + i, count - i, pOutXs + i, pOutYs + i, pOutZs + i);
+}
+
+static FE_TARGET_AVX2 void TransformDirections_AVX2(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	__m256 m[3][3];
+	for (int r = 0; r < 3; r++) {
+		for (int c = 0; c < 3; c++) {
+			m[r][c] = _mm256_set1_ps(M[r][c]);
+		}
+	}
+
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		Vector3x8 d = Vector3x8::Load(pXs + i, pYs + i, pZs + i);
+		__m256 result[3];
+
+		for (int r = 0; r < 3; r++) {
+			result[r] = _mm256_fmadd_ps(m[r][0], d.x, _mm256_fmadd_ps(m[r][1], d.y, _mm256_mul_ps(m[r][2], d.z)));
+		}
+
+		Vector3x8(result[0], result[1], result[2]).Store(pOutXs + i, pOutYs + i, pOutZs + i);
+	}
+
+	TransformDirections_Scalar(M, pXs + i, pYs + i, pZs + i, count - i, pOutXs + i, pOutYs + i, pOutZs + i);
+}
+
+static FE_TARGET_AVX2 void NormalizeVectors_AVX2(const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		NormalizeVector(Vector3x8::Load(pXs + i, pYs + i, pZs + i)).Store(pOutXs + i, pOutYs + i, pOutZs + i);
+	}
+
+	NormalizeVectors_Scalar(pXs + i, pYs + i, pZs + i, count - i, pOutXs + i, pOutYs + i, pOutZs + i);
+}
+#endif
+
+// ===============================================
+// Dispatch
+// ===============================================
+using TransformKernel_t = void(*)(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs);
+using NormalizeKernel_t = void(*)(const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs);
+
+static SimdDispatch<TransformKernel_t> transformPoints(FE_SIMD_VARIANTS(TransformPoints));
+static SimdDispatch<TransformKernel_t> transformDirections(FE_SIMD_VARIANTS(TransformDirections));
+static SimdDispatch<NormalizeKernel_t> normalizeVectors(FE_SIMD_VARIANTS(NormalizeVectors));
+
+// ===============================================
+// Public interface
+// ===============================================
+void TransformPoints(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	transformPoints(M, pXs, pYs, pZs, count, pOutXs, pOutYs, pOutZs);
+}
+
+void TransformDirections(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	transformDirections(M, pXs, pYs, pZs, count, pOutXs, pOutYs, pOutZs);
+}
+
+void NormalizeVectors(const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs) {
+	normalizeVectors(pXs, pYs, pZs, count, pOutXs, pOutYs, pOutZs);
+}
+
+// Four Vector3 are exactly three registers:
+//	a = (x0, y0, z0, x1), b = (y1, z1, x2, y2), c = (z2, x3, y3, z3)
+void AoSToSoA(const Vector3* pVectors, size_t count, float* pXs, float* pYs, float* pZs) {
+	size_t i = 0;
+
+#if FE_SIMD_SSE
+	const float* pSrc = &pVectors[0].x;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 a = _mm_loadu_ps(pSrc + i * 3);
+		__m128 b = _mm_loadu_ps(pSrc + i * 3 + 4);
+		__m128 c = _mm_loadu_ps(pSrc + i * 3 + 8);
+
+		__m128 xy23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+		__m128 yz01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+
+		_mm_storeu_ps(pXs + i, _mm_shuffle_ps(a, xy23, _MM_SHUFFLE(2, 0, 3, 0)));
+		_mm_storeu_ps(pYs + i, _mm_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0)));
+		_mm_storeu_ps(pZs + i, _mm_shuffle_ps(yz01, c, _MM_SHUFFLE(3, 0, 3, 1)));
+	}
+#endif
+
+	for (; i < count; i++) {
+		pXs[i] = pVectors[i].x;
+		pYs[i] = pVectors[i].y;
+		pZs[i] = pVectors[i].z;
+	}
+}
+
+void SoAToAoS(const float* pXs, const float* pYs, const float* pZs, size_t count, Vector3* pVectors) {
+	size_t i = 0;
+
+#if FE_SIMD_SSE
+	float* pDst = &pVectors[0].x;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 v0 = _mm_loadu_ps(pXs + i);
+		__m128 v1 = _mm_loadu_ps(pYs + i);
+		__m128 v2 = _mm_loadu_ps(pZs + i);
+		__m128 v3 = _mm_setzero_ps();
+
+		_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+
+		// Each store writes one float past the vector, the next store
+		//	overwrites it. The last one only writes xyz.
+		_mm_storeu_ps(pDst + i * 3, v0);
+		_mm_storeu_ps(pDst + i * 3 + 3, v1);
+		_mm_storeu_ps(pDst + i * 3 + 6, v2);
+		_mm_storel_pi(reinterpret_cast<__m64*>(pDst + i * 3 + 9), v3);
+		_mm_store_ss(pDst + i * 3 + 11, _mm_movehl_ps(v3, v3));
+	}
+#endif
+
+	for (; i < count; i++) {
+		pVectors[i] = Vector3(pXs[i], pYs[i], pZs[i]);
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "vector.h"
+#include "matrix.h"
+
+namespace fe::math {
+
+// Batch kernels over structure of arrays data.
+//	Component arrays are separate float arrays of count elements, they don't
+//	need to be aligned. Output arrays may be the same as the input arrays.
+
+// Transforms points by an affine matrix. There is deliberately no Matrix4x4
+//	version: a world matrix converts with ToMatrix3x4, but a projection or
+//	view-projection needs w and the perspective divide, use TransformVector
+//	for those.
+void TransformPoints(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs);
+
+// Same as TransformPoints without the translation.
+void TransformDirections(const Matrix3x4& M, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs);
+
+void NormalizeVectors(const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOutXs, float* pOutYs, float* pOutZs);
+
+// Conversion between Vector3 arrays and component arrays, so existing
+//	Vector3 data can be fed through the kernels above.
+void AoSToSoA(const Vector3* pVectors, size_t count, float* pXs, float* pYs, float* pZs);
+void SoAToAoS(const float* pXs, const float* pYs, const float* pZs, size_t count, Vector3* pVectors);
+
+}
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "bvh.h"
+#include "wideintersect.h"
+#include "dispatch.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace fe::math {
+
+constexpr size_t LeafSize = 4;
+// The tree is balanced, every level pushes at most 3 entries and 64 is
+//	enough for far more triangles than fit in memory.
+constexpr size_t StackSize = 64;
+
+// ===============================================
+// Building
+// ===============================================
+// Starting value for growing bounds.
+constexpr AABB_t InvertedAABB = {
+	Vector3(FLT_MAX, FLT_MAX, FLT_MAX),
+	Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+};
+
+struct BuildTriangle_t {
+	AABB_t bounds;
+	Vector3 centroid;
+	uint32_t index;
+};
+
+struct BuildRange_t {
+	size_t first;
+	size_t count;
+};
+
+static void GrowAABB(AABB_t& box, const Vector3& point) {
+	for (size_t i = 0; i < 3; i++) {
+		box.min[i] = std::min(box.min[i], point[i]);
+		box.max[i] = std::max(box.max[i], point[i]);
+	}
+}
+
+static AABB_t GetRangeBounds(const BuildTriangle_t* pTriangles, BuildRange_t range) {
+	AABB_t bounds = InvertedAABB;
+
+	for (size_t i = range.first; i < range.first + range.count; i++) {
+		GrowAABB(bounds, pTriangles[i].bounds.min);
+		GrowAABB(bounds, pTriangles[i].bounds.max);
+	}
+
+	return bounds;
+}
+
+static void SplitRange(BuildTriangle_t* pTriangles, BuildRange_t range, BuildRange_t& left, BuildRange_t& right) {
+	AABB_t centroidBounds = InvertedAABB;
+
+	for (size_t i = range.first; i < range.first + range.count; i++) {
+		GrowAABB(centroidBounds, pTriangles[i].centroid);
+	}
+
+	Vector3 extent = centroidBounds.max - centroidBounds.min;
+	size_t axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	size_t half = range.count / 2;
+
+	std::nth_element(pTriangles + range.first, pTriangles + range.first + half, pTriangles + range.first + range.count,
+		[axis](const BuildTriangle_t& a, const BuildTriangle_t& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+	left = { range.first, half };
+	right = { range.first + half, range.count - half };
+}
+
+static uint32_t BuildLeaf(const BuildTriangle_t* pTriangles, BuildRange_t range, const Vector3* pPositions, const uint32_t* pIndices, std::vector<BVH4Leaf_t>& leaves) {
+	BVH4Leaf_t leaf = {};
+
+	for (size_t lane = 0; lane < LeafSize; lane++) {
+		leaf.triangles[lane] = BVH4Leaf_t::EmptyTriangle;
+	}
+
+	for (size_t lane = 0; lane < range.count; lane++) {
+		uint32_t triangle = pTriangles[range.first + lane].index;
+		const Vector3& v0 = pPositions[pIndices[triangle * 3 + 0]];
+		const Vector3& v1 = pPositions[pIndices[triangle * 3 + 1]];
+		const Vector3& v2 = pPositions[pIndices[triangle * 3 + 2]];
+
+		leaf.v0X[lane] = v0.x; leaf.v0Y[lane] = v0.y; leaf.v0Z[lane] = v0.z;
+		leaf.v1X[lane] = v1.x; leaf.v1Y[lane] = v1.y; leaf.v1Z[lane] = v1.z;
+		leaf.v2X[lane] = v2.x; leaf.v2Y[lane] = v2.y; leaf.v2Z[lane] = v2.z;
+		leaf.triangles[lane] = triangle;
+	}
+
+	leaves.push_back(leaf);
+
+	return static_cast<uint32_t>(leaves.size() - 1) | BVH4Node_t::LeafFlag;
+}
+
+// Splits the largest range until there are four children.
+static uint32_t BuildNode(BuildTriangle_t* pTriangles, BuildRange_t range, const Vector3* pPositions, const uint32_t* pIndices, std::vector<BVH4Node_t>& nodes, std::vector<BVH4Leaf_t>& leaves) {
+	BuildRange_t ranges[4] = { range };
+	size_t numRanges = 1;
+
+	while (numRanges < 4) {
+		size_t largest = 0;
+		for (size_t i = 1; i < numRanges; i++) {
+			if (ranges[i].count > ranges[largest].count)
+				largest = i;
+		}
+
+		if (ranges[largest].count <= LeafSize)
+			break;
+
+		SplitRange(pTriangles, ranges[largest], ranges[largest], ranges[numRanges]);
+		numRanges++;
+	}
+
+	// Reserve the slot first, the children are appended after it.
+	uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+	nodes.emplace_back();
+
+	BVH4Node_t node;
+	for (size_t i = 0; i < 4; i++) {
+		SetAABB(node.bounds, i, i < numRanges ? GetRangeBounds(pTriangles, ranges[i]) : EmptyAABB);
+		node.children[i] = BVH4Node_t::EmptyChild;
+	}
+
+	for (size_t i = 0; i < numRanges; i++) {
+		if (ranges[i].count <= LeafSize) {
+			node.children[i] = BuildLeaf(pTriangles, ranges[i], pPositions, pIndices, leaves);
+		}
+		else {
+			node.children[i] = BuildNode(pTriangles, ranges[i], pPositions, pIndices, nodes, leaves);
+		}
+	}
+
+	nodes[nodeIndex] = node;
+
+	return nodeIndex;
+}
+
+void BVH4::Build(const Vector3* pPositions, const uint32_t* pIndices, size_t numTriangles) {
+	Clear();
+
+	if (numTriangles == 0)
+		return;
+
+	std::vector<BuildTriangle_t> triangles(numTriangles);
+
+	for (size_t i = 0; i < numTriangles; i++) {
+		BuildTriangle_t& triangle = triangles[i];
+		triangle.bounds = InvertedAABB;
+		triangle.index = static_cast<uint32_t>(i);
+
+		for (size_t j = 0; j < 3; j++) {
+			GrowAABB(triangle.bounds, pPositions[pIndices[i * 3 + j]]);
+		}
+
+		triangle.centroid = (triangle.bounds.min + triangle.bounds.max) * 0.5f;
+	}
+
+	// Roughly one leaf per four triangles and a third as many nodes.
+	m_Leaves.reserve(numTriangles / 2 + 1);
+	m_Nodes.reserve(numTriangles / 6 + 1);
+
+	BuildNode(triangles.data(), { 0, numTriangles }, pPositions, pIndices, m_Nodes, m_Leaves);
+
+	m_Bounds = GetRangeBounds(triangles.data(), { 0, numTriangles });
+}
+
+void BVH4::Clear() {
+	m_Nodes.clear();
+	m_Leaves.clear();
+	m_Bounds = EmptyAABB;
+}
+
+// ===============================================
+// Traversal
+// ===============================================
+struct StackEntry_t {
+	uint32_t child;
+	float distance;
+};
+
+// Pushes the children that were hit far to near, so the nearest is popped first.
+static void PushChildren(const BVH4Node_t& node, uint32_t mask, const float* pDistances, StackEntry_t* pStack, size_t& stackSize) {
+	StackEntry_t sorted[4];
+	size_t numSorted = 0;
+
+	for (size_t i = 0; i < 4; i++) {
+		if (!(mask & (1u << i)))
+			continue;
+
+		size_t j = numSorted++;
+		for (; j > 0 && sorted[j - 1].distance < pDistances[i]; j--) {
+			sorted[j] = sorted[j - 1];
+		}
+
+		sorted[j] = { node.children[i], pDistances[i] };
+	}
+
+	for (size_t i = 0; i < numSorted; i++) {
+		pStack[stackSize++] = sorted[i];
+	}
+}
+
+// Lowest distance of the hit lanes, ties go to the lowest lane.
+static size_t GetClosestLane(uint32_t mask, const float* pDistances) {
+	size_t closest = 4;
+
+	for (size_t i = 0; i < 4; i++) {
+		if ((mask & (1u << i)) && (closest == 4 || pDistances[i] < pDistances[closest]))
+			closest = i;
+	}
+
+	return closest;
+}
+
+static bool Traverse_Scalar(const BVH4Node_t* pNodes, const BVH4Leaf_t* pLeaves, const Ray_t& ray, float maxDistance, bool anyHit, RayHit_t& hit) {
+	StackEntry_t stack[StackSize];
+	size_t stackSize = 0;
+	float closest = maxDistance;
+	bool found = false;
+
+	stack[stackSize++] = { 0, 0.f };
+
+	while (stackSize > 0) {
+		StackEntry_t entry = stack[--stackSize];
+
+		if (entry.distance > closest)
+			continue;
+
+		float distances[4], us[4], vs[4];
+		uint32_t mask = 0;
+
+		if (entry.child & BVH4Node_t::LeafFlag) {
+			const BVH4Leaf_t& leaf = pLeaves[entry.child & ~BVH4Node_t::LeafFlag];
+
+			for (size_t i = 0; i < 4; i++) {
+				Vector3 v0(leaf.v0X[i], leaf.v0Y[i], leaf.v0Z[i]);
+				Vector3 v1(leaf.v1X[i], leaf.v1Y[i], leaf.v1Z[i]);
+				Vector3 v2(leaf.v2X[i], leaf.v2Y[i], leaf.v2Z[i]);
+
+				mask |= static_cast<uint32_t>(IntersectRayTriangle(ray, v0, v1, v2, closest, distances[i], us[i], vs[i])) << i;
+			}
+
+			if (mask) {
+				size_t lane = GetClosestLane(mask, distances);
+				hit = { distances[lane], us[lane], vs[lane], leaf.triangles[lane] };
+				closest = distances[lane];
+				found = true;
+
+				if (anyHit)
+					return true;
+			}
+
+			continue;
+		}
+
+		const BVH4Node_t& node = pNodes[entry.child];
+
+		for (size_t i = 0; i < 4; i++) {
+			AABB_t box = { Vector3(node.bounds.minX[i], node.bounds.minY[i], node.bounds.minZ[i]), Vector3(node.bounds.maxX[i], node.bounds.maxY[i], node.bounds.maxZ[i]) };
+
+			mask |= static_cast<uint32_t>(IntersectRayAABB(ray, box, closest, distances[i])) << i;
+		}
+
+		PushChildren(node, mask, distances, stack, stackSize);
+	}
+
+	return found;
+}
+
+#if FE_SIMD_SSE
+static bool Traverse_SSE(const BVH4Node_t* pNodes, const BVH4Leaf_t* pLeaves, const Ray_t& ray, float maxDistance, bool anyHit, RayHit_t& hit) {
+	StackEntry_t stack[StackSize];
+	size_t stackSize = 0;
+	float closest = maxDistance;
+	bool found = false;
+
+	Vector3x4 origin(ray.origin);
+	Vector3x4 direction(ray.direction);
+	Vector3x4 invDirection(Vector3(1.f / ray.direction.x, 1.f / ray.direction.y, 1.f / ray.direction.z));
+
+	stack[stackSize++] = { 0, 0.f };
+
+	while (stackSize > 0) {
+		StackEntry_t entry = stack[--stackSize];
+
+		if (entry.distance > closest)
+			continue;
+
+		alignas(16) float distances[4];
+
+		if (entry.child & BVH4Node_t::LeafFlag) {
+			const BVH4Leaf_t& leaf = pLeaves[entry.child & ~BVH4Node_t::LeafFlag];
+			__m128 distance, u, v;
+
+			__m128 hitMask = IntersectRayTriangle(origin, direction, Vector3x4::Load(leaf.v0X, leaf.v0Y, leaf.v0Z), Vector3x4::Load(leaf.v1X, leaf.v1Y, leaf.v1Z),
+				Vector3x4::Load(leaf.v2X, leaf.v2Y, leaf.v2Z), _mm_set1_ps(closest), distance, u, v);
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(hitMask));
+
+			if (mask) {
+				alignas(16) float us[4], vs[4];
+				_mm_store_ps(distances, distance);
+				_mm_store_ps(us, u);
+				_mm_store_ps(vs, v);
+
+				size_t lane = GetClosestLane(mask, distances);
+				hit = { distances[lane], us[lane], vs[lane], leaf.triangles[lane] };
+				closest = distances[lane];
+				found = true;
+
+				if (anyHit)
+					return true;
+			}
+
+			continue;
+		}
+
+		const BVH4Node_t& node = pNodes[entry.child];
+		__m128 distance;
+
+		__m128 hitMask = IntersectRayAABB(origin, invDirection, Vector3x4::Load(node.bounds.minX, node.bounds.minY, node.bounds.minZ),
+			Vector3x4::Load(node.bounds.maxX, node.bounds.maxY, node.bounds.maxZ), _mm_set1_ps(closest), distance);
+		uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(hitMask));
+
+		if (mask) {
+			_mm_store_ps(distances, distance);
+			PushChildren(node, mask, distances, stack, stackSize);
+		}
+	}
+
+	return found;
+}
+#endif
+
+// ===============================================
+// Dispatch
+// ===============================================
+// Nodes are four wide, AVX2 uses the SSE traversal.
+using TraverseKernel_t = bool(*)(const BVH4Node_t* pNodes, const BVH4Leaf_t* pLeaves, const Ray_t& ray, float maxDistance, bool anyHit, RayHit_t& hit);
+
+#if FE_SIMD_SSE
+static SimdDispatch<TraverseKernel_t> traverse(Traverse_Scalar, Traverse_SSE);
+#else
+static SimdDispatch<TraverseKernel_t> traverse(Traverse_Scalar);
+#endif
+
+// ===============================================
+// Public interface
+// ===============================================
+bool BVH4::Raycast(const Ray_t& ray, float maxDistance, RayHit_t& hit) const {
+	if (m_Nodes.empty())
+		return false;
+
+	// Empty children would be hit at infinity otherwise.
+	maxDistance = maxDistance < FLT_MAX ? maxDistance : FLT_MAX;
+
+	return traverse(m_Nodes.data(), m_Leaves.data(), ray, maxDistance, false, hit);
+}
+
+bool BVH4::Occluded(const Ray_t& ray, float maxDistance) const {
+	if (m_Nodes.empty())
+		return false;
+
+	maxDistance = maxDistance < FLT_MAX ? maxDistance : FLT_MAX;
+
+	RayHit_t hit;
+	return traverse(m_Nodes.data(), m_Leaves.data(), ray, maxDistance, true, hit);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "intersect.h"
+
+#include <vector>
+
+namespace fe::math {
+
+// Four wide bounding volume hierarchy over a triangle mesh.
+//	Each node holds the boxes of its four children in one AABBx4_t, so a
+//	ray tests all of them with a single IntersectRayAABBx4. Leaves hold up
+//	to four triangles in the same layout.
+
+struct BVH4Node_t {
+	// A child is a node index, LeafFlag | leaf index, or EmptyChild.
+	//	Empty children have EmptyAABB bounds so rays never enter them.
+	static constexpr uint32_t LeafFlag = 0x80000000u;
+	static constexpr uint32_t EmptyChild = 0xFFFFFFFFu;
+
+	AABBx4_t bounds;
+	uint32_t children[4];
+};
+
+struct BVH4Leaf_t {
+	static constexpr uint32_t EmptyTriangle = 0xFFFFFFFFu;
+
+	alignas(16) float v0X[4], v0Y[4], v0Z[4];
+	alignas(16) float v1X[4], v1Y[4], v1Z[4];
+	alignas(16) float v2X[4], v2Y[4], v2Z[4];
+	// Index of each triangle in the mesh, the unused lanes are degenerate
+	//	triangles at the origin with EmptyTriangle here.
+	uint32_t triangles[4];
+};
+
+struct RayHit_t {
+	float distance;
+	float u, v; // Barycentric weights of the second and third vertex.
+	uint32_t triangle;
+};
+
+class BVH4 {
+public:
+	// Triangle i uses the positions at pIndices[i * 3 + 0..2]. Splits at the
+	//	centroid median of the longest axis, which keeps the tree balanced.
+	void Build(const Vector3* pPositions, const uint32_t* pIndices, size_t numTriangles);
+	void Clear();
+
+	// Closest hit, ties go to the triangle found first.
+	bool Raycast(const Ray_t& ray, float maxDistance, RayHit_t& hit) const;
+	// Stops at the first hit, for line of sight checks.
+	bool Occluded(const Ray_t& ray, float maxDistance) const;
+
+	const AABB_t& GetBounds() const { return m_Bounds; }
+
+	// Node 0 is the root. For custom traversals with the packet tests.
+	const std::vector<BVH4Node_t>& GetNodes() const { return m_Nodes; }
+	const std::vector<BVH4Leaf_t>& GetLeaves() const { return m_Leaves; }
+
+private:
+	std::vector<BVH4Node_t> m_Nodes;
+	std::vector<BVH4Leaf_t> m_Leaves;
+	AABB_t m_Bounds = EmptyAABB;
+};
+
+}
\ No newline at end of file
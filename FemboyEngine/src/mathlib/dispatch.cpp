@@ -0,0 +1,80 @@
+#include "dispatch.h"
+
+#include <cctype>
+
+namespace fe::math {
+
+#if FE_SIMD_AVX2
+static SimdLevel::Enum s_SimdLevel = SimdLevel::AVX2;
+#elif FE_SIMD_SSE
+static SimdLevel::Enum s_SimdLevel = SimdLevel::SSE2;
+#else
+static SimdLevel::Enum s_SimdLevel = SimdLevel::Scalar;
+#endif
+
+// Wrap this into a function so the list head exists before the first
+//	static SimdDispatch registers itself.
+static SimdDispatchBase*& GetDispatchListHead() {
+	static SimdDispatchBase* pHead = nullptr;
+
+	return pHead;
+}
+
+static const char* const simdLevelNames[SimdLevel::Count] = {
+	"Scalar",
+	"SSE2",
+	"AVX2",
+	"AVX512",
+};
+
+const char* GetSimdLevelName(SimdLevel::Enum level) {
+	if (level >= SimdLevel::Count)
+		return "Unknown";
+
+	return simdLevelNames[level];
+}
+
+bool ParseSimdLevel(const char* name, SimdLevel::Enum& level) {
+	for (uint32_t i = 0; i < SimdLevel::Count; i++) {
+		const char* pExpected = simdLevelNames[i];
+		const char* pActual = name;
+
+		while (*pExpected && tolower(*pExpected) == tolower(*pActual)) {
+			pExpected++;
+			pActual++;
+		}
+
+		if (*pExpected == '\0' && *pActual == '\0') {
+			level = static_cast<SimdLevel::Enum>(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+SimdLevel::Enum GetSimdLevel() {
+	return s_SimdLevel;
+}
+
+void SetSimdLevel(SimdLevel::Enum level) {
+#if !FE_SIMD_SSE
+	level = SimdLevel::Scalar;
+#endif
+
+	s_SimdLevel = level;
+
+	for (SimdDispatchBase* pDispatch = GetDispatchListHead(); pDispatch; pDispatch = pDispatch->m_pNext) {
+		pDispatch->Bind(level);
+	}
+}
+
+SimdDispatchBase::SimdDispatchBase() {
+	m_ActiveLevel = SimdLevel::Scalar;
+
+	SimdDispatchBase*& pHead = GetDispatchListHead();
+	m_pNext = pHead;
+	pHead = this;
+}
+
+}
\ No newline at end of file
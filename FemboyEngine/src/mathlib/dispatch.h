@@ -0,0 +1,100 @@
+#pragma once
+
+#include "simd.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace fe::math {
+
+// Instruction set tiers for kernels that are picked at runtime.
+struct SimdLevel {
+	enum Enum : uint32_t {
+		Scalar,
+		SSE2,
+		AVX2, // Also implies FMA and F16C.
+		AVX512,
+		Count
+	};
+};
+
+const char* GetSimdLevelName(SimdLevel::Enum level);
+
+// Accepts the names returned by GetSimdLevelName, case insensitive.
+bool ParseSimdLevel(const char* name, SimdLevel::Enum& level);
+
+SimdLevel::Enum GetSimdLevel();
+
+// Rebinds every dispatched kernel to the best implementation at or below level.
+//	This is not thread safe, call it during startup before any kernel runs
+//	on another thread.
+void SetSimdLevel(SimdLevel::Enum level);
+
+class SimdDispatchBase {
+	friend void SetSimdLevel(SimdLevel::Enum level);
+
+public:
+	SimdDispatchBase();
+	virtual ~SimdDispatchBase() = default;
+
+	SimdLevel::Enum GetActiveLevel() const {
+		return m_ActiveLevel;
+	}
+
+protected:
+	virtual void Bind(SimdLevel::Enum level) = 0;
+
+	SimdLevel::Enum m_ActiveLevel;
+
+private:
+	SimdDispatchBase* m_pNext;
+};
+
+// Holds one implementation of a kernel per SimdLevel. Missing ones are
+//	nullptr and fall back to the next lower level, scalar is required.
+//	Instances must have static storage duration, they register themselves
+//	with SetSimdLevel on construction.
+template<typename Fn>
+class SimdDispatch : public SimdDispatchBase {
+public:
+	SimdDispatch(Fn pScalar, Fn pSSE2 = nullptr, Fn pAVX2 = nullptr, Fn pAVX512 = nullptr)
+		: m_pImplementations{ pScalar, pSSE2, pAVX2, pAVX512 }
+	{
+		Bind(GetSimdLevel());
+	}
+
+	template<typename... Args>
+	FE_FORCEINLINE decltype(auto) operator()(Args&&... args) const {
+		return m_pActive(std::forward<Args>(args)...);
+	}
+
+	Fn Get() const {
+		return m_pActive;
+	}
+
+protected:
+	virtual void Bind(SimdLevel::Enum level) {
+		uint32_t index = level;
+
+		while (index > 0 && !m_pImplementations[index]) {
+			index--;
+		}
+
+		m_ActiveLevel = static_cast<SimdLevel::Enum>(index);
+		m_pActive = m_pImplementations[index];
+	}
+
+private:
+	Fn m_pImplementations[SimdLevel::Count];
+	Fn m_pActive;
+};
+
+// Expands to the scalar, SSE2 and AVX2 variants of a kernel for the
+//	SimdDispatch constructor, following the Name_Scalar/_SSE/_AVX2 convention.
+#if FE_SIMD_SSE
+#define FE_SIMD_VARIANTS(name) name##_Scalar, name##_SSE, name##_AVX2
+#else
+#define FE_SIMD_VARIANTS(name) name##_Scalar
+#endif
+
+}
\ No newline at end of file
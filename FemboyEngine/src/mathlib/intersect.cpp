@@ -0,0 +1,428 @@
+#include "intersect.h"
+#include "wideintersect.h"
+#include "dispatch.h"
+
+#include <cfloat>
+
+namespace fe::math {
+
+constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+// An infinite max distance would let rays hit EmptyAABB at infinity.
+static float ClampMaxDistance(float maxDistance) {
+	return maxDistance < FLT_MAX ? maxDistance : FLT_MAX;
+}
+
+// Same NaN handling as _mm_min_ps and _mm_max_ps.
+static float MinLane(float a, float b) {
+	return a < b ? a : b;
+}
+
+static float MaxLane(float a, float b) {
+	return a > b ? a : b;
+}
+
+// ===============================================
+// Single tests
+// ===============================================
+bool IntersectRayAABB(const Ray_t& ray, const AABB_t& box, float maxDistance, float& distance) {
+	float tNear = 0.f;
+	float tFar = ClampMaxDistance(maxDistance);
+
+	for (size_t i = 0; i < 3; i++) {
+		float invDirection = 1.f / ray.direction[i];
+		float t1 = (box.min[i] - ray.origin[i]) * invDirection;
+		float t2 = (box.max[i] - ray.origin[i]) * invDirection;
+
+		tNear = MaxLane(MinLane(t1, t2), tNear);
+		tFar = MinLane(MaxLane(t1, t2), tFar);
+	}
+
+	distance = tNear;
+
+	return tNear <= tFar;
+}
+
+bool IntersectRaySphere(const Ray_t& ray, const Sphere_t& sphere, float maxDistance, float& distance) {
+	Vector3 oc = ray.origin - sphere.center;
+	float a = DotProduct(ray.direction, ray.direction);
+	float b = DotProduct(oc, ray.direction);
+	float c = DotProduct(oc, oc) - sphere.radius * sphere.radius;
+	float discriminant = b * b - a * c;
+
+	if (!(discriminant >= 0.f))
+		return false;
+
+	float root = Sqrt(discriminant);
+	float tNear = MaxLane((-b - root) / a, 0.f);
+	float tFar = (-b + root) / a;
+
+	distance = tNear;
+
+	return tFar >= 0.f && tNear <= ClampMaxDistance(maxDistance);
+}
+
+bool IntersectRayPlane(const Ray_t& ray, const Plane_t& plane, float maxDistance, float& distance) {
+	float t = (plane.distance - DotProduct(plane.normal, ray.origin)) / DotProduct(plane.normal, ray.direction);
+
+	distance = t;
+
+	return t >= 0.f && t <= ClampMaxDistance(maxDistance);
+}
+
+bool IntersectRayTriangle(const Ray_t& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float& distance, float& u, float& v) {
+	Vector3 e1 = v1 - v0;
+	Vector3 e2 = v2 - v0;
+	Vector3 p = CrossProduct(ray.direction, e2);
+	float invDet = 1.f / DotProduct(e1, p);
+
+	// A zero determinant makes the barycentrics infinite or NaN, which
+	//	fails the range checks below without a separate test.
+	Vector3 s = ray.origin - v0;
+	Vector3 q = CrossProduct(s, e1);
+	u = DotProduct(s, p) * invDet;
+	v = DotProduct(ray.direction, q) * invDet;
+	distance = DotProduct(e2, q) * invDet;
+
+	return u >= 0.f && v >= 0.f && u + v <= 1.f && distance >= 0.f && distance <= ClampMaxDistance(maxDistance);
+}
+
+// ===============================================
+// Packet setup
+// ===============================================
+template<typename Packet>
+static void SetAABBLane(Packet& boxes, size_t lane, const AABB_t& box) {
+	boxes.minX[lane] = box.min.x;
+	boxes.minY[lane] = box.min.y;
+	boxes.minZ[lane] = box.min.z;
+	boxes.maxX[lane] = box.max.x;
+	boxes.maxY[lane] = box.max.y;
+	boxes.maxZ[lane] = box.max.z;
+}
+
+template<typename Packet>
+static void SetSphereLane(Packet& spheres, size_t lane, const Sphere_t& sphere) {
+	spheres.centerX[lane] = sphere.center.x;
+	spheres.centerY[lane] = sphere.center.y;
+	spheres.centerZ[lane] = sphere.center.z;
+	spheres.radius[lane] = sphere.radius;
+}
+
+template<typename Packet>
+static void SetRayLane(Packet& rays, size_t lane, const Ray_t& ray) {
+	rays.originX[lane] = ray.origin.x;
+	rays.originY[lane] = ray.origin.y;
+	rays.originZ[lane] = ray.origin.z;
+	rays.directionX[lane] = ray.direction.x;
+	rays.directionY[lane] = ray.direction.y;
+	rays.directionZ[lane] = ray.direction.z;
+}
+
+void SetAABB(AABBx4_t& boxes, size_t lane, const AABB_t& box) { SetAABBLane(boxes, lane, box); }
+void SetAABB(AABBx8_t& boxes, size_t lane, const AABB_t& box) { SetAABBLane(boxes, lane, box); }
+void SetSphere(Spherex4_t& spheres, size_t lane, const Sphere_t& sphere) { SetSphereLane(spheres, lane, sphere); }
+void SetSphere(Spherex8_t& spheres, size_t lane, const Sphere_t& sphere) { SetSphereLane(spheres, lane, sphere); }
+void SetRay(RayPacket4_t& rays, size_t lane, const Ray_t& ray) { SetRayLane(rays, lane, ray); }
+void SetRay(RayPacket8_t& rays, size_t lane, const Ray_t& ray) { SetRayLane(rays, lane, ray); }
+
+// ===============================================
+// Scalar implementations
+// ===============================================
+template<size_t Lanes, typename Packet>
+static uint32_t RayAABBPacket_Scalar(const Ray_t& ray, const Packet& boxes, float maxDistance, float* pDistances) {
+	uint32_t mask = 0;
+
+	for (size_t i = 0; i < Lanes; i++) {
+		AABB_t box = { Vector3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]), Vector3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]) };
+		float distance;
+
+		bool hit = IntersectRayAABB(ray, box, maxDistance, distance);
+		pDistances[i] = hit ? distance : Infinity;
+		mask |= static_cast<uint32_t>(hit) << i;
+	}
+
+	return mask;
+}
+
+template<size_t Lanes, typename Packet>
+static uint32_t RaySpherePacket_Scalar(const Ray_t& ray, const Packet& spheres, float maxDistance, float* pDistances) {
+	uint32_t mask = 0;
+
+	for (size_t i = 0; i < Lanes; i++) {
+		Sphere_t sphere = { Vector3(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]), spheres.radius[i] };
+		float distance;
+
+		bool hit = IntersectRaySphere(ray, sphere, maxDistance, distance);
+		pDistances[i] = hit ? distance : Infinity;
+		mask |= static_cast<uint32_t>(hit) << i;
+	}
+
+	return mask;
+}
+
+template<size_t Lanes, typename Packet>
+static uint32_t PacketTriangle_Scalar(const Packet& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) {
+	uint32_t mask = 0;
+
+	for (size_t i = 0; i < Lanes; i++) {
+		Ray_t ray = { Vector3(rays.originX[i], rays.originY[i], rays.originZ[i]), Vector3(rays.directionX[i], rays.directionY[i], rays.directionZ[i]) };
+		float distance, u, v;
+
+		bool hit = IntersectRayTriangle(ray, v0, v1, v2, maxDistance, distance, u, v);
+		pDistances[i] = hit ? distance : Infinity;
+		mask |= static_cast<uint32_t>(hit) << i;
+	}
+
+	return mask;
+}
+
+template<size_t Lanes, typename Packet>
+static uint32_t PacketPlane_Scalar(const Packet& rays, const Plane_t& plane, float maxDistance, float* pDistances) {
+	uint32_t mask = 0;
+
+	for (size_t i = 0; i < Lanes; i++) {
+		Ray_t ray = { Vector3(rays.originX[i], rays.originY[i], rays.originZ[i]), Vector3(rays.directionX[i], rays.directionY[i], rays.directionZ[i]) };
+		float distance;
+
+		bool hit = IntersectRayPlane(ray, plane, maxDistance, distance);
+		pDistances[i] = hit ? distance : Infinity;
+		mask |= static_cast<uint32_t>(hit) << i;
+	}
+
+	return mask;
+}
+
+static uint32_t RayAABBx4_Scalar(const Ray_t& ray, const AABBx4_t& boxes, float maxDistance, float* pDistances) { return RayAABBPacket_Scalar<4>(ray, boxes, maxDistance, pDistances); }
+static uint32_t RayAABBx8_Scalar(const Ray_t& ray, const AABBx8_t& boxes, float maxDistance, float* pDistances) { return RayAABBPacket_Scalar<8>(ray, boxes, maxDistance, pDistances); }
+static uint32_t RaySpherex4_Scalar(const Ray_t& ray, const Spherex4_t& spheres, float maxDistance, float* pDistances) { return RaySpherePacket_Scalar<4>(ray, spheres, maxDistance, pDistances); }
+static uint32_t RaySpherex8_Scalar(const Ray_t& ray, const Spherex8_t& spheres, float maxDistance, float* pDistances) { return RaySpherePacket_Scalar<8>(ray, spheres, maxDistance, pDistances); }
+static uint32_t PacketTriangle4_Scalar(const RayPacket4_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) { return PacketTriangle_Scalar<4>(rays, v0, v1, v2, maxDistance, pDistances); }
+static uint32_t PacketTriangle8_Scalar(const RayPacket8_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) { return PacketTriangle_Scalar<8>(rays, v0, v1, v2, maxDistance, pDistances); }
+static uint32_t PacketPlane4_Scalar(const RayPacket4_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) { return PacketPlane_Scalar<4>(rays, plane, maxDistance, pDistances); }
+static uint32_t PacketPlane8_Scalar(const RayPacket8_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) { return PacketPlane_Scalar<8>(rays, plane, maxDistance, pDistances); }
+
+// ===============================================
+// SSE implementations
+// ===============================================
+// The 8 wide versions run the 4 wide lanes twice.
+#if FE_SIMD_SSE
+static FE_FORCEINLINE Vector3x4 InverseDirection_SSE(const Vector3& direction) {
+	return Vector3x4(Vector3(1.f / direction.x, 1.f / direction.y, 1.f / direction.z));
+}
+
+static FE_FORCEINLINE uint32_t StoreHits_SSE(__m128 hit, __m128 distance, float* pDistances) {
+	_mm_storeu_ps(pDistances, _mm_or_ps(_mm_and_ps(hit, distance), _mm_andnot_ps(hit, _mm_set1_ps(Infinity))));
+
+	return static_cast<uint32_t>(_mm_movemask_ps(hit));
+}
+
+static FE_FORCEINLINE uint32_t RayAABBLanes_SSE(const Vector3x4& origin, const Vector3x4& invDirection, const float* pMinXs, const float* pMinYs, const float* pMinZs,
+	const float* pMaxXs, const float* pMaxYs, const float* pMaxZs, __m128 maxDistance, float* pDistances) {
+	__m128 distance;
+	__m128 hit = IntersectRayAABB(origin, invDirection, Vector3x4::Load(pMinXs, pMinYs, pMinZs), Vector3x4::Load(pMaxXs, pMaxYs, pMaxZs), maxDistance, distance);
+
+	return StoreHits_SSE(hit, distance, pDistances);
+}
+
+static FE_FORCEINLINE uint32_t RaySphereLanes_SSE(const Vector3x4& origin, const Vector3x4& direction, const float* pCenterXs, const float* pCenterYs, const float* pCenterZs,
+	const float* pRadii, __m128 maxDistance, float* pDistances) {
+	__m128 distance;
+	__m128 hit = IntersectRaySphere(origin, direction, Vector3x4::Load(pCenterXs, pCenterYs, pCenterZs), _mm_loadu_ps(pRadii), maxDistance, distance);
+
+	return StoreHits_SSE(hit, distance, pDistances);
+}
+
+static FE_FORCEINLINE uint32_t PacketTriangleLanes_SSE(const Vector3x4& origin, const Vector3x4& direction, const Vector3& v0, const Vector3& v1, const Vector3& v2,
+	__m128 maxDistance, float* pDistances) {
+	__m128 distance, u, v;
+	__m128 hit = IntersectRayTriangle(origin, direction, Vector3x4(v0), Vector3x4(v1), Vector3x4(v2), maxDistance, distance, u, v);
+
+	return StoreHits_SSE(hit, distance, pDistances);
+}
+
+static FE_FORCEINLINE uint32_t PacketPlaneLanes_SSE(const Vector3x4& origin, const Vector3x4& direction, const Plane_t& plane, __m128 maxDistance, float* pDistances) {
+	__m128 distance;
+	__m128 hit = IntersectRayPlane(origin, direction, Vector3x4(plane.normal), _mm_set1_ps(plane.distance), maxDistance, distance);
+
+	return StoreHits_SSE(hit, distance, pDistances);
+}
+
+static uint32_t RayAABBx4_SSE(const Ray_t& ray, const AABBx4_t& boxes, float maxDistance, float* pDistances) {
+	return RayAABBLanes_SSE(Vector3x4(ray.origin), InverseDirection_SSE(ray.direction), boxes.minX, boxes.minY, boxes.minZ,
+		boxes.maxX, boxes.maxY, boxes.maxZ, _mm_set1_ps(ClampMaxDistance(maxDistance)), pDistances);
+}
+
+static uint32_t RayAABBx8_SSE(const Ray_t& ray, const AABBx8_t& boxes, float maxDistance, float* pDistances) {
+	Vector3x4 origin(ray.origin);
+	Vector3x4 invDirection = InverseDirection_SSE(ray.direction);
+	__m128 wideMaxDistance = _mm_set1_ps(ClampMaxDistance(maxDistance));
+
+	uint32_t low = RayAABBLanes_SSE(origin, invDirection, boxes.minX, boxes.minY, boxes.minZ,
+		boxes.maxX, boxes.maxY, boxes.maxZ, wideMaxDistance, pDistances);
+	uint32_t high = RayAABBLanes_SSE(origin, invDirection, boxes.minX + 4, boxes.minY + 4, boxes.minZ + 4,
+		boxes.maxX + 4, boxes.maxY + 4, boxes.maxZ + 4, wideMaxDistance, pDistances + 4);
+
+	return low | (high << 4);
+}
+
+static uint32_t RaySpherex4_SSE(const Ray_t& ray, const Spherex4_t& spheres, float maxDistance, float* pDistances) {
+	return RaySphereLanes_SSE(Vector3x4(ray.origin), Vector3x4(ray.direction), spheres.centerX, spheres.centerY, spheres.centerZ,
+		spheres.radius, _mm_set1_ps(ClampMaxDistance(maxDistance)), pDistances);
+}
+
+static uint32_t RaySpherex8_SSE(const Ray_t& ray, const Spherex8_t& spheres, float maxDistance, float* pDistances) {
+	Vector3x4 origin(ray.origin);
+	Vector3x4 direction(ray.direction);
+	__m128 wideMaxDistance = _mm_set1_ps(ClampMaxDistance(maxDistance));
+
+	uint32_t low = RaySphereLanes_SSE(origin, direction, spheres.centerX, spheres.centerY, spheres.centerZ,
+		spheres.radius, wideMaxDistance, pDistances);
+	uint32_t high = RaySphereLanes_SSE(origin, direction, spheres.centerX + 4, spheres.centerY + 4, spheres.centerZ + 4,
+		spheres.radius + 4, wideMaxDistance, pDistances + 4);
+
+	return low | (high << 4);
+}
+
+static uint32_t PacketTriangle4_SSE(const RayPacket4_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) {
+	return PacketTriangleLanes_SSE(Vector3x4::Load(rays.originX, rays.originY, rays.originZ), Vector3x4::Load(rays.directionX, rays.directionY, rays.directionZ),
+		v0, v1, v2, _mm_set1_ps(ClampMaxDistance(maxDistance)), pDistances);
+}
+
+static uint32_t PacketTriangle8_SSE(const RayPacket8_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) {
+	__m128 wideMaxDistance = _mm_set1_ps(ClampMaxDistance(maxDistance));
+
+	uint32_t low = PacketTriangleLanes_SSE(Vector3x4::Load(rays.originX, rays.originY, rays.originZ), Vector3x4::Load(rays.directionX, rays.directionY, rays.directionZ),
+		v0, v1, v2, wideMaxDistance, pDistances);
+	uint32_t high = PacketTriangleLanes_SSE(Vector3x4::Load(rays.originX + 4, rays.originY + 4, rays.originZ + 4), Vector3x4::Load(rays.directionX + 4, rays.directionY + 4, rays.directionZ + 4),
+		v0, v1, v2, wideMaxDistance, pDistances + 4);
+
+	return low | (high << 4);
+}
+
+static uint32_t PacketPlane4_SSE(const RayPacket4_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) {
+	return PacketPlaneLanes_SSE(Vector3x4::Load(rays.originX, rays.originY, rays.originZ), Vector3x4::Load(rays.directionX, rays.directionY, rays.directionZ),
+		plane, _mm_set1_ps(ClampMaxDistance(maxDistance)), pDistances);
+}
+
+static uint32_t PacketPlane8_SSE(const RayPacket8_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) {
+	__m128 wideMaxDistance = _mm_set1_ps(ClampMaxDistance(maxDistance));
+
+	uint32_t low = PacketPlaneLanes_SSE(Vector3x4::Load(rays.originX, rays.originY, rays.originZ), Vector3x4::Load(rays.directionX, rays.directionY, rays.directionZ),
+		plane, wideMaxDistance, pDistances);
+	uint32_t high = PacketPlaneLanes_SSE(Vector3x4::Load(rays.originX + 4, rays.originY + 4, rays.originZ + 4), Vector3x4::Load(rays.directionX + 4, rays.directionY + 4, rays.directionZ + 4),
+		plane, wideMaxDistance, pDistances + 4);
+
+	return low | (high << 4);
+}
+#endif
+
+// ===============================================
+// AVX2 implementations
+// ===============================================
+#if FE_SIMD_SSE
+static FE_TARGET_AVX2 FE_FORCEINLINE uint32_t StoreHits_AVX2(__m256 hit, __m256 distance, float* pDistances) {
+	_mm256_storeu_ps(pDistances, _mm256_blendv_ps(_mm256_set1_ps(Infinity), distance, hit));
+
+	return static_cast<uint32_t>(_mm256_movemask_ps(hit));
+}
+
+static FE_TARGET_AVX2 uint32_t RayAABBx8_AVX2(const Ray_t& ray, const AABBx8_t& boxes, float maxDistance, float* pDistances) {
+	Vector3x8 invDirection(Vector3(1.f / ray.direction.x, 1.f / ray.direction.y, 1.f / ray.direction.z));
+	__m256 distance;
+	__m256 hit = IntersectRayAABB(Vector3x8(ray.origin), invDirection, Vector3x8::Load(boxes.minX, boxes.minY, boxes.minZ), Vector3x8::Load(boxes.maxX, boxes.maxY, boxes.maxZ),
+		_mm256_set1_ps(ClampMaxDistance(maxDistance)), distance);
+
+	return StoreHits_AVX2(hit, distance, pDistances);
+}
+
+static FE_TARGET_AVX2 uint32_t RaySpherex8_AVX2(const Ray_t& ray, const Spherex8_t& spheres, float maxDistance, float* pDistances) {
+	__m256 distance;
+	__m256 hit = IntersectRaySphere(Vector3x8(ray.origin), Vector3x8(ray.direction), Vector3x8::Load(spheres.centerX, spheres.centerY, spheres.centerZ), _mm256_loadu_ps(spheres.radius),
+		_mm256_set1_ps(ClampMaxDistance(maxDistance)), distance);
+
+	return StoreHits_AVX2(hit, distance, pDistances);
+}
+
+static FE_TARGET_AVX2 uint32_t PacketTriangle8_AVX2(const RayPacket8_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) {
+	__m256 distance, u, v;
+	__m256 hit = IntersectRayTriangle(Vector3x8::Load(rays.originX, rays.originY, rays.originZ), Vector3x8::Load(rays.directionX, rays.directionY, rays.directionZ),
+		Vector3x8(v0), Vector3x8(v1), Vector3x8(v2), _mm256_set1_ps(ClampMaxDistance(maxDistance)), distance, u, v);
+
+	return StoreHits_AVX2(hit, distance, pDistances);
+}
+
+static FE_TARGET_AVX2 uint32_t PacketPlane8_AVX2(const RayPacket8_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) {
+	__m256 distance;
+	__m256 hit = IntersectRayPlane(Vector3x8::Load(rays.originX, rays.originY, rays.originZ), Vector3x8::Load(rays.directionX, rays.directionY, rays.directionZ),
+		Vector3x8(plane.normal), _mm256_set1_ps(plane.distance), _mm256_set1_ps(ClampMaxDistance(maxDistance)), distance);
+
+	return StoreHits_AVX2(hit, distance, pDistances);
+}
+#endif
+
+// ===============================================
+// Dispatch
+// ===============================================
+// The 4 wide tests have nothing to gain from AVX2, they stay on SSE.
+using RayAABBx4Kernel_t = uint32_t(*)(const Ray_t& ray, const AABBx4_t& boxes, float maxDistance, float* pDistances);
+using RayAABBx8Kernel_t = uint32_t(*)(const Ray_t& ray, const AABBx8_t& boxes, float maxDistance, float* pDistances);
+using RaySpherex4Kernel_t = uint32_t(*)(const Ray_t& ray, const Spherex4_t& spheres, float maxDistance, float* pDistances);
+using RaySpherex8Kernel_t = uint32_t(*)(const Ray_t& ray, const Spherex8_t& spheres, float maxDistance, float* pDistances);
+using PacketTriangle4Kernel_t = uint32_t(*)(const RayPacket4_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances);
+using PacketTriangle8Kernel_t = uint32_t(*)(const RayPacket8_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances);
+using PacketPlane4Kernel_t = uint32_t(*)(const RayPacket4_t& rays, const Plane_t& plane, float maxDistance, float* pDistances);
+using PacketPlane8Kernel_t = uint32_t(*)(const RayPacket8_t& rays, const Plane_t& plane, float maxDistance, float* pDistances);
+
+#if FE_SIMD_SSE
+static SimdDispatch<RayAABBx4Kernel_t> rayAABBx4(RayAABBx4_Scalar, RayAABBx4_SSE);
+static SimdDispatch<RaySpherex4Kernel_t> raySpherex4(RaySpherex4_Scalar, RaySpherex4_SSE);
+static SimdDispatch<PacketTriangle4Kernel_t> packetTriangle4(PacketTriangle4_Scalar, PacketTriangle4_SSE);
+static SimdDispatch<PacketPlane4Kernel_t> packetPlane4(PacketPlane4_Scalar, PacketPlane4_SSE);
+#else
+static SimdDispatch<RayAABBx4Kernel_t> rayAABBx4(RayAABBx4_Scalar);
+static SimdDispatch<RaySpherex4Kernel_t> raySpherex4(RaySpherex4_Scalar);
+static SimdDispatch<PacketTriangle4Kernel_t> packetTriangle4(PacketTriangle4_Scalar);
+static SimdDispatch<PacketPlane4Kernel_t> packetPlane4(PacketPlane4_Scalar);
+#endif
+
+static SimdDispatch<RayAABBx8Kernel_t> rayAABBx8(FE_SIMD_VARIANTS(RayAABBx8));
+static SimdDispatch<RaySpherex8Kernel_t> raySpherex8(FE_SIMD_VARIANTS(RaySpherex8));
+static SimdDispatch<PacketTriangle8Kernel_t> packetTriangle8(FE_SIMD_VARIANTS(PacketTriangle8));
+static SimdDispatch<PacketPlane8Kernel_t> packetPlane8(FE_SIMD_VARIANTS(PacketPlane8));
+
+// ===============================================
+// Public interface
+// ===============================================
+uint32_t IntersectRayAABBx4(const Ray_t& ray, const AABBx4_t& boxes, float maxDistance, float* pDistances) {
+	return rayAABBx4(ray, boxes, maxDistance, pDistances);
+}
+
+uint32_t IntersectRayAABBx8(const Ray_t& ray, const AABBx8_t& boxes, float maxDistance, float* pDistances) {
+	return rayAABBx8(ray, boxes, maxDistance, pDistances);
+}
+
+uint32_t IntersectRaySpherex4(const Ray_t& ray, const Spherex4_t& spheres, float maxDistance, float* pDistances) {
+	return raySpherex4(ray, spheres, maxDistance, pDistances);
+}
+
+uint32_t IntersectRaySpherex8(const Ray_t& ray, const Spherex8_t& spheres, float maxDistance, float* pDistances) {
+	return raySpherex8(ray, spheres, maxDistance, pDistances);
+}
+
+uint32_t IntersectRayPacketTriangle(const RayPacket4_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) {
+	return packetTriangle4(rays, v0, v1, v2, maxDistance, pDistances);
+}
+
+uint32_t IntersectRayPacketTriangle(const RayPacket8_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances) {
+	return packetTriangle8(rays, v0, v1, v2, maxDistance, pDistances);
+}
+
+uint32_t IntersectRayPacketPlane(const RayPacket4_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) {
+	return packetPlane4(rays, plane, maxDistance, pDistances);
+}
+
+uint32_t IntersectRayPacketPlane(const RayPacket8_t& rays, const Plane_t& plane, float maxDistance, float* pDistances) {
+	return packetPlane8(rays, plane, maxDistance, pDistances);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cstdint>
+
+namespace fe::math {
+
+// Ray queries for picking and line of sight checks.
+//	Distances are in units of the ray direction length, so they are world
+//	distances when the direction is normalized. A ray starting inside a box
+//	or sphere hits it at distance 0. Triangles are two sided.
+
+struct Ray_t {
+	Vector3 origin;
+	Vector3 direction;
+};
+
+struct AABB_t {
+	Vector3 min;
+	Vector3 max;
+};
+
+struct Sphere_t {
+	Vector3 center;
+	float radius;
+};
+
+// Points p on the plane satisfy DotProduct(normal, p) == distance.
+struct Plane_t {
+	Vector3 normal;
+	float distance;
+};
+
+// ===============================================
+// Single tests
+// ===============================================
+bool IntersectRayAABB(const Ray_t& ray, const AABB_t& box, float maxDistance, float& distance);
+bool IntersectRaySphere(const Ray_t& ray, const Sphere_t& sphere, float maxDistance, float& distance);
+bool IntersectRayPlane(const Ray_t& ray, const Plane_t& plane, float maxDistance, float& distance);
+
+// Möller-Trumbore, u and v are the barycentric weights of v1 and v2.
+bool IntersectRayTriangle(const Ray_t& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float& distance, float& u, float& v);
+
+// ===============================================
+// Packets
+// ===============================================
+// Objects and rays in structure of arrays layout, one array per component.
+//	Unused box lanes should be set to EmptyAABB so they never hit.
+
+struct AABBx4_t {
+	alignas(16) float minX[4], minY[4], minZ[4];
+	alignas(16) float maxX[4], maxY[4], maxZ[4];
+};
+
+struct AABBx8_t {
+	alignas(32) float minX[8], minY[8], minZ[8];
+	alignas(32) float maxX[8], maxY[8], maxZ[8];
+};
+
+struct Spherex4_t {
+	alignas(16) float centerX[4], centerY[4], centerZ[4], radius[4];
+};
+
+struct Spherex8_t {
+	alignas(32) float centerX[8], centerY[8], centerZ[8], radius[8];
+};
+
+struct RayPacket4_t {
+	alignas(16) float originX[4], originY[4], originZ[4];
+	alignas(16) float directionX[4], directionY[4], directionZ[4];
+};
+
+struct RayPacket8_t {
+	alignas(32) float originX[8], originY[8], originZ[8];
+	alignas(32) float directionX[8], directionY[8], directionZ[8];
+};
+
+// A point at infinity. An inverted box would still be hit because the slab
+//	test sorts the planes of each axis.
+constexpr AABB_t EmptyAABB = {
+	Vector3(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()),
+	Vector3(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity())
+};
+
+void SetAABB(AABBx4_t& boxes, size_t lane, const AABB_t& box);
+void SetAABB(AABBx8_t& boxes, size_t lane, const AABB_t& box);
+void SetSphere(Spherex4_t& spheres, size_t lane, const Sphere_t& sphere);
+void SetSphere(Spherex8_t& spheres, size_t lane, const Sphere_t& sphere);
+void SetRay(RayPacket4_t& rays, size_t lane, const Ray_t& ray);
+void SetRay(RayPacket8_t& rays, size_t lane, const Ray_t& ray);
+
+// Packet tests return a mask with bit i set when lane i hits. pDistances gets
+//	one distance per lane, infinity for the lanes that missed. Each lane does
+//	the math of the single test, picked through the SIMD dispatch. GCC and
+//	Clang fuse multiply-adds in the AVX2 versions, so their distances can
+//	differ in the last bits. For many objects keep them in packets and walk
+//	the array, or use a BVH4.
+
+// One ray against 4 or 8 boxes.
+uint32_t IntersectRayAABBx4(const Ray_t& ray, const AABBx4_t& boxes, float maxDistance, float* pDistances);
+uint32_t IntersectRayAABBx8(const Ray_t& ray, const AABBx8_t& boxes, float maxDistance, float* pDistances);
+
+// One ray against 4 or 8 spheres.
+uint32_t IntersectRaySpherex4(const Ray_t& ray, const Spherex4_t& spheres, float maxDistance, float* pDistances);
+uint32_t IntersectRaySpherex8(const Ray_t& ray, const Spherex8_t& spheres, float maxDistance, float* pDistances);
+
+// 4 or 8 rays against one triangle.
+uint32_t IntersectRayPacketTriangle(const RayPacket4_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances);
+uint32_t IntersectRayPacketTriangle(const RayPacket8_t& rays, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, float* pDistances);
+
+// 4 or 8 rays against one plane.
+uint32_t IntersectRayPacketPlane(const RayPacket4_t& rays, const Plane_t& plane, float maxDistance, float* pDistances);
+uint32_t IntersectRayPacketPlane(const RayPacket8_t& rays, const Plane_t& plane, float maxDistance, float* pDistances);
+
+}
\ No newline at end of file
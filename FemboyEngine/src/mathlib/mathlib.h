@@ -1,9 +1,87 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 namespace fe::math {
 
 constexpr float Pi = 3.141592653f;
 constexpr float Deg2Rad = Pi / 180.f;
 constexpr float Rad2Deg = 180.f / Pi;
 
+namespace detail {
+
+// Compile time versions of the libm functions we need for building
+//	matrices from constants, <cmath> is not constexpr until C++26.
+constexpr double ConstexprSqrt(double x) {
+	if (!(x > 0.0))
+		return x == 0.0 ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+
+	double guess = x > 1.0 ? x : 1.0;
+	double previous = 0.0;
+
+	for (int i = 0; i < 64 && guess != previous; i++) {
+		previous = guess;
+		guess = 0.5 * (guess + x / guess);
+	}
+
+	return guess;
+}
+
+// Taylor series after reducing the angle to [-pi, pi].
+constexpr double ConstexprSin(double x) {
+	constexpr double twoPi = 6.283185307179586;
+
+	x -= twoPi * static_cast<double>(static_cast<long long>(x / twoPi));
+	if (x > twoPi * 0.5)
+		x -= twoPi;
+	else if (x < -twoPi * 0.5)
+		x += twoPi;
+
+	double term = x;
+	double result = x;
+
+	for (int i = 1; i < 16; i++) {
+		term *= -x * x / ((2.0 * i) * (2.0 * i + 1.0));
+		result += term;
+	}
+
+	return result;
+}
+
+constexpr double ConstexprCos(double x) {
+	return ConstexprSin(x + 1.5707963267948966);
+}
+
+}
+
+constexpr float Sqrt(float x) {
+	if (std::is_constant_evaluated())
+		return static_cast<float>(detail::ConstexprSqrt(x));
+
+	return sqrtf(x);
+}
+
+constexpr float Sin(float x) {
+	if (std::is_constant_evaluated())
+		return static_cast<float>(detail::ConstexprSin(x));
+
+	return sinf(x);
+}
+
+constexpr float Cos(float x) {
+	if (std::is_constant_evaluated())
+		return static_cast<float>(detail::ConstexprCos(x));
+
+	return cosf(x);
+}
+
+constexpr float Tan(float x) {
+	if (std::is_constant_evaluated())
+		return static_cast<float>(detail::ConstexprSin(x) / detail::ConstexprCos(x));
+
+	return tanf(x);
+}
+
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "vector.h"
 
 #include <memory>
+#include <cstring>
 
 namespace fe::math {
 
@@ -10,6 +11,14 @@ class Matrix3x3 {
 public:
 	Vector3 m[3];
 
+	constexpr Vector3& operator[](size_t index) {
+		return m[index];
+	}
+
+	constexpr const Vector3& operator[](size_t index) const {
+		return m[index];
+	}
+
 	constexpr Matrix3x3() = default;
 
 	constexpr Matrix3x3(const Vector3& m0, const Vector3& m1, const Vector3& m2) {
@@ -23,6 +32,18 @@ class Matrix3x4 {
 public:
 	Vector4 m[3];
 
+	constexpr Vector4& operator[](size_t index) {
+		return m[index];
+	}
+
+	constexpr const Vector4& operator[](size_t index) const {
+		return m[index];
+	}
+
+	void Copy(float* pDst) {
+		memcpy(pDst, &m[0].x, sizeof(float) * 3 * 4);
+	}
+
 	constexpr Matrix3x4() = default;
 
 	constexpr Matrix3x4(const Vector4& m0, const Vector4& m1, const Vector4& m2) {
@@ -30,17 +51,29 @@ public:
 		m[1] = m1;
 		m[2] = m2;
 	}
+
+	static constexpr Matrix3x4 Identity() {
+		return Matrix3x4(
+			Vector4(1.f, 0.f, 0.f, 0.f),
+			Vector4(0.f, 1.f, 0.f, 0.f),
+			Vector4(0.f, 0.f, 1.f, 0.f)
+		);
+	}
+
+	constexpr Matrix3x4 operator*(const Matrix3x4& B) const;
+
+	constexpr bool operator==(const Matrix3x4& B) const = default;
 };
 
-class Matrix4x4 {
+class alignas(SimdAlignment) Matrix4x4 {
 public:
 	Vector4 m[4];
 
-	Vector4& operator[](size_t index) {
+	constexpr Vector4& operator[](size_t index) {
 		return m[index];
 	}
 
-	const Vector4& operator[](size_t index) const {
+	constexpr const Vector4& operator[](size_t index) const {
 		return m[index];
 	}
 
@@ -56,14 +89,728 @@ public:
 		m[2] = m2;
 		m[3] = m3;
 	}
+
+	// Expands an affine matrix, the last row becomes (0, 0, 0, 1).
+	explicit constexpr Matrix4x4(const Matrix3x4& affine) {
+		m[0] = affine[0];
+		m[1] = affine[1];
+		m[2] = affine[2];
+		m[3] = Vector4(0.f, 0.f, 0.f, 1.f);
+	}
+
+	static constexpr Matrix4x4 Identity() {
+		return Matrix4x4(
+			Vector4(1.f, 0.f, 0.f, 0.f),
+			Vector4(0.f, 1.f, 0.f, 0.f),
+			Vector4(0.f, 0.f, 1.f, 0.f),
+			Vector4(0.f, 0.f, 0.f, 1.f)
+		);
+	}
+
+	constexpr Matrix4x4 operator*(const Matrix4x4& B) const;
+	constexpr Vector4 operator*(const Vector4& v) const;
+	constexpr Matrix4x4& operator*=(const Matrix4x4& B);
+
+	constexpr Matrix4x4 operator+(const Matrix4x4& B) const { return Matrix4x4(m[0] + B[0], m[1] + B[1], m[2] + B[2], m[3] + B[3]); }
+	constexpr Matrix4x4 operator-(const Matrix4x4& B) const { return Matrix4x4(m[0] - B[0], m[1] - B[1], m[2] - B[2], m[3] - B[3]); }
+	constexpr Matrix4x4 operator*(float s) const { return Matrix4x4(m[0] * s, m[1] * s, m[2] * s, m[3] * s); }
+
+	constexpr Matrix4x4& operator+=(const Matrix4x4& B) { return *this = *this + B; }
+	constexpr Matrix4x4& operator-=(const Matrix4x4& B) { return *this = *this - B; }
+	constexpr Matrix4x4& operator*=(float s) { return *this = *this * s; }
+
+	constexpr bool operator==(const Matrix4x4& B) const = default;
 };
 
-Matrix4x4 MakePerspectiveFovRH(float fov, float aspect, float nearPlane, float farPlane);
-Matrix4x4 MakePerspectiveFovLH(float fov, float aspect, float nearPlane, float farPlane);
-Matrix4x4 MakeLookToRH(const Vector3& eyePosition, const Vector3& forward, const Vector3& up);
-Matrix4x4 MakeLookAtRH(const Vector3& eyePosition, const Vector3& focusPoint, const Vector3& up);
+// ===============================================
+// Scalar reference implementations
+// ===============================================
+// These are used for constant evaluation, when FE_MATH_NO_SIMD is defined
+//	and for validating the SIMD paths, which produce the same results.
+constexpr Matrix4x4 MakePerspectiveFovRH_Scalar(float fov, float aspect, float nearPlane, float farPlane) {
+	float halfFov = 1.f / Tan(fov * 0.5f);
+
+	return Matrix4x4(
+		Vector4(halfFov * aspect, 0.f, 0.f, 0.f),
+		Vector4(0.f, halfFov, 0.f, 0.f),
+		Vector4(0.f, 0.f, -(farPlane + nearPlane) / (farPlane - nearPlane), (-2.f * farPlane * nearPlane) / (farPlane - nearPlane)),
+		Vector4(0.f, 0.f, -1.f, 0.f)
+	);
+}
+
+constexpr Matrix4x4 MakeLookToRH_Scalar(const Vector3& eyePosition, const Vector3& f, const Vector3& up) {
+	Vector3 r = CrossProduct(f, up);
+	Vector3 u = CrossProduct(r, f);
+
+	return Matrix4x4(
+		Vector4(-r.x, r.y, r.z, DotProduct(eyePosition, r)),
+		Vector4(u.x, u.y, u.z, DotProduct(eyePosition, u)),
+		Vector4(f.x, f.y, f.z, DotProduct(eyePosition, f)),
+		Vector4(0.f, 0.f, 0.f, 1.f)
+	);
+}
+
+// Each result row is a linear combination of the rows of B,
+//	weighted by the matching row of A.
+constexpr Matrix4x4 MatrixMultiply_Scalar(const Matrix4x4& A, const Matrix4x4& B) {
+	Matrix4x4 result;
+
+	for (int i = 0; i < 4; i++) {
+		result[i] = B[0] * A[i].x + B[1] * A[i].y + B[2] * A[i].z + B[3] * A[i].w;
+	}
+
+	return result;
+}
+
+constexpr Matrix4x4 TransposeMatrix_Scalar(const Matrix4x4& v) {
+	return Matrix4x4(
+		Vector4(v[0].x, v[1].x, v[2].x, v[3].x),
+		Vector4(v[0].y, v[1].y, v[2].y, v[3].y),
+		Vector4(v[0].z, v[1].z, v[2].z, v[3].z),
+		Vector4(v[0].w, v[1].w, v[2].w, v[3].w)
+	);
+}
+
+constexpr Vector4 TransformVector_Scalar(const Matrix4x4& M, const Vector4& v) {
+	return Vector4(DotProduct(M[0], v), DotProduct(M[1], v), DotProduct(M[2], v), DotProduct(M[3], v));
+}
+
+// Same as MatrixMultiply_Scalar with an implicit (0, 0, 0, 1) last row.
+constexpr Matrix3x4 AffineMultiply_Scalar(const Matrix3x4& A, const Matrix3x4& B) {
+	Matrix3x4 result;
+
+	for (int i = 0; i < 3; i++) {
+		result[i] = B[0] * A[i].x + B[1] * A[i].y + B[2] * A[i].z + Vector4(0.f, 0.f, 0.f, A[i].w);
+	}
+
+	return result;
+}
+
+// Cofactor expansion through the 2x2 sub-determinants of the top and
+//	bottom row pairs.
+constexpr Matrix4x4 InverseMatrix_Scalar(const Matrix4x4& M, float* pDeterminant) {
+	const Vector4& a0 = M[0];
+	const Vector4& a1 = M[1];
+	const Vector4& a2 = M[2];
+	const Vector4& a3 = M[3];
+
+	float s0 = a0.x * a1.y - a1.x * a0.y;
+	float s1 = a0.x * a1.z - a1.x * a0.z;
+	float s2 = a0.x * a1.w - a1.x * a0.w;
+	float s3 = a0.y * a1.z - a1.y * a0.z;
+	float s4 = a0.y * a1.w - a1.y * a0.w;
+	float s5 = a0.z * a1.w - a1.z * a0.w;
+
+	float c5 = a2.z * a3.w - a3.z * a2.w;
+	float c4 = a2.y * a3.w - a3.y * a2.w;
+	float c3 = a2.y * a3.z - a3.y * a2.z;
+	float c2 = a2.x * a3.w - a3.x * a2.w;
+	float c1 = a2.x * a3.z - a3.x * a2.z;
+	float c0 = a2.x * a3.y - a3.x * a2.y;
+
+	float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	float invDet = 1.f / det;
+
+	*pDeterminant = det;
+
+	return Matrix4x4(
+		Vector4(
+			(a1.y * c5 - a1.z * c4 + a1.w * c3) * invDet,
+			(-a0.y * c5 + a0.z * c4 - a0.w * c3) * invDet,
+			(a3.y * s5 - a3.z * s4 + a3.w * s3) * invDet,
+			(-a2.y * s5 + a2.z * s4 - a2.w * s3) * invDet
+		),
+		Vector4(
+			(-a1.x * c5 + a1.z * c2 - a1.w * c1) * invDet,
+			(a0.x * c5 - a0.z * c2 + a0.w * c1) * invDet,
+			(-a3.x * s5 + a3.z * s2 - a3.w * s1) * invDet,
+			(a2.x * s5 - a2.z * s2 + a2.w * s1) * invDet
+		),
+		Vector4(
+			(a1.x * c4 - a1.y * c2 + a1.w * c0) * invDet,
+			(-a0.x * c4 + a0.y * c2 - a0.w * c0) * invDet,
+			(a3.x * s4 - a3.y * s2 + a3.w * s0) * invDet,
+			(-a2.x * s4 + a2.y * s2 - a2.w * s0) * invDet
+		),
+		Vector4(
+			(-a1.x * c3 + a1.y * c1 - a1.z * c0) * invDet,
+			(a0.x * c3 - a0.y * c1 + a0.z * c0) * invDet,
+			(-a3.x * s3 + a3.y * s1 - a3.z * s0) * invDet,
+			(a2.x * s3 - a2.y * s1 + a2.z * s0) * invDet
+		)
+	);
+}
+
+// The last row must be (0, 0, 0, 1). The 3x3 part is inverted with
+//	cofactors and applied to the negated translation.
+constexpr Matrix4x4 InverseAffineMatrix_Scalar(const Matrix4x4& M, float* pDeterminant) {
+	Vector3 r0 = M[0].XYZ();
+	Vector3 r1 = M[1].XYZ();
+	Vector3 r2 = M[2].XYZ();
+
+	// These are the columns of the inverse 3x3 part scaled by det.
+	Vector3 c0 = CrossProduct(r1, r2);
+	Vector3 c1 = CrossProduct(r2, r0);
+	Vector3 c2 = CrossProduct(r0, r1);
+
+	float det = DotProduct(r0, c0);
+	float invDet = 1.f / det;
+
+	*pDeterminant = det;
+
+	Vector3 i0 = Vector3(c0.x, c1.x, c2.x) * invDet;
+	Vector3 i1 = Vector3(c0.y, c1.y, c2.y) * invDet;
+	Vector3 i2 = Vector3(c0.z, c1.z, c2.z) * invDet;
+
+	Vector3 t(M[0].w, M[1].w, M[2].w);
+
+	return Matrix4x4(
+		Vector4(i0, -DotProduct(i0, t)),
+		Vector4(i1, -DotProduct(i1, t)),
+		Vector4(i2, -DotProduct(i2, t)),
+		Vector4(0.f, 0.f, 0.f, 1.f)
+	);
+}
+
+// The 3x3 part must be orthonormal, the inverse is its transpose applied
+//	to the negated translation.
+constexpr Matrix4x4 InverseRigidMatrix_Scalar(const Matrix4x4& M, float* pDeterminant) {
+	Vector3 r0 = M[0].XYZ();
+	Vector3 r1 = M[1].XYZ();
+	Vector3 r2 = M[2].XYZ();
+
+	*pDeterminant = DotProduct(r0, CrossProduct(r1, r2));
+
+	Vector3 i0(r0.x, r1.x, r2.x);
+	Vector3 i1(r0.y, r1.y, r2.y);
+	Vector3 i2(r0.z, r1.z, r2.z);
+
+	Vector3 t(M[0].w, M[1].w, M[2].w);
+
+	return Matrix4x4(
+		Vector4(i0, -DotProduct(i0, t)),
+		Vector4(i1, -DotProduct(i1, t)),
+		Vector4(i2, -DotProduct(i2, t)),
+		Vector4(0.f, 0.f, 0.f, 1.f)
+	);
+}
+
+// ===============================================
+// SIMD implementations
+// ===============================================
+#if FE_SIMD_SSE
+namespace detail {
+
+FE_FORCEINLINE __m128 LoadVector3(const Vector3& v) {
+	return _mm_setr_ps(v.x, v.y, v.z, 0.f);
+}
+
+// Replaces the w lane of v with the first lane of s.
+FE_FORCEINLINE __m128 InsertW(__m128 v, __m128 s) {
+	const __m128 maskXYZ = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+	return _mm_or_ps(_mm_and_ps(maskXYZ, v), _mm_andnot_ps(maskXYZ, FE_SHUFFLE(s, 0, 0, 0, 0)));
+}
+
+FE_FORCEINLINE __m128 MultiplyRow(__m128 a, __m128 b0, __m128 b1, __m128 b2, __m128 b3) {
+	__m128 result = _mm_mul_ps(FE_SHUFFLE(a, 0, 0, 0, 0), b0);
+	result = _mm_add_ps(result, _mm_mul_ps(FE_SHUFFLE(a, 1, 1, 1, 1), b1));
+	result = _mm_add_ps(result, _mm_mul_ps(FE_SHUFFLE(a, 2, 2, 2, 2), b2));
+	result = _mm_add_ps(result, _mm_mul_ps(FE_SHUFFLE(a, 3, 3, 3, 3), b3));
+
+	return result;
+}
+
+inline Matrix4x4 MakePerspectiveFovRH_SSE(float fov, float aspect, float nearPlane, float farPlane) {
+	float halfFov = 1.f / tanf(fov * 0.5f);
+
+	// Both depth terms share the same divisor, do them in one division.
+	__m128 numerator = _mm_setr_ps(-(farPlane + nearPlane), -2.f * farPlane * nearPlane, 0.f, 0.f);
+	__m128 depth = _mm_div_ps(numerator, _mm_set1_ps(farPlane - nearPlane));
+
+	Matrix4x4 result;
+	_mm_store_ps(&result[0].x, _mm_setr_ps(halfFov * aspect, 0.f, 0.f, 0.f));
+	_mm_store_ps(&result[1].x, _mm_setr_ps(0.f, halfFov, 0.f, 0.f));
+	_mm_store_ps(&result[2].x, _mm_movelh_ps(_mm_setzero_ps(), depth));
+	_mm_store_ps(&result[3].x, _mm_setr_ps(0.f, 0.f, -1.f, 0.f));
+
+	return result;
+}
+
+inline Matrix4x4 MakeLookToRH_SSE(const Vector3& eyePosition, const Vector3& forward, const Vector3& up) {
+	const __m128 negateX = _mm_setr_ps(-0.f, 0.f, 0.f, 0.f);
+
+	__m128 eye = LoadVector3(eyePosition);
+	__m128 f = LoadVector3(forward);
+	__m128 r = SimdCross3(f, LoadVector3(up));
+	__m128 u = SimdCross3(r, f);
+
+	Matrix4x4 result;
+	_mm_store_ps(&result[0].x, InsertW(_mm_xor_ps(r, negateX), SimdDot3(eye, r)));
+	_mm_store_ps(&result[1].x, InsertW(u, SimdDot3(eye, u)));
+	_mm_store_ps(&result[2].x, InsertW(f, SimdDot3(eye, f)));
+	_mm_store_ps(&result[3].x, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+
+	return result;
+}
+
+FE_FORCEINLINE Matrix4x4 MatrixMultiply_SSE(const Matrix4x4& A, const Matrix4x4& B) {
+	__m128 b0 = _mm_load_ps(&B[0].x);
+	__m128 b1 = _mm_load_ps(&B[1].x);
+	__m128 b2 = _mm_load_ps(&B[2].x);
+	__m128 b3 = _mm_load_ps(&B[3].x);
+
+	Matrix4x4 result;
+
+	for (int i = 0; i < 4; i++) {
+		_mm_store_ps(&result[i].x, MultiplyRow(_mm_load_ps(&A[i].x), b0, b1, b2, b3));
+	}
+
+	return result;
+}
+
+FE_FORCEINLINE Matrix4x4 TransposeMatrix_SSE(const Matrix4x4& v) {
+	__m128 r0 = _mm_load_ps(&v[0].x);
+	__m128 r1 = _mm_load_ps(&v[1].x);
+	__m128 r2 = _mm_load_ps(&v[2].x);
+	__m128 r3 = _mm_load_ps(&v[3].x);
+
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	Matrix4x4 result;
+	_mm_store_ps(&result[0].x, r0);
+	_mm_store_ps(&result[1].x, r1);
+	_mm_store_ps(&result[2].x, r2);
+	_mm_store_ps(&result[3].x, r3);
+
+	return result;
+}
+
+FE_FORCEINLINE Vector4 TransformVector_SSE(const Matrix4x4& M, const Vector4& v) {
+	__m128 c0 = _mm_load_ps(&M[0].x);
+	__m128 c1 = _mm_load_ps(&M[1].x);
+	__m128 c2 = _mm_load_ps(&M[2].x);
+	__m128 c3 = _mm_load_ps(&M[3].x);
+
+	// The columns of M weighted by the vector components.
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	Vector4 result;
+	_mm_store_ps(&result.x, MultiplyRow(_mm_load_ps(&v.x), c0, c1, c2, c3));
+
+	return result;
+}
+
+FE_FORCEINLINE Matrix3x4 AffineMultiply_SSE(const Matrix3x4& A, const Matrix3x4& B) {
+	__m128 b0 = _mm_load_ps(&B[0].x);
+	__m128 b1 = _mm_load_ps(&B[1].x);
+	__m128 b2 = _mm_load_ps(&B[2].x);
+	__m128 b3 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+
+	Matrix3x4 result;
+
+	for (int i = 0; i < 3; i++) {
+		_mm_store_ps(&result[i].x, MultiplyRow(_mm_load_ps(&A[i].x), b0, b1, b2, b3));
+	}
+
+	return result;
+}
+
+// 2x2 matrices are stored row major in one register as (m00, m01, m10, m11).
+FE_FORCEINLINE __m128 Matrix2Multiply(__m128 A, __m128 B) {
+	return _mm_add_ps(_mm_mul_ps(A, FE_SHUFFLE(B, 0, 3, 0, 3)), _mm_mul_ps(FE_SHUFFLE(A, 1, 0, 3, 2), FE_SHUFFLE(B, 2, 1, 2, 1)));
+}
+
+// adj(A) * B
+FE_FORCEINLINE __m128 Matrix2AdjMultiply(__m128 A, __m128 B) {
+	return _mm_sub_ps(_mm_mul_ps(FE_SHUFFLE(A, 3, 3, 0, 0), B), _mm_mul_ps(FE_SHUFFLE(A, 1, 1, 2, 2), FE_SHUFFLE(B, 2, 3, 0, 1)));
+}
+
+// A * adj(B)
+FE_FORCEINLINE __m128 Matrix2MultiplyAdj(__m128 A, __m128 B) {
+	return _mm_sub_ps(_mm_mul_ps(A, FE_SHUFFLE(B, 3, 0, 3, 0)), _mm_mul_ps(FE_SHUFFLE(A, 1, 0, 3, 2), FE_SHUFFLE(B, 2, 1, 2, 1)));
+}
+
+// Block-wise adjugate of the four 2x2 sub-matrices
+//	| A B |
+//	| C D |
+//	which shares the 2x2 cofactors between all output elements.
+inline Matrix4x4 InverseMatrix_SSE(const Matrix4x4& M, float* pDeterminant) {
+	__m128 r0 = _mm_load_ps(&M[0].x);
+	__m128 r1 = _mm_load_ps(&M[1].x);
+	__m128 r2 = _mm_load_ps(&M[2].x);
+	__m128 r3 = _mm_load_ps(&M[3].x);
+
+	__m128 A = _mm_movelh_ps(r0, r1);
+	__m128 B = _mm_movehl_ps(r1, r0);
+	__m128 C = _mm_movelh_ps(r2, r3);
+	__m128 D = _mm_movehl_ps(r3, r2);
+
+	// (|A|, |B|, |C|, |D|)
+	__m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)))
+	);
+	__m128 detA = FE_SHUFFLE(detSub, 0, 0, 0, 0);
+	__m128 detB = FE_SHUFFLE(detSub, 1, 1, 1, 1);
+	__m128 detC = FE_SHUFFLE(detSub, 2, 2, 2, 2);
+	__m128 detD = FE_SHUFFLE(detSub, 3, 3, 3, 3);
+
+	__m128 adjDC = Matrix2AdjMultiply(D, C);
+	__m128 adjAB = Matrix2AdjMultiply(A, B);
+
+	// The inverse is 1/|M| * | X Y |, these are the adjugates of X, Y, Z and W.
+	//                        | Z W |
+	__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Matrix2Multiply(B, adjDC));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Matrix2Multiply(C, adjAB));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Matrix2MultiplyAdj(D, adjAB));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Matrix2MultiplyAdj(A, adjDC));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	__m128 trace = _mm_mul_ps(adjAB, FE_SHUFFLE(adjDC, 0, 2, 1, 3));
+	trace = _mm_add_ps(trace, FE_SHUFFLE(trace, 2, 3, 0, 1));
+	trace = _mm_add_ps(trace, FE_SHUFFLE(trace, 1, 0, 3, 2));
+
+	__m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+	*pDeterminant = _mm_cvtss_f32(det);
+
+	__m128 invDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+	X = _mm_mul_ps(X, invDet);
+	Y = _mm_mul_ps(Y, invDet);
+	Z = _mm_mul_ps(Z, invDet);
+	W = _mm_mul_ps(W, invDet);
+
+	// Undo the adjugate and interleave the blocks back into rows.
+	Matrix4x4 result;
+	_mm_store_ps(&result[0].x, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_store_ps(&result[1].x, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_store_ps(&result[2].x, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_store_ps(&result[3].x, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+
+	return result;
+}
+
+// The rows of the transposed inverse 3x3 part are c0..c2, the inverse
+//	translation is -(t.x * c0 + t.y * c1 + t.z * c2). Building the transposed
+//	result and transposing once puts everything in place.
+FE_FORCEINLINE Matrix4x4 InverseAffineFromColumns(__m128 c0, __m128 c1, __m128 c2, __m128 r0, __m128 r1, __m128 r2) {
+	__m128 t = _mm_add_ps(_mm_mul_ps(c0, FE_SHUFFLE(r0, 3, 3, 3, 3)), _mm_mul_ps(c1, FE_SHUFFLE(r1, 3, 3, 3, 3)));
+	t = _mm_add_ps(t, _mm_mul_ps(c2, FE_SHUFFLE(r2, 3, 3, 3, 3)));
+	t = InsertW(_mm_sub_ps(_mm_setzero_ps(), t), _mm_set_ss(1.f));
+
+	_MM_TRANSPOSE4_PS(c0, c1, c2, t);
+
+	Matrix4x4 result;
+	_mm_store_ps(&result[0].x, c0);
+	_mm_store_ps(&result[1].x, c1);
+	_mm_store_ps(&result[2].x, c2);
+	_mm_store_ps(&result[3].x, t);
+
+	return result;
+}
+
+inline Matrix4x4 InverseAffineMatrix_SSE(const Matrix4x4& M, float* pDeterminant) {
+	__m128 r0 = _mm_load_ps(&M[0].x);
+	__m128 r1 = _mm_load_ps(&M[1].x);
+	__m128 r2 = _mm_load_ps(&M[2].x);
+
+	__m128 c0 = SimdCross3(r1, r2);
+	__m128 c1 = SimdCross3(r2, r0);
+	__m128 c2 = SimdCross3(r0, r1);
+
+	__m128 det = SimdDot3(r0, c0);
+	*pDeterminant = _mm_cvtss_f32(det);
+
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+	return InverseAffineFromColumns(_mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet), _mm_mul_ps(c2, invDet), r0, r1, r2);
+}
+
+inline Matrix4x4 InverseRigidMatrix_SSE(const Matrix4x4& M, float* pDeterminant) {
+	const __m128 maskXYZ = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+	__m128 r0 = _mm_load_ps(&M[0].x);
+	__m128 r1 = _mm_load_ps(&M[1].x);
+	__m128 r2 = _mm_load_ps(&M[2].x);
+
+	*pDeterminant = _mm_cvtss_f32(SimdDot3(r0, SimdCross3(r1, r2)));
+
+	return InverseAffineFromColumns(_mm_and_ps(r0, maskXYZ), _mm_and_ps(r1, maskXYZ), _mm_and_ps(r2, maskXYZ), r0, r1, r2);
+}
+
+#if FE_SIMD_AVX
+// Computes two result rows per iteration, one per 128-bit lane.
+FE_FORCEINLINE Matrix4x4 MatrixMultiply_AVX(const Matrix4x4& A, const Matrix4x4& B) {
+	__m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&B[0].x));
+	__m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&B[1].x));
+	__m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&B[2].x));
+	__m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&B[3].x));
+
+	Matrix4x4 result;
+
+	for (int i = 0; i < 4; i += 2) {
+		__m256 a = _mm256_loadu_ps(&A[i].x);
+
+		__m256 row = _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+
+		_mm256_storeu_ps(&result[i].x, row);
+	}
+
+	return result;
+}
+#endif
+
+}
+#endif
+
+// ===============================================
+// Public interface
+// ===============================================
+// Everything below is constexpr, matrices built from constants fold at
+//	compile time through the scalar path, runtime calls use SIMD.
+constexpr Matrix4x4 MakePerspectiveFovRH(float fov, float aspect, float nearPlane, float farPlane) {
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		return detail::MakePerspectiveFovRH_SSE(fov, aspect, nearPlane, farPlane);
+#endif
+	return MakePerspectiveFovRH_Scalar(fov, aspect, nearPlane, farPlane);
+}
+
+constexpr Matrix4x4 MakePerspectiveFovLH(float fov, float aspect, float nearPlane, float farPlane) {
+	float halfFov = 1.f / Tan(fov * 0.5f);
+
+	return Matrix4x4(
+		Vector4(halfFov * aspect, 0.f, 0.f, 0.f),
+		Vector4(0.f, halfFov, 0.f, 0.f),
+		Vector4(0.f, 0.f, (farPlane + nearPlane) / (farPlane - nearPlane), (-2.f * farPlane * nearPlane) / (farPlane - nearPlane)),
+		Vector4(0.f, 0.f, 1.f, 0.f)
+	);
+}
+
+constexpr Matrix4x4 MakeLookToRH(const Vector3& eyePosition, const Vector3& forward, const Vector3& up) {
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		return detail::MakeLookToRH_SSE(eyePosition, forward, up);
+#endif
+	return MakeLookToRH_Scalar(eyePosition, forward, up);
+}
+
+constexpr Matrix4x4 MakeLookAtRH(const Vector3& eyePosition, const Vector3& focusPoint, const Vector3& up) {
+	return MakeLookToRH(eyePosition, NormalizeVector(VectorSubtract(focusPoint, eyePosition)), up);
+}
+
+constexpr Matrix4x4 MatrixMultiply(const Matrix4x4& A, const Matrix4x4& B) {
+#if FE_SIMD_AVX
+	if (!std::is_constant_evaluated())
+		return detail::MatrixMultiply_AVX(A, B);
+#elif FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		return detail::MatrixMultiply_SSE(A, B);
+#endif
+	return MatrixMultiply_Scalar(A, B);
+}
+
+constexpr Matrix4x4 TransposeMatrix(const Matrix4x4& v) {
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		return detail::TransposeMatrix_SSE(v);
+#endif
+	return TransposeMatrix_Scalar(v);
+}
+
+constexpr Vector4 TransformVector(const Matrix4x4& M, const Vector4& v) {
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		return detail::TransformVector_SSE(M, v);
+#endif
+	return TransformVector_Scalar(M, v);
+}
+
+// ===============================================
+// Affine Matrix3x4 transforms
+// ===============================================
+// Matrix3x4 stores the top three rows of an affine 4x4 matrix, the
+//	translation lives in the w components like in MakeLookToRH.
+constexpr Matrix3x4 ToMatrix3x4(const Matrix4x4& M) {
+	return Matrix3x4(M[0], M[1], M[2]);
+}
+
+constexpr Matrix3x4 AffineMultiply(const Matrix3x4& A, const Matrix3x4& B) {
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		return detail::AffineMultiply_SSE(A, B);
+#endif
+	return AffineMultiply_Scalar(A, B);
+}
+
+constexpr Vector3 TransformPoint(const Matrix3x4& M, const Vector3& p) {
+	return Vector3(
+		M[0].x * p.x + M[0].y * p.y + M[0].z * p.z + M[0].w,
+		M[1].x * p.x + M[1].y * p.y + M[1].z * p.z + M[1].w,
+		M[2].x * p.x + M[2].y * p.y + M[2].z * p.z + M[2].w
+	);
+}
+
+// Ignores the translation.
+constexpr Vector3 TransformDirection(const Matrix3x4& M, const Vector3& d) {
+	return Vector3(
+		M[0].x * d.x + M[0].y * d.y + M[0].z * d.z,
+		M[1].x * d.x + M[1].y * d.y + M[1].z * d.z,
+		M[2].x * d.x + M[2].y * d.y + M[2].z * d.z
+	);
+}
+
+// ===============================================
+// Inverses
+// ===============================================
+// All Invert* functions report the determinant through pDeterminant and
+//	return false without touching the output when the matrix is singular.
+//
+//	Singular is relative to the scale of the matrix. The determinant is at
+//	most the product of the row lengths, equal when the rows are orthogonal,
+//	so a determinant below SingularDeterminantEpsilon times that product
+//	means the rows are nearly dependent, whether the matrix is scaled by
+//	0.001 or 1000.
+constexpr float SingularDeterminantEpsilon = 1.0e-6f;
+
+// In double, the squared products overflow float for large matrices.
+constexpr bool IsSingularDeterminant(float determinant, double rowLengthSqProduct) {
+	double epsilonSq = static_cast<double>(SingularDeterminantEpsilon) * SingularDeterminantEpsilon;
+
+	return !(static_cast<double>(determinant) * determinant > epsilonSq * rowLengthSqProduct);
+}
+
+namespace detail {
+
+// Of all 4 rows, for general matrices.
+constexpr double RowLengthSqProduct4x4(const Matrix4x4& M) {
+	double product = 1.0;
+
+	for (int i = 0; i < 4; i++) {
+		const Vector4& r = M[i];
+		product *= static_cast<double>(r.x) * r.x + static_cast<double>(r.y) * r.y + static_cast<double>(r.z) * r.z + static_cast<double>(r.w) * r.w;
+	}
+
+	return product;
+}
+
+// Of the upper 3x3, for affine matrices.
+constexpr double RowLengthSqProduct3x3(const Matrix4x4& M) {
+	double product = 1.0;
+
+	for (int i = 0; i < 3; i++) {
+		const Vector4& r = M[i];
+		product *= static_cast<double>(r.x) * r.x + static_cast<double>(r.y) * r.y + static_cast<double>(r.z) * r.z;
+	}
+
+	return product;
+}
+
+}
+
+// General 4x4 inverse, use the cheaper versions below when possible.
+constexpr bool InvertMatrix(const Matrix4x4& M, Matrix4x4& inverse, float* pDeterminant = nullptr) {
+	float determinant = 0.f;
+	Matrix4x4 result;
+
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		result = detail::InverseMatrix_SSE(M, &determinant);
+	else
+#endif
+		result = InverseMatrix_Scalar(M, &determinant);
+
+	if (pDeterminant)
+		*pDeterminant = determinant;
+
+	if (IsSingularDeterminant(determinant, detail::RowLengthSqProduct4x4(M)))
+		return false;
+
+	inverse = result;
+	return true;
+}
+
+// For matrices with a (0, 0, 0, 1) last row, like world transforms.
+constexpr bool InvertAffineMatrix(const Matrix4x4& M, Matrix4x4& inverse, float* pDeterminant = nullptr) {
+	float determinant = 0.f;
+	Matrix4x4 result;
+
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		result = detail::InverseAffineMatrix_SSE(M, &determinant);
+	else
+#endif
+		result = InverseAffineMatrix_Scalar(M, &determinant);
+
+	if (pDeterminant)
+		*pDeterminant = determinant;
+
+	if (IsSingularDeterminant(determinant, detail::RowLengthSqProduct3x3(M)))
+		return false;
+
+	inverse = result;
+	return true;
+}
+
+constexpr bool InvertAffineMatrix(const Matrix3x4& M, Matrix3x4& inverse, float* pDeterminant = nullptr) {
+	Matrix4x4 result;
+
+	if (!InvertAffineMatrix(Matrix4x4(M), result, pDeterminant))
+		return false;
+
+	inverse = ToMatrix3x4(result);
+	return true;
+}
+
+// Unchecked version of the above for matrices known to be invertible.
+constexpr Matrix3x4 AffineInverse(const Matrix3x4& M) {
+	Matrix3x4 inverse;
+	InvertAffineMatrix(M, inverse);
+
+	return inverse;
+}
+
+// For rotation + translation only, like view matrices. The determinant is
+//	still reported so callers can assert the matrix really is orthonormal.
+constexpr bool InvertRigidMatrix(const Matrix4x4& M, Matrix4x4& inverse, float* pDeterminant = nullptr) {
+	float determinant = 0.f;
+	Matrix4x4 result;
+
+#if FE_SIMD_SSE
+	if (!std::is_constant_evaluated())
+		result = detail::InverseRigidMatrix_SSE(M, &determinant);
+	else
+#endif
+		result = InverseRigidMatrix_Scalar(M, &determinant);
+
+	if (pDeterminant)
+		*pDeterminant = determinant;
+
+	if (IsSingularDeterminant(determinant, detail::RowLengthSqProduct3x3(M)))
+		return false;
+
+	inverse = result;
+	return true;
+}
+
+constexpr Matrix3x4 Matrix3x4::operator*(const Matrix3x4& B) const {
+	return AffineMultiply(*this, B);
+}
+
+constexpr Matrix4x4 Matrix4x4::operator*(const Matrix4x4& B) const {
+	return MatrixMultiply(*this, B);
+}
+
+constexpr Vector4 Matrix4x4::operator*(const Vector4& v) const {
+	return TransformVector(*this, v);
+}
 
-Matrix4x4 MatrixMultiply(const Matrix4x4& A, const Matrix4x4& B);
-Matrix4x4 TransposeMatrix(const Matrix4x4& v);
+constexpr Matrix4x4& Matrix4x4::operator*=(const Matrix4x4& B) {
+	return *this = MatrixMultiply(*this, B);
+}
 
 }
\ No newline at end of file
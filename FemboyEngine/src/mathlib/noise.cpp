@@ -0,0 +1,329 @@
+#include "noise.h"
+#include "simd.h"
+#include "dispatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// The compiler must not fuse a multiply and an add into an FMA either, it
+//	would do that in some kernels and not in others. GCC has no pragma for
+//	it, CMakeLists.txt builds this file with -ffp-contract=off instead.
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+namespace fe::math {
+
+// ===============================================
+// Lane types
+// ===============================================
+// The noise kernels in noisekernels.h are written against these. Every
+//	operation has to round the same way in all of them, so there is no FMA,
+//	explicit or contracted by the compiler, no approximate reciprocal and
+//	floor is done the same way everywhere.
+struct LanesScalar {
+	using F = float;
+	using I = uint32_t;
+	using M = bool;
+	static constexpr size_t Lanes = 1;
+
+	static FE_FORCEINLINE F Load(const float* p) { return *p; }
+	static FE_FORCEINLINE void Store(float* p, F v) { *p = v; }
+	static FE_FORCEINLINE F Set(float v) { return v; }
+	static FE_FORCEINLINE I SetInt(uint32_t v) { return v; }
+
+	static FE_FORCEINLINE F Add(F a, F b) { return a + b; }
+	static FE_FORCEINLINE F Sub(F a, F b) { return a - b; }
+	static FE_FORCEINLINE F Mul(F a, F b) { return a * b; }
+	static FE_FORCEINLINE F Min(F a, F b) { return a < b ? a : b; }
+	static FE_FORCEINLINE F Max(F a, F b) { return a > b ? a : b; }
+	static FE_FORCEINLINE F Sqrt(F v) { return std::sqrt(v); }
+	static FE_FORCEINLINE F Floor(F v) {
+		F t = static_cast<float>(static_cast<int32_t>(v));
+		return t > v ? t - 1.f : t;
+	}
+	static FE_FORCEINLINE F FlipSign(F v, I bit) {
+		uint32_t bits;
+		std::memcpy(&bits, &v, sizeof(bits));
+		bits ^= bit << 31;
+		std::memcpy(&v, &bits, sizeof(bits));
+		return v;
+	}
+
+	static FE_FORCEINLINE I ToInt(F v) { return static_cast<uint32_t>(static_cast<int32_t>(v)); }
+	static FE_FORCEINLINE F ToFloat(I v) { return static_cast<float>(static_cast<int32_t>(v)); }
+	static FE_FORCEINLINE I Add(I a, I b) { return a + b; }
+	static FE_FORCEINLINE I Mul(I a, I b) { return a * b; }
+	static FE_FORCEINLINE I Xor(I a, I b) { return a ^ b; }
+	static FE_FORCEINLINE I And(I a, I b) { return a & b; }
+	static FE_FORCEINLINE I AndNot(I a, I b) { return ~a & b; }
+	static FE_FORCEINLINE I ShiftRight(I v, int count) { return v >> count; }
+
+	static FE_FORCEINLINE M Greater(F a, F b) { return a > b; }
+	static FE_FORCEINLINE M GreaterEqual(F a, F b) { return a >= b; }
+	static FE_FORCEINLINE M Equal(I a, I b) { return a == b; }
+	static FE_FORCEINLINE M And(M a, M b) { return a && b; }
+	static FE_FORCEINLINE M AndNot(M a, M b) { return !a && b; }
+	static FE_FORCEINLINE M Or(M a, M b) { return a || b; }
+	static FE_FORCEINLINE M Not(M m) { return !m; }
+	static FE_FORCEINLINE I MaskToInt(M m) { return m ? 0xFFFFFFFFu : 0u; }
+	static FE_FORCEINLINE F Select(M m, F a, F b) { return m ? a : b; }
+};
+
+#if FE_SIMD_SSE
+struct LanesSSE {
+	using F = __m128;
+	using I = __m128i;
+	using M = __m128;
+	static constexpr size_t Lanes = 4;
+
+	static FE_FORCEINLINE F Load(const float* p) { return _mm_loadu_ps(p); }
+	static FE_FORCEINLINE void Store(float* p, F v) { _mm_storeu_ps(p, v); }
+	static FE_FORCEINLINE F Set(float v) { return _mm_set1_ps(v); }
+	static FE_FORCEINLINE I SetInt(uint32_t v) { return _mm_set1_epi32(static_cast<int32_t>(v)); }
+
+	static FE_FORCEINLINE F Add(F a, F b) { return _mm_add_ps(a, b); }
+	static FE_FORCEINLINE F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+	static FE_FORCEINLINE F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+	static FE_FORCEINLINE F Min(F a, F b) { return _mm_min_ps(a, b); }
+	static FE_FORCEINLINE F Max(F a, F b) { return _mm_max_ps(a, b); }
+	static FE_FORCEINLINE F Sqrt(F v) { return _mm_sqrt_ps(v); }
+	static FE_FORCEINLINE F Floor(F v) {
+		F t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+		return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.f)));
+	}
+	static FE_FORCEINLINE F FlipSign(F v, I bit) { return _mm_xor_ps(v, _mm_castsi128_ps(_mm_slli_epi32(bit, 31))); }
+
+	static FE_FORCEINLINE I ToInt(F v) { return _mm_cvttps_epi32(v); }
+	static FE_FORCEINLINE F ToFloat(I v) { return _mm_cvtepi32_ps(v); }
+	static FE_FORCEINLINE I Add(I a, I b) { return _mm_add_epi32(a, b); }
+	// SSE2 has no 32 bit multiply, do the even and odd lanes as 64 bit
+	//	products and put the low halves back together.
+	static FE_FORCEINLINE I Mul(I a, I b) {
+		__m128i even = _mm_mul_epu32(a, b);
+		__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	}
+	static FE_FORCEINLINE I Xor(I a, I b) { return _mm_xor_si128(a, b); }
+	static FE_FORCEINLINE I And(I a, I b) { return _mm_and_si128(a, b); }
+	static FE_FORCEINLINE I AndNot(I a, I b) { return _mm_andnot_si128(a, b); }
+	static FE_FORCEINLINE I ShiftRight(I v, int count) { return _mm_srli_epi32(v, count); }
+
+	static FE_FORCEINLINE M Greater(F a, F b) { return _mm_cmpgt_ps(a, b); }
+	static FE_FORCEINLINE M GreaterEqual(F a, F b) { return _mm_cmpge_ps(a, b); }
+	static FE_FORCEINLINE M Equal(I a, I b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+	static FE_FORCEINLINE M And(M a, M b) { return _mm_and_ps(a, b); }
+	static FE_FORCEINLINE M AndNot(M a, M b) { return _mm_andnot_ps(a, b); }
+	static FE_FORCEINLINE M Or(M a, M b) { return _mm_or_ps(a, b); }
+	static FE_FORCEINLINE M Not(M m) { return _mm_xor_ps(m, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+	static FE_FORCEINLINE I MaskToInt(M m) { return _mm_castps_si128(m); }
+	static FE_FORCEINLINE F Select(M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+#endif
+
+// ===============================================
+// Kernels
+// ===============================================
+namespace noise {
+#include "noisekernels.h"
+}
+
+#if FE_SIMD_SSE
+FE_BEGIN_TARGET_AVX2_NO_FMA
+
+struct LanesAVX2 {
+	using F = __m256;
+	using I = __m256i;
+	using M = __m256;
+	static constexpr size_t Lanes = 8;
+
+	static FE_FORCEINLINE F Load(const float* p) { return _mm256_loadu_ps(p); }
+	static FE_FORCEINLINE void Store(float* p, F v) { _mm256_storeu_ps(p, v); }
+	static FE_FORCEINLINE F Set(float v) { return _mm256_set1_ps(v); }
+	static FE_FORCEINLINE I SetInt(uint32_t v) { return _mm256_set1_epi32(static_cast<int32_t>(v)); }
+
+	static FE_FORCEINLINE F Add(F a, F b) { return _mm256_add_ps(a, b); }
+	static FE_FORCEINLINE F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+	static FE_FORCEINLINE F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+	static FE_FORCEINLINE F Min(F a, F b) { return _mm256_min_ps(a, b); }
+	static FE_FORCEINLINE F Max(F a, F b) { return _mm256_max_ps(a, b); }
+	static FE_FORCEINLINE F Sqrt(F v) { return _mm256_sqrt_ps(v); }
+	static FE_FORCEINLINE F Floor(F v) {
+		F t = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(v));
+		return _mm256_sub_ps(t, _mm256_and_ps(_mm256_cmp_ps(t, v, _CMP_GT_OQ), _mm256_set1_ps(1.f)));
+	}
+	static FE_FORCEINLINE F FlipSign(F v, I bit) { return _mm256_xor_ps(v, _mm256_castsi256_ps(_mm256_slli_epi32(bit, 31))); }
+
+	static FE_FORCEINLINE I ToInt(F v) { return _mm256_cvttps_epi32(v); }
+	static FE_FORCEINLINE F ToFloat(I v) { return _mm256_cvtepi32_ps(v); }
+	static FE_FORCEINLINE I Add(I a, I b) { return _mm256_add_epi32(a, b); }
+	static FE_FORCEINLINE I Mul(I a, I b) { return _mm256_mullo_epi32(a, b); }
+	static FE_FORCEINLINE I Xor(I a, I b) { return _mm256_xor_si256(a, b); }
+	static FE_FORCEINLINE I And(I a, I b) { return _mm256_and_si256(a, b); }
+	static FE_FORCEINLINE I AndNot(I a, I b) { return _mm256_andnot_si256(a, b); }
+	static FE_FORCEINLINE I ShiftRight(I v, int count) { return _mm256_srli_epi32(v, count); }
+
+	static FE_FORCEINLINE M Greater(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static FE_FORCEINLINE M GreaterEqual(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static FE_FORCEINLINE M Equal(I a, I b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+	static FE_FORCEINLINE M And(M a, M b) { return _mm256_and_ps(a, b); }
+	static FE_FORCEINLINE M AndNot(M a, M b) { return _mm256_andnot_ps(a, b); }
+	static FE_FORCEINLINE M Or(M a, M b) { return _mm256_or_ps(a, b); }
+	static FE_FORCEINLINE M Not(M m) { return _mm256_xor_ps(m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+	static FE_FORCEINLINE I MaskToInt(M m) { return _mm256_castps_si256(m); }
+	static FE_FORCEINLINE F Select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+};
+
+namespace noiseAVX2 {
+#include "noisekernels.h"
+}
+
+static void NoiseArray2D_AVX2(const NoiseParams_t& params, const float* pXs, const float* pYs, size_t count, float* pOut) {
+	const float* pCoordinates[2] = { pXs, pYs };
+	noiseAVX2::NoiseArray<LanesAVX2, 2>(params, pCoordinates, count, pOut);
+}
+
+static void NoiseArray3D_AVX2(const NoiseParams_t& params, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOut) {
+	const float* pCoordinates[3] = { pXs, pYs, pZs };
+	noiseAVX2::NoiseArray<LanesAVX2, 3>(params, pCoordinates, count, pOut);
+}
+
+FE_END_TARGET_AVX2_NO_FMA
+
+static void NoiseArray2D_SSE(const NoiseParams_t& params, const float* pXs, const float* pYs, size_t count, float* pOut) {
+	const float* pCoordinates[2] = { pXs, pYs };
+	noise::NoiseArray<LanesSSE, 2>(params, pCoordinates, count, pOut);
+}
+
+static void NoiseArray3D_SSE(const NoiseParams_t& params, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOut) {
+	const float* pCoordinates[3] = { pXs, pYs, pZs };
+	noise::NoiseArray<LanesSSE, 3>(params, pCoordinates, count, pOut);
+}
+#endif
+
+static void NoiseArray2D_Scalar(const NoiseParams_t& params, const float* pXs, const float* pYs, size_t count, float* pOut) {
+	const float* pCoordinates[2] = { pXs, pYs };
+	noise::NoiseArray<LanesScalar, 2>(params, pCoordinates, count, pOut);
+}
+
+static void NoiseArray3D_Scalar(const NoiseParams_t& params, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOut) {
+	const float* pCoordinates[3] = { pXs, pYs, pZs };
+	noise::NoiseArray<LanesScalar, 3>(params, pCoordinates, count, pOut);
+}
+
+// ===============================================
+// Dispatch
+// ===============================================
+using NoiseArray2DKernel_t = void(*)(const NoiseParams_t& params, const float* pXs, const float* pYs, size_t count, float* pOut);
+using NoiseArray3DKernel_t = void(*)(const NoiseParams_t& params, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOut);
+
+static SimdDispatch<NoiseArray2DKernel_t> noiseArray2D(FE_SIMD_VARIANTS(NoiseArray2D));
+static SimdDispatch<NoiseArray3DKernel_t> noiseArray3D(FE_SIMD_VARIANTS(NoiseArray3D));
+
+// ===============================================
+// Public interface
+// ===============================================
+float Noise2D(const NoiseParams_t& params, float x, float y) {
+	switch (params.type) {
+	case NoiseType::Value: return noise::FractalNoise<LanesScalar, NoiseType::Value>(params, x, y);
+	case NoiseType::Perlin: return noise::FractalNoise<LanesScalar, NoiseType::Perlin>(params, x, y);
+	case NoiseType::Simplex: return noise::FractalNoise<LanesScalar, NoiseType::Simplex>(params, x, y);
+	case NoiseType::Cellular: return noise::FractalNoise<LanesScalar, NoiseType::Cellular>(params, x, y);
+	}
+
+	return 0.f;
+}
+
+float Noise3D(const NoiseParams_t& params, float x, float y, float z) {
+	switch (params.type) {
+	case NoiseType::Value: return noise::FractalNoise<LanesScalar, NoiseType::Value>(params, x, y, z);
+	case NoiseType::Perlin: return noise::FractalNoise<LanesScalar, NoiseType::Perlin>(params, x, y, z);
+	case NoiseType::Simplex: return noise::FractalNoise<LanesScalar, NoiseType::Simplex>(params, x, y, z);
+	case NoiseType::Cellular: return noise::FractalNoise<LanesScalar, NoiseType::Cellular>(params, x, y, z);
+	}
+
+	return 0.f;
+}
+
+void NoiseArray2D(const NoiseParams_t& params, const float* pXs, const float* pYs, size_t count, float* pOut) {
+	noiseArray2D(params, pXs, pYs, count, pOut);
+}
+
+void NoiseArray3D(const NoiseParams_t& params, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOut) {
+	noiseArray3D(params, pXs, pYs, pZs, count, pOut);
+}
+
+// Runs fn(firstRow, endRow) over numRows rows, split into contiguous ranges.
+//	The calling thread takes the first range.
+template<typename Fn>
+static void ForEachRowRange(uint32_t numRows, uint32_t numThreads, const Fn& fn) {
+	if (numThreads == 0)
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	numThreads = std::min(numThreads, std::max(numRows, 1u));
+
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads - 1);
+
+	uint32_t rowsPerThread = numRows / numThreads;
+	uint32_t remainder = numRows % numThreads;
+	uint32_t firstRow = rowsPerThread + (remainder > 0 ? 1 : 0);
+
+	for (uint32_t t = 1; t < numThreads; t++) {
+		uint32_t count = rowsPerThread + (t < remainder ? 1 : 0);
+		threads.emplace_back(fn, firstRow, firstRow + count);
+		firstRow += count;
+	}
+
+	fn(0u, rowsPerThread + (remainder > 0 ? 1 : 0));
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+void FillNoiseGrid2D(const NoiseParams_t& params, float originX, float originY, float step,
+	uint32_t width, uint32_t height, float* pOut, uint32_t numThreads)
+{
+	ForEachRowRange(height, numThreads, [&](uint32_t firstRow, uint32_t endRow) {
+		std::vector<float> xs(width), ys(width);
+
+		for (uint32_t x = 0; x < width; x++) {
+			xs[x] = originX + static_cast<float>(x) * step;
+		}
+
+		for (uint32_t y = firstRow; y < endRow; y++) {
+			std::fill(ys.begin(), ys.end(), originY + static_cast<float>(y) * step);
+			noiseArray2D(params, xs.data(), ys.data(), width, pOut + size_t(y) * width);
+		}
+	});
+}
+
+void FillNoiseGrid3D(const NoiseParams_t& params, float originX, float originY, float originZ, float step,
+	uint32_t width, uint32_t height, uint32_t depth, float* pOut, uint32_t numThreads)
+{
+	// Every (y, z) pair is a row.
+	ForEachRowRange(height * depth, numThreads, [&](uint32_t firstRow, uint32_t endRow) {
+		std::vector<float> xs(width), ys(width), zs(width);
+
+		for (uint32_t x = 0; x < width; x++) {
+			xs[x] = originX + static_cast<float>(x) * step;
+		}
+
+		for (uint32_t row = firstRow; row < endRow; row++) {
+			uint32_t y = row % height;
+			uint32_t z = row / height;
+
+			std::fill(ys.begin(), ys.end(), originY + static_cast<float>(y) * step);
+			std::fill(zs.begin(), zs.end(), originZ + static_cast<float>(z) * step);
+			noiseArray3D(params, xs.data(), ys.data(), zs.data(), width, pOut + size_t(row) * width);
+		}
+	});
+}
+
+}
\ No newline at end of file
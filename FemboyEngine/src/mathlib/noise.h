@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fe::math {
+
+// Coherent noise for terrain and procedural textures.
+//	Every SIMD level computes exactly the same values, and Noise2D and
+//	Noise3D match the batch functions, so a seed gives the same terrain on
+//	every CPU. Integer cell coordinates must stay within int32, so keep
+//	|coordinate * frequency| below 2^31.
+//
+//	Value, Perlin and Simplex return roughly [-1, 1]. Cellular returns the
+//	distance to the nearest feature point in cells, 0 to a little over 1.
+struct NoiseType {
+	enum Enum : uint32_t {
+		Value,
+		Perlin,
+		Simplex,
+		Cellular
+	};
+};
+
+struct NoiseParams_t {
+	NoiseType::Enum type = NoiseType::Simplex;
+	uint32_t seed = 0;
+	float frequency = 1.f;
+
+	// More than one octave sums fBm layers. Each layer has lacunarity times
+	//	the frequency and gain times the amplitude of the one before, the sum
+	//	is divided by the total amplitude to keep the range.
+	uint32_t octaves = 1;
+	float lacunarity = 2.f;
+	float gain = 0.5f;
+};
+
+float Noise2D(const NoiseParams_t& params, float x, float y);
+float Noise3D(const NoiseParams_t& params, float x, float y, float z);
+
+// Batch versions over component arrays, picked through the SIMD dispatch.
+void NoiseArray2D(const NoiseParams_t& params, const float* pXs, const float* pYs, size_t count, float* pOut);
+void NoiseArray3D(const NoiseParams_t& params, const float* pXs, const float* pYs, const float* pZs, size_t count, float* pOut);
+
+// Row major grids, sample (x, y) is at origin + (x, y) * step and stored at
+//	pOut[y * width + x], with z * width * height added for 3D. The rows are
+//	split over numThreads threads, 0 uses one per hardware thread.
+void FillNoiseGrid2D(const NoiseParams_t& params, float originX, float originY, float step,
+	uint32_t width, uint32_t height, float* pOut, uint32_t numThreads = 1);
+void FillNoiseGrid3D(const NoiseParams_t& params, float originX, float originY, float originZ, float step,
+	uint32_t width, uint32_t height, uint32_t depth, float* pOut, uint32_t numThreads = 1);
+
+}
\ No newline at end of file
@@ -0,0 +1,424 @@
+// Noise algorithms written once against a lane type W, which provides the
+//	float type F, the integer type I, the mask type M and their operations.
+//	noise.cpp includes this file twice, in a plain namespace for the scalar
+//	and SSE2 lanes and in an AVX2 target region, so there is no include guard.
+//	Every level runs the same operations in the same order, which is what
+//	keeps the results identical.
+
+// Large primes for spreading cell coordinates, x * PrimeX is the "primed"
+//	coordinate and neighbours are one PrimeX apart.
+constexpr uint32_t PrimeX = 501125321u;
+constexpr uint32_t PrimeY = 1136930381u;
+constexpr uint32_t PrimeZ = 1720413743u;
+constexpr uint32_t HashMultiplier = 0x27D4EB2Du;
+
+// Bring the raw sums to roughly [-1, 1], measured over a million samples.
+constexpr float PerlinScale2D = 1.f;
+constexpr float PerlinScale3D = 0.96f;
+constexpr float SimplexScale2D = 70.f;
+constexpr float SimplexScale3D = 32.f;
+
+// ===============================================
+// Helpers
+// ===============================================
+template<typename W>
+FE_FORCEINLINE typename W::I Hash(typename W::I seed, typename W::I xPrimed, typename W::I yPrimed) {
+	typename W::I hash = W::Mul(W::Xor(W::Xor(seed, xPrimed), yPrimed), W::SetInt(HashMultiplier));
+
+	return W::Xor(hash, W::ShiftRight(hash, 15));
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::I Hash(typename W::I seed, typename W::I xPrimed, typename W::I yPrimed, typename W::I zPrimed) {
+	typename W::I hash = W::Mul(W::Xor(W::Xor(W::Xor(seed, xPrimed), yPrimed), zPrimed), W::SetInt(HashMultiplier));
+
+	return W::Xor(hash, W::ShiftRight(hash, 15));
+}
+
+// Hash to [-1, 1).
+template<typename W>
+FE_FORCEINLINE typename W::F HashToFloat(typename W::I hash) {
+	return W::Mul(W::ToFloat(hash), W::Set(1.f / 2147483648.f));
+}
+
+// 6t^5 - 15t^4 + 10t^3
+template<typename W>
+FE_FORCEINLINE typename W::F Fade(typename W::F t) {
+	typename W::F inner = W::Add(W::Mul(t, W::Sub(W::Mul(t, W::Set(6.f)), W::Set(15.f))), W::Set(10.f));
+
+	return W::Mul(W::Mul(W::Mul(t, t), t), inner);
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F Lerp(typename W::F a, typename W::F b, typename W::F t) {
+	return W::Add(a, W::Mul(t, W::Sub(b, a)));
+}
+
+// Selects a mask from a hash bit pattern, (hash & mask) == value.
+template<typename W>
+FE_FORCEINLINE typename W::M HashEquals(typename W::I hash, uint32_t mask, uint32_t value) {
+	return W::Equal(W::And(hash, W::SetInt(mask)), W::SetInt(value));
+}
+
+// Improved Perlin gradients, dot product of one of the 12 cube edge
+//	directions with (x, y, z). Picked by the top 4 bits of the hash.
+template<typename W>
+FE_FORCEINLINE typename W::F Gradient(typename W::I hash, typename W::F x, typename W::F y, typename W::F z) {
+	typename W::I h = W::ShiftRight(hash, 28);
+
+	typename W::F u = W::Select(HashEquals<W>(h, 8, 0), x, y);
+	typename W::F v = W::Select(HashEquals<W>(h, 12, 0), y, W::Select(HashEquals<W>(h, 13, 12), x, z));
+
+	return W::Add(W::FlipSign(u, W::And(h, W::SetInt(1))), W::FlipSign(v, W::And(W::ShiftRight(h, 1), W::SetInt(1))));
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F Gradient(typename W::I hash, typename W::F x, typename W::F y) {
+	return Gradient<W>(hash, x, y, W::Set(0.f));
+}
+
+// ===============================================
+// Value noise
+// ===============================================
+template<typename W>
+FE_FORCEINLINE typename W::F ValueNoise(typename W::I seed, typename W::F x, typename W::F y) {
+	using F = typename W::F;
+	using I = typename W::I;
+
+	F xFloor = W::Floor(x), yFloor = W::Floor(y);
+	I x0 = W::Mul(W::ToInt(xFloor), W::SetInt(PrimeX)), y0 = W::Mul(W::ToInt(yFloor), W::SetInt(PrimeY));
+	I x1 = W::Add(x0, W::SetInt(PrimeX)), y1 = W::Add(y0, W::SetInt(PrimeY));
+	F u = Fade<W>(W::Sub(x, xFloor)), v = Fade<W>(W::Sub(y, yFloor));
+
+	F bottom = Lerp<W>(HashToFloat<W>(Hash<W>(seed, x0, y0)), HashToFloat<W>(Hash<W>(seed, x1, y0)), u);
+	F top = Lerp<W>(HashToFloat<W>(Hash<W>(seed, x0, y1)), HashToFloat<W>(Hash<W>(seed, x1, y1)), u);
+
+	return Lerp<W>(bottom, top, v);
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F ValueNoise(typename W::I seed, typename W::F x, typename W::F y, typename W::F z) {
+	using F = typename W::F;
+	using I = typename W::I;
+
+	F xFloor = W::Floor(x), yFloor = W::Floor(y), zFloor = W::Floor(z);
+	I x0 = W::Mul(W::ToInt(xFloor), W::SetInt(PrimeX)), y0 = W::Mul(W::ToInt(yFloor), W::SetInt(PrimeY)), z0 = W::Mul(W::ToInt(zFloor), W::SetInt(PrimeZ));
+	I x1 = W::Add(x0, W::SetInt(PrimeX)), y1 = W::Add(y0, W::SetInt(PrimeY)), z1 = W::Add(z0, W::SetInt(PrimeZ));
+	F u = Fade<W>(W::Sub(x, xFloor)), v = Fade<W>(W::Sub(y, yFloor)), w = Fade<W>(W::Sub(z, zFloor));
+
+	F front = Lerp<W>(
+		Lerp<W>(HashToFloat<W>(Hash<W>(seed, x0, y0, z0)), HashToFloat<W>(Hash<W>(seed, x1, y0, z0)), u),
+		Lerp<W>(HashToFloat<W>(Hash<W>(seed, x0, y1, z0)), HashToFloat<W>(Hash<W>(seed, x1, y1, z0)), u), v);
+	F back = Lerp<W>(
+		Lerp<W>(HashToFloat<W>(Hash<W>(seed, x0, y0, z1)), HashToFloat<W>(Hash<W>(seed, x1, y0, z1)), u),
+		Lerp<W>(HashToFloat<W>(Hash<W>(seed, x0, y1, z1)), HashToFloat<W>(Hash<W>(seed, x1, y1, z1)), u), v);
+
+	return Lerp<W>(front, back, w);
+}
+
+// ===============================================
+// Perlin noise
+// ===============================================
+template<typename W>
+FE_FORCEINLINE typename W::F PerlinNoise(typename W::I seed, typename W::F x, typename W::F y) {
+	using F = typename W::F;
+	using I = typename W::I;
+
+	F xFloor = W::Floor(x), yFloor = W::Floor(y);
+	I x0 = W::Mul(W::ToInt(xFloor), W::SetInt(PrimeX)), y0 = W::Mul(W::ToInt(yFloor), W::SetInt(PrimeY));
+	I x1 = W::Add(x0, W::SetInt(PrimeX)), y1 = W::Add(y0, W::SetInt(PrimeY));
+
+	F dx0 = W::Sub(x, xFloor), dy0 = W::Sub(y, yFloor);
+	F dx1 = W::Sub(dx0, W::Set(1.f)), dy1 = W::Sub(dy0, W::Set(1.f));
+	F u = Fade<W>(dx0), v = Fade<W>(dy0);
+
+	F bottom = Lerp<W>(Gradient<W>(Hash<W>(seed, x0, y0), dx0, dy0), Gradient<W>(Hash<W>(seed, x1, y0), dx1, dy0), u);
+	F top = Lerp<W>(Gradient<W>(Hash<W>(seed, x0, y1), dx0, dy1), Gradient<W>(Hash<W>(seed, x1, y1), dx1, dy1), u);
+
+	return W::Mul(Lerp<W>(bottom, top, v), W::Set(PerlinScale2D));
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F PerlinNoise(typename W::I seed, typename W::F x, typename W::F y, typename W::F z) {
+	using F = typename W::F;
+	using I = typename W::I;
+
+	F xFloor = W::Floor(x), yFloor = W::Floor(y), zFloor = W::Floor(z);
+	I x0 = W::Mul(W::ToInt(xFloor), W::SetInt(PrimeX)), y0 = W::Mul(W::ToInt(yFloor), W::SetInt(PrimeY)), z0 = W::Mul(W::ToInt(zFloor), W::SetInt(PrimeZ));
+	I x1 = W::Add(x0, W::SetInt(PrimeX)), y1 = W::Add(y0, W::SetInt(PrimeY)), z1 = W::Add(z0, W::SetInt(PrimeZ));
+
+	F dx0 = W::Sub(x, xFloor), dy0 = W::Sub(y, yFloor), dz0 = W::Sub(z, zFloor);
+	F dx1 = W::Sub(dx0, W::Set(1.f)), dy1 = W::Sub(dy0, W::Set(1.f)), dz1 = W::Sub(dz0, W::Set(1.f));
+	F u = Fade<W>(dx0), v = Fade<W>(dy0), w = Fade<W>(dz0);
+
+	F front = Lerp<W>(
+		Lerp<W>(Gradient<W>(Hash<W>(seed, x0, y0, z0), dx0, dy0, dz0), Gradient<W>(Hash<W>(seed, x1, y0, z0), dx1, dy0, dz0), u),
+		Lerp<W>(Gradient<W>(Hash<W>(seed, x0, y1, z0), dx0, dy1, dz0), Gradient<W>(Hash<W>(seed, x1, y1, z0), dx1, dy1, dz0), u), v);
+	F back = Lerp<W>(
+		Lerp<W>(Gradient<W>(Hash<W>(seed, x0, y0, z1), dx0, dy0, dz1), Gradient<W>(Hash<W>(seed, x1, y0, z1), dx1, dy0, dz1), u),
+		Lerp<W>(Gradient<W>(Hash<W>(seed, x0, y1, z1), dx0, dy1, dz1), Gradient<W>(Hash<W>(seed, x1, y1, z1), dx1, dy1, dz1), u), v);
+
+	return W::Mul(Lerp<W>(front, back, w), W::Set(PerlinScale3D));
+}
+
+// ===============================================
+// Simplex noise
+// ===============================================
+// Contribution of one simplex corner, (radius - d^2)^4 * gradient.
+template<typename W>
+FE_FORCEINLINE typename W::F SimplexCorner(typename W::I hash, float radius, typename W::F x, typename W::F y, typename W::F z) {
+	typename W::F t = W::Sub(W::Sub(W::Sub(W::Set(radius), W::Mul(x, x)), W::Mul(y, y)), W::Mul(z, z));
+	t = W::Max(t, W::Set(0.f));
+	t = W::Mul(t, t);
+
+	return W::Mul(W::Mul(t, t), Gradient<W>(hash, x, y, z));
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F SimplexNoise(typename W::I seed, typename W::F x, typename W::F y) {
+	using F = typename W::F;
+	using I = typename W::I;
+	using M = typename W::M;
+
+	constexpr float F2 = 0.36602540378f; // (sqrt(3) - 1) / 2
+	constexpr float G2 = 0.21132486540f; // (3 - sqrt(3)) / 6
+
+	// Skew to the simplex grid and find the cell.
+	F skew = W::Mul(W::Add(x, y), W::Set(F2));
+	F i = W::Floor(W::Add(x, skew)), j = W::Floor(W::Add(y, skew));
+	F unskew = W::Mul(W::Add(i, j), W::Set(G2));
+	F x0 = W::Sub(x, W::Sub(i, unskew)), y0 = W::Sub(y, W::Sub(j, unskew));
+
+	// The middle corner is one step along x or y, whichever offset is larger.
+	M xStep = W::Greater(x0, y0);
+	F x1 = W::Add(W::Sub(x0, W::Select(xStep, W::Set(1.f), W::Set(0.f))), W::Set(G2));
+	F y1 = W::Add(W::Sub(y0, W::Select(xStep, W::Set(0.f), W::Set(1.f))), W::Set(G2));
+	F x2 = W::Add(W::Sub(x0, W::Set(1.f)), W::Set(2.f * G2));
+	F y2 = W::Add(W::Sub(y0, W::Set(1.f)), W::Set(2.f * G2));
+
+	I i0 = W::Mul(W::ToInt(i), W::SetInt(PrimeX)), j0 = W::Mul(W::ToInt(j), W::SetInt(PrimeY));
+	I i1 = W::Add(i0, W::And(W::MaskToInt(xStep), W::SetInt(PrimeX)));
+	I j1 = W::Add(j0, W::AndNot(W::MaskToInt(xStep), W::SetInt(PrimeY)));
+	I i2 = W::Add(i0, W::SetInt(PrimeX)), j2 = W::Add(j0, W::SetInt(PrimeY));
+
+	F zero = W::Set(0.f);
+	F sum = SimplexCorner<W>(Hash<W>(seed, i0, j0), 0.5f, x0, y0, zero);
+	sum = W::Add(sum, SimplexCorner<W>(Hash<W>(seed, i1, j1), 0.5f, x1, y1, zero));
+	sum = W::Add(sum, SimplexCorner<W>(Hash<W>(seed, i2, j2), 0.5f, x2, y2, zero));
+
+	return W::Mul(sum, W::Set(SimplexScale2D));
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F SimplexNoise(typename W::I seed, typename W::F x, typename W::F y, typename W::F z) {
+	using F = typename W::F;
+	using I = typename W::I;
+	using M = typename W::M;
+
+	constexpr float F3 = 1.f / 3.f;
+	constexpr float G3 = 1.f / 6.f;
+
+	F skew = W::Mul(W::Add(W::Add(x, y), z), W::Set(F3));
+	F i = W::Floor(W::Add(x, skew)), j = W::Floor(W::Add(y, skew)), k = W::Floor(W::Add(z, skew));
+	F unskew = W::Mul(W::Add(W::Add(i, j), k), W::Set(G3));
+	F x0 = W::Sub(x, W::Sub(i, unskew)), y0 = W::Sub(y, W::Sub(j, unskew)), z0 = W::Sub(z, W::Sub(k, unskew));
+
+	// The second corner steps along the largest offset, the third along
+	//	both except the smallest.
+	M xMax = W::And(W::GreaterEqual(x0, y0), W::GreaterEqual(x0, z0));
+	M yMax = W::AndNot(xMax, W::GreaterEqual(y0, z0));
+	M zMax = W::Not(W::Or(xMax, yMax));
+	M xNotMin = W::Or(W::GreaterEqual(x0, y0), W::GreaterEqual(x0, z0));
+	M yNotMin = W::Or(W::Greater(y0, x0), W::GreaterEqual(y0, z0));
+	M zNotMin = W::Not(W::And(xNotMin, yNotMin));
+
+	F one = W::Set(1.f), zero = W::Set(0.f);
+	F x1 = W::Add(W::Sub(x0, W::Select(xMax, one, zero)), W::Set(G3));
+	F y1 = W::Add(W::Sub(y0, W::Select(yMax, one, zero)), W::Set(G3));
+	F z1 = W::Add(W::Sub(z0, W::Select(zMax, one, zero)), W::Set(G3));
+	F x2 = W::Add(W::Sub(x0, W::Select(xNotMin, one, zero)), W::Set(2.f * G3));
+	F y2 = W::Add(W::Sub(y0, W::Select(yNotMin, one, zero)), W::Set(2.f * G3));
+	F z2 = W::Add(W::Sub(z0, W::Select(zNotMin, one, zero)), W::Set(2.f * G3));
+	F x3 = W::Add(W::Sub(x0, one), W::Set(3.f * G3));
+	F y3 = W::Add(W::Sub(y0, one), W::Set(3.f * G3));
+	F z3 = W::Add(W::Sub(z0, one), W::Set(3.f * G3));
+
+	I i0 = W::Mul(W::ToInt(i), W::SetInt(PrimeX)), j0 = W::Mul(W::ToInt(j), W::SetInt(PrimeY)), k0 = W::Mul(W::ToInt(k), W::SetInt(PrimeZ));
+	I primeX = W::SetInt(PrimeX), primeY = W::SetInt(PrimeY), primeZ = W::SetInt(PrimeZ);
+
+	F sum = SimplexCorner<W>(Hash<W>(seed, i0, j0, k0), 0.6f, x0, y0, z0);
+	sum = W::Add(sum, SimplexCorner<W>(Hash<W>(seed,
+		W::Add(i0, W::And(W::MaskToInt(xMax), primeX)), W::Add(j0, W::And(W::MaskToInt(yMax), primeY)), W::Add(k0, W::And(W::MaskToInt(zMax), primeZ))),
+		0.6f, x1, y1, z1));
+	sum = W::Add(sum, SimplexCorner<W>(Hash<W>(seed,
+		W::Add(i0, W::And(W::MaskToInt(xNotMin), primeX)), W::Add(j0, W::And(W::MaskToInt(yNotMin), primeY)), W::Add(k0, W::And(W::MaskToInt(zNotMin), primeZ))),
+		0.6f, x2, y2, z2));
+	sum = W::Add(sum, SimplexCorner<W>(Hash<W>(seed, W::Add(i0, primeX), W::Add(j0, primeY), W::Add(k0, primeZ)), 0.6f, x3, y3, z3));
+
+	return W::Mul(sum, W::Set(SimplexScale3D));
+}
+
+// ===============================================
+// Cellular noise
+// ===============================================
+// Distance to the nearest of one jittered feature point per cell, searching
+//	the neighbouring cells.
+template<typename W>
+FE_FORCEINLINE typename W::F CellularNoise(typename W::I seed, typename W::F x, typename W::F y) {
+	using F = typename W::F;
+	using I = typename W::I;
+
+	F xFloor = W::Floor(x), yFloor = W::Floor(y);
+	I x0 = W::Mul(W::ToInt(xFloor), W::SetInt(PrimeX)), y0 = W::Mul(W::ToInt(yFloor), W::SetInt(PrimeY));
+	F dx = W::Sub(x, xFloor), dy = W::Sub(y, yFloor);
+	F nearest = W::Set(8.f);
+
+	for (int32_t cellY = -1; cellY <= 1; cellY++) {
+		I yPrimed = W::Add(y0, W::SetInt(static_cast<uint32_t>(cellY) * PrimeY));
+
+		for (int32_t cellX = -1; cellX <= 1; cellX++) {
+			I hash = Hash<W>(seed, W::Add(x0, W::SetInt(static_cast<uint32_t>(cellX) * PrimeX)), yPrimed);
+
+			F jitterX = W::Mul(W::ToFloat(W::And(hash, W::SetInt(0xFFFF))), W::Set(1.f / 65536.f));
+			F jitterY = W::Mul(W::ToFloat(W::ShiftRight(hash, 16)), W::Set(1.f / 65536.f));
+			F offsetX = W::Sub(W::Add(W::Set(static_cast<float>(cellX)), jitterX), dx);
+			F offsetY = W::Sub(W::Add(W::Set(static_cast<float>(cellY)), jitterY), dy);
+
+			nearest = W::Min(nearest, W::Add(W::Mul(offsetX, offsetX), W::Mul(offsetY, offsetY)));
+		}
+	}
+
+	return W::Sqrt(nearest);
+}
+
+template<typename W>
+FE_FORCEINLINE typename W::F CellularNoise(typename W::I seed, typename W::F x, typename W::F y, typename W::F z) {
+	using F = typename W::F;
+	using I = typename W::I;
+
+	F xFloor = W::Floor(x), yFloor = W::Floor(y), zFloor = W::Floor(z);
+	I x0 = W::Mul(W::ToInt(xFloor), W::SetInt(PrimeX)), y0 = W::Mul(W::ToInt(yFloor), W::SetInt(PrimeY)), z0 = W::Mul(W::ToInt(zFloor), W::SetInt(PrimeZ));
+	F dx = W::Sub(x, xFloor), dy = W::Sub(y, yFloor), dz = W::Sub(z, zFloor);
+	F nearest = W::Set(8.f);
+
+	for (int32_t cellZ = -1; cellZ <= 1; cellZ++) {
+		I zPrimed = W::Add(z0, W::SetInt(static_cast<uint32_t>(cellZ) * PrimeZ));
+
+		for (int32_t cellY = -1; cellY <= 1; cellY++) {
+			I yPrimed = W::Add(y0, W::SetInt(static_cast<uint32_t>(cellY) * PrimeY));
+
+			for (int32_t cellX = -1; cellX <= 1; cellX++) {
+				I hash = Hash<W>(seed, W::Add(x0, W::SetInt(static_cast<uint32_t>(cellX) * PrimeX)), yPrimed, zPrimed);
+
+				// 10, 11 and 11 bits of jitter.
+				F jitterX = W::Mul(W::ToFloat(W::And(hash, W::SetInt(0x3FF))), W::Set(1.f / 1024.f));
+				F jitterY = W::Mul(W::ToFloat(W::And(W::ShiftRight(hash, 10), W::SetInt(0x7FF))), W::Set(1.f / 2048.f));
+				F jitterZ = W::Mul(W::ToFloat(W::ShiftRight(hash, 21)), W::Set(1.f / 2048.f));
+				F offsetX = W::Sub(W::Add(W::Set(static_cast<float>(cellX)), jitterX), dx);
+				F offsetY = W::Sub(W::Add(W::Set(static_cast<float>(cellY)), jitterY), dy);
+				F offsetZ = W::Sub(W::Add(W::Set(static_cast<float>(cellZ)), jitterZ), dz);
+
+				F distance = W::Add(W::Add(W::Mul(offsetX, offsetX), W::Mul(offsetY, offsetY)), W::Mul(offsetZ, offsetZ));
+				nearest = W::Min(nearest, distance);
+			}
+		}
+	}
+
+	return W::Sqrt(nearest);
+}
+
+// ===============================================
+// fBm and batches
+// ===============================================
+template<typename W, NoiseType::Enum Type>
+FE_FORCEINLINE typename W::F BaseNoise(typename W::I seed, typename W::F x, typename W::F y) {
+	if constexpr (Type == NoiseType::Value)
+		return ValueNoise<W>(seed, x, y);
+	else if constexpr (Type == NoiseType::Perlin)
+		return PerlinNoise<W>(seed, x, y);
+	else if constexpr (Type == NoiseType::Simplex)
+		return SimplexNoise<W>(seed, x, y);
+	else
+		return CellularNoise<W>(seed, x, y);
+}
+
+template<typename W, NoiseType::Enum Type>
+FE_FORCEINLINE typename W::F BaseNoise(typename W::I seed, typename W::F x, typename W::F y, typename W::F z) {
+	if constexpr (Type == NoiseType::Value)
+		return ValueNoise<W>(seed, x, y, z);
+	else if constexpr (Type == NoiseType::Perlin)
+		return PerlinNoise<W>(seed, x, y, z);
+	else if constexpr (Type == NoiseType::Simplex)
+		return SimplexNoise<W>(seed, x, y, z);
+	else
+		return CellularNoise<W>(seed, x, y, z);
+}
+
+// The octave frequencies and amplitudes are computed in scalar floats, the
+//	same way for every lane type. Each octave uses the next seed.
+template<typename W, NoiseType::Enum Type, typename... Coordinates>
+FE_FORCEINLINE typename W::F FractalNoise(const NoiseParams_t& params, Coordinates... coordinates) {
+	uint32_t octaves = params.octaves > 0 ? params.octaves : 1;
+	float frequency = params.frequency;
+	float amplitude = 1.f;
+	float totalAmplitude = 0.f;
+	typename W::F sum = W::Set(0.f);
+
+	for (uint32_t octave = 0; octave < octaves; octave++) {
+		typename W::F noise = BaseNoise<W, Type>(W::SetInt(params.seed + octave), W::Mul(coordinates, W::Set(frequency))...);
+
+		sum = W::Add(sum, W::Mul(noise, W::Set(amplitude)));
+		totalAmplitude += amplitude;
+		frequency *= params.lacunarity;
+		amplitude *= params.gain;
+	}
+
+	return W::Mul(sum, W::Set(1.f / totalAmplitude));
+}
+
+// The tail goes through a padded buffer so it runs the same code.
+template<typename W, NoiseType::Enum Type, size_t Dimensions>
+void FractalNoiseArray(const NoiseParams_t& params, const float* const* pCoordinates, size_t count, float* pOut) {
+	auto sample = [&params](const float* const* pLanes, size_t offset) {
+		if constexpr (Dimensions == 2)
+			return FractalNoise<W, Type>(params, W::Load(pLanes[0] + offset), W::Load(pLanes[1] + offset));
+		else
+			return FractalNoise<W, Type>(params, W::Load(pLanes[0] + offset), W::Load(pLanes[1] + offset), W::Load(pLanes[2] + offset));
+	};
+
+	size_t i = 0;
+
+	for (; i + W::Lanes <= count; i += W::Lanes) {
+		W::Store(pOut + i, sample(pCoordinates, i));
+	}
+
+	if (i < count) {
+		float padded[Dimensions][W::Lanes] = {};
+		const float* pPadded[Dimensions];
+		float result[W::Lanes];
+
+		for (size_t d = 0; d < Dimensions; d++) {
+			for (size_t lane = 0; lane < count - i; lane++) {
+				padded[d][lane] = pCoordinates[d][i + lane];
+			}
+
+			pPadded[d] = padded[d];
+		}
+
+		W::Store(result, sample(pPadded, 0));
+
+		for (size_t lane = 0; lane < count - i; lane++) {
+			pOut[i + lane] = result[lane];
+		}
+	}
+}
+
+template<typename W, size_t Dimensions>
+void NoiseArray(const NoiseParams_t& params, const float* const* pCoordinates, size_t count, float* pOut) {
+	switch (params.type) {
+	case NoiseType::Value: FractalNoiseArray<W, NoiseType::Value, Dimensions>(params, pCoordinates, count, pOut); break;
+	case NoiseType::Perlin: FractalNoiseArray<W, NoiseType::Perlin, Dimensions>(params, pCoordinates, count, pOut); break;
+	case NoiseType::Simplex: FractalNoiseArray<W, NoiseType::Simplex, Dimensions>(params, pCoordinates, count, pOut); break;
+	case NoiseType::Cellular: FractalNoiseArray<W, NoiseType::Cellular, Dimensions>(params, pCoordinates, count, pOut); break;
+	}
+}
\ No newline at end of file
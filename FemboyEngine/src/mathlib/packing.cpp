@@ -0,0 +1,423 @@
+#include "packing.h"
+#include "dispatch.h"
+
+namespace fe::math {
+
+// ===============================================
+// Scalar implementations
+// ===============================================
+static void FloatToHalf_Scalar(const float* pIn, size_t count, uint16_t* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = FloatToHalf(pIn[i]);
+	}
+}
+
+static void HalfToFloat_Scalar(const uint16_t* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = HalfToFloat(pIn[i]);
+	}
+}
+
+static void PackSnorm16_Scalar(const float* pIn, size_t count, int16_t* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = PackSnorm16(pIn[i]);
+	}
+}
+
+static void UnpackSnorm16_Scalar(const int16_t* pIn, size_t count, float* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = UnpackSnorm16(pIn[i]);
+	}
+}
+
+static void PackOctahedralNormals_Scalar(const float* pXs, const float* pYs, const float* pZs, size_t count, uint32_t* pOut) {
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = PackOctahedral16(Vector3(pXs[i], pYs[i], pZs[i]));
+	}
+}
+
+static void UnpackOctahedralNormals_Scalar(const uint32_t* pIn, size_t count, float* pXs, float* pYs, float* pZs) {
+	for (size_t i = 0; i < count; i++) {
+		Vector3 n = UnpackOctahedral16(pIn[i]);
+
+		pXs[i] = n.x;
+		pYs[i] = n.y;
+		pZs[i] = n.z;
+	}
+}
+
+static void PackTangentFrames_Scalar(const float* pNormalXs, const float* pNormalYs, const float* pNormalZs,
+	const float* pTangentXs, const float* pTangentYs, const float* pTangentZs, const float* pSigns,
+	size_t count, PackedTangentFrame_t* pOut)
+{
+	for (size_t i = 0; i < count; i++) {
+		pOut[i] = PackTangentFrame(
+			Vector3(pNormalXs[i], pNormalYs[i], pNormalZs[i]),
+			Vector4(pTangentXs[i], pTangentYs[i], pTangentZs[i], pSigns[i])
+		);
+	}
+}
+
+// ===============================================
+// SSE implementations
+// ===============================================
+#if FE_SIMD_SSE
+FE_FORCEINLINE __m128i Select_SSE(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Same steps as FloatToHalf on every lane, the result is in the low 16 bits.
+FE_FORCEINLINE __m128i FloatToHalf_SSE(__m128 f) {
+	__m128i bits = _mm_castps_si128(f);
+	__m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+	__m128i absBits = _mm_xor_si128(bits, sign);
+
+	__m128i isNaN = _mm_cmpgt_epi32(absBits, _mm_set1_epi32(0x7F800000));
+	__m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absBits);
+	__m128i isSubnormal = _mm_cmpgt_epi32(_mm_set1_epi32(113 << 23), absBits);
+
+	__m128i infOrNaN = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+
+	__m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+	__m128 shifted = _mm_add_ps(_mm_castsi128_ps(absBits), _mm_castsi128_ps(subnormalMagic));
+	__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(shifted), subnormalMagic);
+
+	__m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(absBits, 13), _mm_set1_epi32(1));
+	__m128i normal = _mm_add_epi32(absBits, _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(15 - 127) << 23) + 0xFFF));
+	normal = _mm_srli_epi32(_mm_add_epi32(normal, mantissaOdd), 13);
+
+	__m128i result = Select_SSE(isRegular, Select_SSE(isSubnormal, subnormal, normal), infOrNaN);
+
+	return _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+}
+
+// h holds one half per 32 bit lane.
+FE_FORCEINLINE __m128 HalfToFloat_SSE(__m128i h) {
+	__m128i shiftedExponent = _mm_set1_epi32(0x7C00 << 13);
+
+	__m128i bits = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+	__m128i exponent = _mm_and_si128(bits, shiftedExponent);
+	bits = _mm_add_epi32(bits, _mm_set1_epi32((127 - 15) << 23));
+
+	__m128i isInfOrNaN = _mm_cmpeq_epi32(exponent, shiftedExponent);
+	__m128i isSubnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+
+	bits = _mm_add_epi32(bits, _mm_and_si128(isInfOrNaN, _mm_set1_epi32((128 - 16) << 23)));
+
+	__m128i magic = _mm_set1_epi32(113 << 23);
+	__m128 subnormal = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))), _mm_castsi128_ps(magic));
+	bits = Select_SSE(isSubnormal, _mm_castps_si128(subnormal), bits);
+
+	__m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+
+	return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
+
+// Narrows eight 16 bit values held in 32 bit lanes to one register.
+FE_FORCEINLINE __m128i Narrow16_SSE(__m128i low, __m128i high) {
+	low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+	high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+
+	return _mm_packs_epi32(low, high);
+}
+
+FE_FORCEINLINE __m128i PackSnorm16_SSE(__m128 v) {
+	v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.f)), _mm_set1_ps(1.f));
+
+	return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(32767.f)));
+}
+
+// v holds one signed 16 bit value per 32 bit lane.
+FE_FORCEINLINE __m128 UnpackSnorm16_SSE(__m128i v) {
+	__m128 result = _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.f / 32767.f));
+
+	return _mm_max_ps(result, _mm_set1_ps(-1.f));
+}
+
+FE_FORCEINLINE __m128 CopySign_SSE(__m128 magnitude, __m128 v) {
+	// Matches the v >= 0 ? 1 : -1 in the scalar version, -0 counts as positive.
+	__m128 negative = _mm_cmplt_ps(v, _mm_setzero_ps());
+
+	return _mm_or_ps(magnitude, _mm_and_ps(negative, _mm_set1_ps(-0.f)));
+}
+
+FE_FORCEINLINE __m128i PackOctahedral16_SSE(__m128 x, __m128 y, __m128 z) {
+	__m128 signMask = _mm_set1_ps(-0.f);
+	__m128 absSum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z));
+	__m128 ratio = _mm_div_ps(_mm_set1_ps(1.f), absSum);
+	__m128 u = _mm_mul_ps(x, ratio);
+	__m128 v = _mm_mul_ps(y, ratio);
+
+	__m128 foldedU = CopySign_SSE(_mm_sub_ps(_mm_set1_ps(1.f), _mm_andnot_ps(signMask, v)), u);
+	__m128 foldedV = CopySign_SSE(_mm_sub_ps(_mm_set1_ps(1.f), _mm_andnot_ps(signMask, u)), v);
+	__m128 fold = _mm_cmplt_ps(z, _mm_setzero_ps());
+
+	u = _mm_or_ps(_mm_and_ps(fold, foldedU), _mm_andnot_ps(fold, u));
+	v = _mm_or_ps(_mm_and_ps(fold, foldedV), _mm_andnot_ps(fold, v));
+
+	__m128i packedU = _mm_and_si128(PackSnorm16_SSE(u), _mm_set1_epi32(0xFFFF));
+	__m128i packedV = _mm_slli_epi32(PackSnorm16_SSE(v), 16);
+
+	return _mm_or_si128(packedU, packedV);
+}
+
+FE_FORCEINLINE void UnpackOctahedral16_SSE(__m128i packed, __m128& x, __m128& y, __m128& z) {
+	__m128 signMask = _mm_set1_ps(-0.f);
+	__m128 u = UnpackSnorm16_SSE(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16));
+	__m128 v = UnpackSnorm16_SSE(_mm_srai_epi32(packed, 16));
+
+	x = u;
+	y = v;
+	z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_andnot_ps(signMask, u)), _mm_andnot_ps(signMask, v));
+
+	__m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+
+	// x += x >= 0 ? -t : t
+	x = _mm_add_ps(x, _mm_xor_ps(t, _mm_andnot_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), signMask)));
+	y = _mm_add_ps(y, _mm_xor_ps(t, _mm_andnot_ps(_mm_cmplt_ps(y, _mm_setzero_ps()), signMask)));
+
+	__m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+	__m128 ratio = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(lengthSqr));
+
+	x = _mm_mul_ps(x, ratio);
+	y = _mm_mul_ps(y, ratio);
+	z = _mm_mul_ps(z, ratio);
+}
+
+static void FloatToHalf_SSE(const float* pIn, size_t count, uint16_t* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i low = FloatToHalf_SSE(_mm_loadu_ps(pIn + i));
+		__m128i high = FloatToHalf_SSE(_mm_loadu_ps(pIn + i + 4));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), Narrow16_SSE(low, high));
+	}
+
+	FloatToHalf_Scalar(pIn + i, count - i, pOut + i);
+}
+
+static void HalfToFloat_SSE(const uint16_t* pIn, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+		_mm_storeu_ps(pOut + i, HalfToFloat_SSE(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+		_mm_storeu_ps(pOut + i + 4, HalfToFloat_SSE(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+	}
+
+	HalfToFloat_Scalar(pIn + i, count - i, pOut + i);
+}
+
+static void PackSnorm16_SSE(const float* pIn, size_t count, int16_t* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i low = PackSnorm16_SSE(_mm_loadu_ps(pIn + i));
+		__m128i high = PackSnorm16_SSE(_mm_loadu_ps(pIn + i + 4));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packs_epi32(low, high));
+	}
+
+	PackSnorm16_Scalar(pIn + i, count - i, pOut + i);
+}
+
+static void UnpackSnorm16_SSE(const int16_t* pIn, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+		// Unpacking into the high half and shifting back sign extends.
+		_mm_storeu_ps(pOut + i, UnpackSnorm16_SSE(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)));
+		_mm_storeu_ps(pOut + i + 4, UnpackSnorm16_SSE(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)));
+	}
+
+	UnpackSnorm16_Scalar(pIn + i, count - i, pOut + i);
+}
+
+static void PackOctahedralNormals_SSE(const float* pXs, const float* pYs, const float* pZs, size_t count, uint32_t* pOut) {
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i packed = PackOctahedral16_SSE(_mm_loadu_ps(pXs + i), _mm_loadu_ps(pYs + i), _mm_loadu_ps(pZs + i));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), packed);
+	}
+
+	PackOctahedralNormals_Scalar(pXs + i, pYs + i, pZs + i, count - i, pOut + i);
+}
+
+static void UnpackOctahedralNormals_SSE(const uint32_t* pIn, size_t count, float* pXs, float* pYs, float* pZs) {
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		UnpackOctahedral16_SSE(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i)), x, y, z);
+
+		_mm_storeu_ps(pXs + i, x);
+		_mm_storeu_ps(pYs + i, y);
+		_mm_storeu_ps(pZs + i, z);
+	}
+
+	UnpackOctahedralNormals_Scalar(pIn + i, count - i, pXs + i, pYs + i, pZs + i);
+}
+
+static void PackTangentFrames_SSE(const float* pNormalXs, const float* pNormalYs, const float* pNormalZs,
+	const float* pTangentXs, const float* pTangentYs, const float* pTangentZs, const float* pSigns,
+	size_t count, PackedTangentFrame_t* pOut)
+{
+	size_t i = 0;
+
+	auto packUnorm10 = [](__m128 v) {
+		v = _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(0.5f)), _mm_set1_ps(0.5f));
+		v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.f));
+
+		return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(1023.f)));
+	};
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i normals = PackOctahedral16_SSE(_mm_loadu_ps(pNormalXs + i), _mm_loadu_ps(pNormalYs + i), _mm_loadu_ps(pNormalZs + i));
+
+		__m128i tangents = packUnorm10(_mm_loadu_ps(pTangentXs + i));
+		tangents = _mm_or_si128(tangents, _mm_slli_epi32(packUnorm10(_mm_loadu_ps(pTangentYs + i)), 10));
+		tangents = _mm_or_si128(tangents, _mm_slli_epi32(packUnorm10(_mm_loadu_ps(pTangentZs + i)), 20));
+
+		__m128 positive = _mm_cmpge_ps(_mm_loadu_ps(pSigns + i), _mm_setzero_ps());
+		tangents = _mm_or_si128(tangents, _mm_and_si128(_mm_castps_si128(positive), _mm_set1_epi32(3 << 30)));
+
+		// PackedTangentFrame_t is {normal, tangent}, interleave the two.
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_unpacklo_epi32(normals, tangents));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i + 2), _mm_unpackhi_epi32(normals, tangents));
+	}
+
+	PackTangentFrames_Scalar(pNormalXs + i, pNormalYs + i, pNormalZs + i, pTangentXs + i, pTangentYs + i, pTangentZs + i, pSigns + i, count - i, pOut + i);
+}
+
+// ===============================================
+// AVX2 implementations
+// ===============================================
+// Half conversions use F16C, which rounds the same way as FloatToHalf.
+static FE_TARGET_AVX2 void FloatToHalf_AVX2(const float* pIn, size_t count, uint16_t* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(pIn + i), _MM_FROUND_TO_NEAREST_INT);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), h);
+	}
+
+	FloatToHalf_Scalar(pIn + i, count - i, pOut + i);
+}
+
+static FE_TARGET_AVX2 void HalfToFloat_AVX2(const uint16_t* pIn, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+		_mm256_storeu_ps(pOut + i, _mm256_cvtph_ps(h));
+	}
+
+	HalfToFloat_Scalar(pIn + i, count - i, pOut + i);
+}
+
+static FE_TARGET_AVX2 void PackSnorm16_AVX2(const float* pIn, size_t count, int16_t* pOut) {
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m256 low = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(pIn + i), _mm256_set1_ps(-1.f)), _mm256_set1_ps(1.f));
+		__m256 high = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(pIn + i + 8), _mm256_set1_ps(-1.f)), _mm256_set1_ps(1.f));
+
+		__m256i lowInt = _mm256_cvtps_epi32(_mm256_mul_ps(low, _mm256_set1_ps(32767.f)));
+		__m256i highInt = _mm256_cvtps_epi32(_mm256_mul_ps(high, _mm256_set1_ps(32767.f)));
+
+		// packs works per 128 bit lane, put the quarters back in order.
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lowInt, highInt), _MM_SHUFFLE(3, 1, 2, 0));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), packed);
+	}
+
+	PackSnorm16_SSE(pIn + i, count - i, pOut + i);
+}
+
+static FE_TARGET_AVX2 void UnpackSnorm16_AVX2(const int16_t* pIn, size_t count, float* pOut) {
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i)));
+		__m256 result = _mm256_mul_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(1.f / 32767.f));
+
+		_mm256_storeu_ps(pOut + i, _mm256_max_ps(result, _mm256_set1_ps(-1.f)));
+	}
+
+	UnpackSnorm16_Scalar(pIn + i, count - i, pOut + i);
+}
+#endif
+
+// ===============================================
+// Dispatch
+// ===============================================
+using FloatToHalfKernel_t = void(*)(const float* pIn, size_t count, uint16_t* pOut);
+using HalfToFloatKernel_t = void(*)(const uint16_t* pIn, size_t count, float* pOut);
+using PackSnorm16Kernel_t = void(*)(const float* pIn, size_t count, int16_t* pOut);
+using UnpackSnorm16Kernel_t = void(*)(const int16_t* pIn, size_t count, float* pOut);
+using PackOctahedralKernel_t = void(*)(const float* pXs, const float* pYs, const float* pZs, size_t count, uint32_t* pOut);
+using UnpackOctahedralKernel_t = void(*)(const uint32_t* pIn, size_t count, float* pXs, float* pYs, float* pZs);
+using PackTangentFramesKernel_t = void(*)(const float* pNormalXs, const float* pNormalYs, const float* pNormalZs,
+	const float* pTangentXs, const float* pTangentYs, const float* pTangentZs, const float* pSigns,
+	size_t count, PackedTangentFrame_t* pOut);
+
+static SimdDispatch<FloatToHalfKernel_t> floatToHalf(FE_SIMD_VARIANTS(FloatToHalf));
+static SimdDispatch<HalfToFloatKernel_t> halfToFloat(FE_SIMD_VARIANTS(HalfToFloat));
+static SimdDispatch<PackSnorm16Kernel_t> packSnorm16(FE_SIMD_VARIANTS(PackSnorm16));
+static SimdDispatch<UnpackSnorm16Kernel_t> unpackSnorm16(FE_SIMD_VARIANTS(UnpackSnorm16));
+
+// The octahedral kernels are mostly divides and square roots, AVX2 adds
+//	little over SSE here.
+#if FE_SIMD_SSE
+static SimdDispatch<PackOctahedralKernel_t> packOctahedralNormals(PackOctahedralNormals_Scalar, PackOctahedralNormals_SSE);
+static SimdDispatch<UnpackOctahedralKernel_t> unpackOctahedralNormals(UnpackOctahedralNormals_Scalar, UnpackOctahedralNormals_SSE);
+static SimdDispatch<PackTangentFramesKernel_t> packTangentFrames(PackTangentFrames_Scalar, PackTangentFrames_SSE);
+#else
+static SimdDispatch<PackOctahedralKernel_t> packOctahedralNormals(PackOctahedralNormals_Scalar);
+static SimdDispatch<UnpackOctahedralKernel_t> unpackOctahedralNormals(UnpackOctahedralNormals_Scalar);
+static SimdDispatch<PackTangentFramesKernel_t> packTangentFrames(PackTangentFrames_Scalar);
+#endif
+
+// ===============================================
+// Public interface
+// ===============================================
+void FloatToHalfArray(const float* pIn, size_t count, uint16_t* pOut) {
+	floatToHalf(pIn, count, pOut);
+}
+
+void HalfToFloatArray(const uint16_t* pIn, size_t count, float* pOut) {
+	halfToFloat(pIn, count, pOut);
+}
+
+void PackSnorm16Array(const float* pIn, size_t count, int16_t* pOut) {
+	packSnorm16(pIn, count, pOut);
+}
+
+void UnpackSnorm16Array(const int16_t* pIn, size_t count, float* pOut) {
+	unpackSnorm16(pIn, count, pOut);
+}
+
+void PackOctahedralNormals(const float* pXs, const float* pYs, const float* pZs, size_t count, uint32_t* pOut) {
+	packOctahedralNormals(pXs, pYs, pZs, count, pOut);
+}
+
+void UnpackOctahedralNormals(const uint32_t* pIn, size_t count, float* pXs, float* pYs, float* pZs) {
+	unpackOctahedralNormals(pIn, count, pXs, pYs, pZs);
+}
+
+void PackTangentFrames(const float* pNormalXs, const float* pNormalYs, const float* pNormalZs,
+	const float* pTangentXs, const float* pTangentYs, const float* pTangentZs, const float* pSigns,
+	size_t count, PackedTangentFrame_t* pOut)
+{
+	packTangentFrames(pNormalXs, pNormalYs, pNormalZs, pTangentXs, pTangentYs, pTangentZs, pSigns, count, pOut);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "mathlib.h"
+#include "vector.h"
+
+#include <bit>
+#include <cstdint>
+
+namespace fe::math {
+
+// Quantization for packed vertex attributes. The layouts match the
+//	render::RenderFormat values noted on each function, with the first
+//	component in the lowest bits.
+
+// ===============================================
+// Half floats (R16G16_Float, R16G16B16A16_Float)
+// ===============================================
+// Rounds to nearest even. Values above the half range become infinity,
+//	NaNs stay NaN.
+constexpr uint16_t FloatToHalf(float f) {
+	constexpr uint32_t infinity = 255u << 23;
+	constexpr uint32_t halfMax = (127u + 16u) << 23;
+	constexpr uint32_t subnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+	uint32_t bits = std::bit_cast<uint32_t>(f);
+	uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	uint16_t result;
+
+	if (bits >= halfMax) {
+		result = bits > infinity ? 0x7E00 : 0x7C00;
+	}
+	else if (bits < (113u << 23)) {
+		// Let the float adder do the rounding of the subnormal mantissa.
+		float shifted = std::bit_cast<float>(bits) + std::bit_cast<float>(subnormalMagic);
+		result = static_cast<uint16_t>(std::bit_cast<uint32_t>(shifted) - subnormalMagic);
+	}
+	else {
+		uint32_t mantissaOdd = (bits >> 13) & 1u;
+		bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + mantissaOdd;
+		result = static_cast<uint16_t>(bits >> 13);
+	}
+
+	return static_cast<uint16_t>(result | (sign >> 16));
+}
+
+constexpr float HalfToFloat(uint16_t h) {
+	constexpr uint32_t shiftedExponent = 0x7C00u << 13;
+
+	uint32_t bits = (h & 0x7FFFu) << 13;
+	uint32_t exponent = bits & shiftedExponent;
+	bits += (127u - 15u) << 23;
+
+	if (exponent == shiftedExponent) {
+		bits += (128u - 16u) << 23;
+	}
+	else if (exponent == 0) {
+		bits += 1u << 23;
+		bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(113u << 23));
+	}
+
+	return std::bit_cast<float>(bits | (static_cast<uint32_t>(h & 0x8000u) << 16));
+}
+
+// ===============================================
+// Normalized integers (R16G16_SNorm, R16G16B16A16_SNorm, R10G10B10A2_UNorm)
+// ===============================================
+inline int16_t PackSnorm16(float v) {
+	v = v > 1.f ? 1.f : (v < -1.f ? -1.f : v);
+
+	return static_cast<int16_t>(lrintf(v * 32767.f));
+}
+
+constexpr float UnpackSnorm16(int16_t v) {
+	float result = static_cast<float>(v) * (1.f / 32767.f);
+
+	return result < -1.f ? -1.f : result;
+}
+
+inline uint32_t PackUnorm1010102(const Vector4& v) {
+	auto pack = [](float f, float scale) {
+		f = f > 1.f ? 1.f : (f < 0.f ? 0.f : f);
+		return static_cast<uint32_t>(lrintf(f * scale));
+	};
+
+	return pack(v.x, 1023.f) | (pack(v.y, 1023.f) << 10) | (pack(v.z, 1023.f) << 20) | (pack(v.w, 3.f) << 30);
+}
+
+constexpr Vector4 UnpackUnorm1010102(uint32_t v) {
+	return Vector4(
+		static_cast<float>(v & 0x3FFu) * (1.f / 1023.f),
+		static_cast<float>((v >> 10) & 0x3FFu) * (1.f / 1023.f),
+		static_cast<float>((v >> 20) & 0x3FFu) * (1.f / 1023.f),
+		static_cast<float>(v >> 30) * (1.f / 3.f)
+	);
+}
+
+// ===============================================
+// Octahedral normals (R16G16_SNorm)
+// ===============================================
+// Maps a unit vector onto the octahedron and unfolds it into a square,
+//	4 bytes per normal with a max error of about 0.04 degrees.
+//	The shader decodes it with the same math as UnpackOctahedral16.
+inline uint32_t PackOctahedral16(const Vector3& n) {
+	float ratio = 1.f / (fabsf(n.x) + fabsf(n.y) + fabsf(n.z));
+	float u = n.x * ratio;
+	float v = n.y * ratio;
+
+	if (n.z < 0.f) {
+		float foldedU = (1.f - fabsf(v)) * (u >= 0.f ? 1.f : -1.f);
+		float foldedV = (1.f - fabsf(u)) * (v >= 0.f ? 1.f : -1.f);
+
+		u = foldedU;
+		v = foldedV;
+	}
+
+	return static_cast<uint16_t>(PackSnorm16(u)) | (static_cast<uint32_t>(static_cast<uint16_t>(PackSnorm16(v))) << 16);
+}
+
+inline Vector3 UnpackOctahedral16(uint32_t packed) {
+	float u = UnpackSnorm16(static_cast<int16_t>(packed & 0xFFFFu));
+	float v = UnpackSnorm16(static_cast<int16_t>(packed >> 16));
+
+	Vector3 n(u, v, 1.f - fabsf(u) - fabsf(v));
+	float t = n.z < 0.f ? -n.z : 0.f;
+
+	n.x += n.x >= 0.f ? -t : t;
+	n.y += n.y >= 0.f ? -t : t;
+
+	return n * (1.f / Sqrt(VectorLengthSqr(n)));
+}
+
+// ===============================================
+// Tangent frames
+// ===============================================
+// Normal as octahedral R16G16_SNorm and tangent as R10G10B10A2_UNorm, 8 bytes
+//	instead of 28. The tangent is stored as t * 0.5 + 0.5 and the alpha bits
+//	hold the bitangent sign, 1 for positive and 0 for negative.
+struct PackedTangentFrame_t {
+	uint32_t normal;
+	uint32_t tangent;
+};
+
+// tangent.w is the bitangent sign, bitangent = cross(normal, tangent) * w.
+inline PackedTangentFrame_t PackTangentFrame(const Vector3& normal, const Vector4& tangent) {
+	PackedTangentFrame_t result;
+	result.normal = PackOctahedral16(normal);
+	result.tangent = PackUnorm1010102(Vector4(tangent.XYZ() * 0.5f + Vector3(0.5f, 0.5f, 0.5f), tangent.w < 0.f ? 0.f : 1.f));
+
+	return result;
+}
+
+inline void UnpackTangentFrame(const PackedTangentFrame_t& packed, Vector3& normal, Vector4& tangent) {
+	Vector4 t = UnpackUnorm1010102(packed.tangent);
+
+	normal = UnpackOctahedral16(packed.normal);
+	tangent = Vector4(t.XYZ() * 2.f - Vector3(1.f, 1.f, 1.f), t.w * 2.f - 1.f);
+}
+
+// ===============================================
+// Batch versions
+// ===============================================
+// Same results as the functions above up to the last bit of the decoded
+//	normals, picked through the SIMD dispatch.
+//	Normals are component arrays like in batch.h.
+void FloatToHalfArray(const float* pIn, size_t count, uint16_t* pOut);
+void HalfToFloatArray(const uint16_t* pIn, size_t count, float* pOut);
+
+void PackSnorm16Array(const float* pIn, size_t count, int16_t* pOut);
+void UnpackSnorm16Array(const int16_t* pIn, size_t count, float* pOut);
+
+// The normals must be non-zero, they don't need to be normalized.
+void PackOctahedralNormals(const float* pXs, const float* pYs, const float* pZs, size_t count, uint32_t* pOut);
+void UnpackOctahedralNormals(const uint32_t* pIn, size_t count, float* pXs, float* pYs, float* pZs);
+
+void PackTangentFrames(const float* pNormalXs, const float* pNormalYs, const float* pNormalZs,
+	const float* pTangentXs, const float* pTangentYs, const float* pTangentZs, const float* pSigns,
+	size_t count, PackedTangentFrame_t* pOut);
+
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "vector.h"
+
+namespace fe::math {
+
+class alignas(SimdAlignment) Quaternion {
+public:
+	float x, y, z, w;
+
+	constexpr Quaternion()
+		: x(0.f), y(0.f), z(0.f), w(1.f) {}
+
+	constexpr Quaternion(float x, float y, float z, float w)
+		: x(x), y(y), z(z), w(w) {}
+
+	constexpr Quaternion(const Vector3& xyz, float w)
+		: x(xyz.x), y(xyz.y), z(xyz.z), w(w) {}
+
+	static constexpr Quaternion Identity() {
+		return Quaternion(0.f, 0.f, 0.f, 1.f);
+	}
+
+	constexpr Vector3 XYZ() const { return Vector3(x, y, z); }
+
+	constexpr Quaternion operator*(const Quaternion& q) const;
+	constexpr Quaternion& operator*=(const Quaternion& q) { return *this = *this * q; }
+
+	constexpr bool operator==(const Quaternion& q) const = default;
+};
+
+constexpr Quaternion MakeRotationQuaternion(const Vector3& axis, float angle) {
+	float halfAngle = angle * 0.5f;
+
+	return Quaternion(NormalizeVector(axis) * Sin(halfAngle), Cos(halfAngle));
+}
+
+constexpr float DotProduct(const Quaternion& A, const Quaternion& B) {
+	return (A.x * B.x + A.y * B.y + A.z * B.z + A.w * B.w);
+}
+
+// Applies B first, then A.
+constexpr Quaternion QuaternionMultiply(const Quaternion& A, const Quaternion& B) {
+	return Quaternion(
+		A.w * B.x + A.x * B.w + A.y * B.z - A.z * B.y,
+		A.w * B.y - A.x * B.z + A.y * B.w + A.z * B.x,
+		A.w * B.z + A.x * B.y - A.y * B.x + A.z * B.w,
+		A.w * B.w - A.x * B.x - A.y * B.y - A.z * B.z
+	);
+}
+
+constexpr Quaternion Quaternion::operator*(const Quaternion& q) const {
+	return QuaternionMultiply(*this, q);
+}
+
+// Equal to the inverse for unit quaternions.
+constexpr Quaternion ConjugateQuaternion(const Quaternion& q) {
+	return Quaternion(-q.x, -q.y, -q.z, q.w);
+}
+
+constexpr Quaternion NormalizeQuaternion(const Quaternion& q) {
+	float ratio = 1.f / Sqrt(DotProduct(q, q));
+
+	return Quaternion(q.x * ratio, q.y * ratio, q.z * ratio, q.w * ratio);
+}
+
+constexpr Vector3 RotateVector(const Quaternion& q, const Vector3& v) {
+	Vector3 qv = q.XYZ();
+	Vector3 t = CrossProduct(qv, v) * 2.f;
+
+	return v + t * q.w + CrossProduct(qv, t);
+}
+
+// Normalized linear interpolation, takes the shortest path.
+//	Cheaper than QuaternionSlerp but the angular speed is not constant.
+constexpr Quaternion QuaternionNlerp(const Quaternion& A, const Quaternion& B, float t) {
+	float sign = DotProduct(A, B) < 0.f ? -1.f : 1.f;
+	float s0 = 1.f - t;
+	float s1 = t * sign;
+
+	return NormalizeQuaternion(Quaternion(
+		A.x * s0 + B.x * s1,
+		A.y * s0 + B.y * s1,
+		A.z * s0 + B.z * s1,
+		A.w * s0 + B.w * s1
+	));
+}
+
+// Spherical linear interpolation, takes the shortest path.
+inline Quaternion QuaternionSlerp(const Quaternion& A, const Quaternion& B, float t) {
+	float cosTheta = DotProduct(A, B);
+	float sign = 1.f;
+
+	if (cosTheta < 0.f) {
+		cosTheta = -cosTheta;
+		sign = -1.f;
+	}
+
+	// Nearly parallel, sin(theta) would blow up.
+	if (cosTheta > 0.9995f) {
+		return QuaternionNlerp(A, B, t);
+	}
+
+	float theta = acosf(cosTheta);
+	float invSinTheta = 1.f / sinf(theta);
+	float s0 = sinf((1.f - t) * theta) * invSinTheta;
+	float s1 = sinf(t * theta) * invSinTheta * sign;
+
+	return Quaternion(
+		A.x * s0 + B.x * s1,
+		A.y * s0 + B.y * s1,
+		A.z * s0 + B.z * s1,
+		A.w * s0 + B.w * s1
+	);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+// SIMD configuration for mathlib.
+// SSE2 is the baseline on every x64 target, AVX paths are only used when
+// the compiler is allowed to emit them (/arch:AVX or -mavx).
+// Define FE_MATH_NO_SIMD to force the scalar fallbacks everywhere.
+
+#if !defined(FE_MATH_NO_SIMD) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__))
+#define FE_SIMD_SSE 1
+#else
+#define FE_SIMD_SSE 0
+#endif
+
+#if FE_SIMD_SSE && defined(__AVX__)
+#define FE_SIMD_AVX 1
+#else
+#define FE_SIMD_AVX 0
+#endif
+
+#if FE_SIMD_SSE && defined(__AVX2__)
+#define FE_SIMD_AVX2 1
+#else
+#define FE_SIMD_AVX2 0
+#endif
+
+#include <cstddef>
+
+#if FE_SIMD_SSE
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define FE_FORCEINLINE __forceinline
+#else
+#define FE_FORCEINLINE inline __attribute__((always_inline))
+#endif
+
+// Marks a function that uses AVX2, FMA and F16C intrinsics regardless of the
+//	compiler flags. MSVC allows this without annotations, GCC and Clang need
+//	the target attribute. Only call these after checking the CPU supports it.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define FE_TARGET_AVX2
+#else
+#define FE_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#endif
+
+// Enables AVX2 for every function defined between the two macros, templates
+//	included, so generic code can be compiled a second time for AVX2. FMA is
+//	left out on purpose, the compiler can't fuse multiply-adds and the code
+//	gives the same results as its SSE2 version.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define FE_BEGIN_TARGET_AVX2_NO_FMA
+#define FE_END_TARGET_AVX2_NO_FMA
+#elif defined(__clang__)
+#define FE_BEGIN_TARGET_AVX2_NO_FMA _Pragma("clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+#define FE_END_TARGET_AVX2_NO_FMA _Pragma("clang attribute pop")
+#else
+#define FE_BEGIN_TARGET_AVX2_NO_FMA _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define FE_END_TARGET_AVX2_NO_FMA _Pragma("GCC pop_options")
+#endif
+
+namespace fe::math {
+
+constexpr size_t SimdAlignment = 16;
+
+#if FE_SIMD_SSE
+// Shuffle helper, picks lanes (x, y, z, w) from v.
+#define FE_SHUFFLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), _MM_SHUFFLE((w), (z), (y), (x)))
+
+// Dot product of the xyz lanes, broadcast to all lanes.
+FE_FORCEINLINE __m128 SimdDot3(__m128 a, __m128 b) {
+	__m128 mul = _mm_mul_ps(a, b);
+	__m128 sum = _mm_add_ps(FE_SHUFFLE(mul, 0, 0, 0, 0), FE_SHUFFLE(mul, 1, 1, 1, 1));
+
+	return _mm_add_ps(sum, FE_SHUFFLE(mul, 2, 2, 2, 2));
+}
+
+// Cross product of the xyz lanes, w is zero.
+FE_FORCEINLINE __m128 SimdCross3(__m128 a, __m128 b) {
+	__m128 aYZX = FE_SHUFFLE(a, 1, 2, 0, 3);
+	__m128 bYZX = FE_SHUFFLE(b, 1, 2, 0, 3);
+	__m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+
+	// w is a.w * b.w - a.w * b.w, which isn't zero when the compiler fuses
+	//	it into an FMA, so clear it.
+	const __m128 maskXYZ = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+	return _mm_and_ps(FE_SHUFFLE(c, 1, 2, 0, 3), maskXYZ);
+}
+#endif
+
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "vector.h"
+#include "matrix.h"
+#include "quaternion.h"
+
+namespace fe::math {
+
+// Translation, rotation and scale, applied as T * R * S.
+class Transform {
+public:
+	Vector3 translation;
+	Quaternion rotation;
+	Vector3 scale;
+
+	constexpr Transform()
+		: translation(0.f, 0.f, 0.f), rotation(Quaternion::Identity()), scale(1.f, 1.f, 1.f) {}
+
+	constexpr Transform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale = Vector3(1.f, 1.f, 1.f))
+		: translation(translation), rotation(rotation), scale(scale) {}
+};
+
+constexpr Matrix3x3 MakeRotationMatrix(const Quaternion& q) {
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	return Matrix3x3(
+		Vector3(1.f - 2.f * (yy + zz), 2.f * (xy - wz), 2.f * (xz + wy)),
+		Vector3(2.f * (xy + wz), 1.f - 2.f * (xx + zz), 2.f * (yz - wx)),
+		Vector3(2.f * (xz - wy), 2.f * (yz + wx), 1.f - 2.f * (xx + yy))
+	);
+}
+
+constexpr Matrix3x4 MakeAffineMatrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) {
+	Matrix3x3 r = MakeRotationMatrix(rotation);
+
+	return Matrix3x4(
+		Vector4(r[0] * scale, translation.x),
+		Vector4(r[1] * scale, translation.y),
+		Vector4(r[2] * scale, translation.z)
+	);
+}
+
+constexpr Matrix3x4 MakeAffineMatrix(const Transform& transform) {
+	return MakeAffineMatrix(transform.translation, transform.rotation, transform.scale);
+}
+
+// Converts count transforms into matrices, for filling world matrix arrays.
+inline void MakeAffineMatrices(const Transform* pTransforms, Matrix3x4* pMatrices, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		pMatrices[i] = MakeAffineMatrix(pTransforms[i]);
+	}
+}
+
+constexpr Vector3 TransformPoint(const Transform& transform, const Vector3& p) {
+	return RotateVector(transform.rotation, p * transform.scale) + transform.translation;
+}
+
+// Linear translation and scale, normalized lerp for the rotation.
+constexpr Transform InterpolateTransforms(const Transform& A, const Transform& B, float t) {
+	return Transform(
+		A.translation + (B.translation - A.translation) * t,
+		QuaternionNlerp(A.rotation, B.rotation, t),
+		A.scale + (B.scale - A.scale) * t
+	);
+}
+
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "mathlib.h"
+#include "simd.h"
+
 namespace fe::math {
 
 class Vector3 {
@@ -20,9 +23,27 @@ public:
 
 	constexpr Vector3(float x, float y, float z)
 		: x(x), y(y), z(z) {}
+
+	constexpr Vector3 operator-() const { return Vector3(-x, -y, -z); }
+
+	constexpr Vector3 operator+(const Vector3& v) const { return Vector3(x + v.x, y + v.y, z + v.z); }
+	constexpr Vector3 operator-(const Vector3& v) const { return Vector3(x - v.x, y - v.y, z - v.z); }
+	constexpr Vector3 operator*(const Vector3& v) const { return Vector3(x * v.x, y * v.y, z * v.z); }
+	constexpr Vector3 operator/(const Vector3& v) const { return Vector3(x / v.x, y / v.y, z / v.z); }
+	constexpr Vector3 operator*(float s) const { return Vector3(x * s, y * s, z * s); }
+	constexpr Vector3 operator/(float s) const { return Vector3(x / s, y / s, z / s); }
+
+	constexpr Vector3& operator+=(const Vector3& v) { return *this = *this + v; }
+	constexpr Vector3& operator-=(const Vector3& v) { return *this = *this - v; }
+	constexpr Vector3& operator*=(const Vector3& v) { return *this = *this * v; }
+	constexpr Vector3& operator/=(const Vector3& v) { return *this = *this / v; }
+	constexpr Vector3& operator*=(float s) { return *this = *this * s; }
+	constexpr Vector3& operator/=(float s) { return *this = *this / s; }
+
+	constexpr bool operator==(const Vector3& v) const = default;
 };
 
-class Vector4 {
+class alignas(SimdAlignment) Vector4 {
 public:
 	float x, y, z, w;
 
@@ -43,14 +64,94 @@ public:
 
 	constexpr Vector4(const Vector3& xyz, float w)
 		: x(xyz.x), y(xyz.y), z(xyz.z), w(w) {}
+
+	constexpr Vector3 XYZ() const { return Vector3(x, y, z); }
+
+	constexpr Vector4 operator-() const { return Vector4(-x, -y, -z, -w); }
+
+	constexpr Vector4 operator+(const Vector4& v) const { return Vector4(x + v.x, y + v.y, z + v.z, w + v.w); }
+	constexpr Vector4 operator-(const Vector4& v) const { return Vector4(x - v.x, y - v.y, z - v.z, w - v.w); }
+	constexpr Vector4 operator*(const Vector4& v) const { return Vector4(x * v.x, y * v.y, z * v.z, w * v.w); }
+	constexpr Vector4 operator/(const Vector4& v) const { return Vector4(x / v.x, y / v.y, z / v.z, w / v.w); }
+	constexpr Vector4 operator*(float s) const { return Vector4(x * s, y * s, z * s, w * s); }
+	constexpr Vector4 operator/(float s) const { return Vector4(x / s, y / s, z / s, w / s); }
+
+	constexpr Vector4& operator+=(const Vector4& v) { return *this = *this + v; }
+	constexpr Vector4& operator-=(const Vector4& v) { return *this = *this - v; }
+	constexpr Vector4& operator*=(const Vector4& v) { return *this = *this * v; }
+	constexpr Vector4& operator/=(const Vector4& v) { return *this = *this / v; }
+	constexpr Vector4& operator*=(float s) { return *this = *this * s; }
+	constexpr Vector4& operator/=(float s) { return *this = *this / s; }
+
+	constexpr bool operator==(const Vector4& v) const = default;
 };
 
-float VectorLengthSqr(const Vector3& v);
-float VectorLength(const Vector3& v);
-float DotProduct(const Vector3& A, const Vector3& B);
+constexpr Vector3 operator*(float s, const Vector3& v) { return v * s; }
+constexpr Vector4 operator*(float s, const Vector4& v) { return v * s; }
+
+namespace detail {
+
+template<size_t Index, typename VectorType>
+constexpr float GetComponent(const VectorType& v) {
+	if constexpr (Index == 0)
+		return v.x;
+	else if constexpr (Index == 1)
+		return v.y;
+	else if constexpr (Index == 2)
+		return v.z;
+	else
+		return v.w;
+}
+
+}
+
+// Swizzle<2, 1, 0>(v) returns (v.z, v.y, v.x).
+template<size_t X, size_t Y, size_t Z, typename VectorType>
+constexpr Vector3 Swizzle(const VectorType& v) {
+	return Vector3(detail::GetComponent<X>(v), detail::GetComponent<Y>(v), detail::GetComponent<Z>(v));
+}
+
+template<size_t X, size_t Y, size_t Z, size_t W>
+constexpr Vector4 Swizzle(const Vector4& v) {
+	return Vector4(detail::GetComponent<X>(v), detail::GetComponent<Y>(v), detail::GetComponent<Z>(v), detail::GetComponent<W>(v));
+}
+
+constexpr float VectorLengthSqr(const Vector3& v) {
+	return v.x * v.x + v.y * v.y + v.z * v.z;
+}
+
+constexpr float VectorLength(const Vector3& v) {
+	return Sqrt(VectorLengthSqr(v));
+}
+
+constexpr float DotProduct(const Vector3& A, const Vector3& B) {
+	return (A.x * B.x + A.y * B.y + A.z * B.z);
+}
+
+constexpr float DotProduct(const Vector4& A, const Vector4& B) {
+	return (A.x * B.x + A.y * B.y + A.z * B.z + A.w * B.w);
+}
+
+constexpr Vector3 CrossProduct(const Vector3& A, const Vector3& B) {
+	return Vector3(
+		A.y * B.z - A.z * B.y,
+		A.z * B.x - A.x * B.z,
+		A.x * B.y - A.y * B.x
+	);
+}
+
+constexpr Vector3 NormalizeVector(const Vector3& v) {
+	float ratio = 1.f / VectorLength(v);
+
+	return v * ratio;
+}
+
+constexpr Vector3 VectorAdd(const Vector3& A, const Vector3& B) {
+	return A + B;
+}
 
-Vector3 CrossProduct(const Vector3& A, const Vector3& B);
-Vector3 NormalizeVector(const Vector3& v);
-Vector3 VectorSubtract(const Vector3& A, const Vector3& B);
+constexpr Vector3 VectorSubtract(const Vector3& A, const Vector3& B) {
+	return A - B;
+}
 
 }
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "widevector.h"
+
+#if FE_SIMD_SSE
+
+namespace fe::math {
+
+// Lane wise versions of the intersect.h tests for the wide vector types.
+//	They return the hit mask as a register and the distances in distance.
+//	The operations are in the same order as the scalar tests, so every lane
+//	gives the scalar result unless the compiler fuses multiply-adds.
+
+// ===============================================
+// SSE
+// ===============================================
+FE_FORCEINLINE __m128 IntersectRayAABB(const Vector3x4& origin, const Vector3x4& invDirection, const Vector3x4& boxMin, const Vector3x4& boxMax, __m128 maxDistance, __m128& distance) {
+	Vector3x4 t1 = (boxMin - origin) * invDirection;
+	Vector3x4 t2 = (boxMax - origin) * invDirection;
+
+	// min and max pick the second operand for NaNs, which happen for
+	//	0 * infinity when the ray is parallel to a slab.
+	__m128 tNear = _mm_max_ps(_mm_min_ps(t1.x, t2.x), _mm_setzero_ps());
+	__m128 tFar = _mm_min_ps(_mm_max_ps(t1.x, t2.x), maxDistance);
+	tNear = _mm_max_ps(_mm_min_ps(t1.y, t2.y), tNear);
+	tFar = _mm_min_ps(_mm_max_ps(t1.y, t2.y), tFar);
+	tNear = _mm_max_ps(_mm_min_ps(t1.z, t2.z), tNear);
+	tFar = _mm_min_ps(_mm_max_ps(t1.z, t2.z), tFar);
+
+	distance = tNear;
+
+	return _mm_cmple_ps(tNear, tFar);
+}
+
+FE_FORCEINLINE __m128 IntersectRaySphere(const Vector3x4& origin, const Vector3x4& direction, const Vector3x4& center, __m128 radius, __m128 maxDistance, __m128& distance) {
+	Vector3x4 oc = origin - center;
+	__m128 a = DotProduct(direction, direction);
+	__m128 b = DotProduct(oc, direction);
+	__m128 c = _mm_sub_ps(DotProduct(oc, oc), _mm_mul_ps(radius, radius));
+	__m128 root = _mm_sqrt_ps(_mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, c)));
+	__m128 minusB = _mm_xor_ps(b, _mm_set1_ps(-0.f));
+
+	__m128 tNear = _mm_max_ps(_mm_div_ps(_mm_sub_ps(minusB, root), a), _mm_setzero_ps());
+	__m128 tFar = _mm_div_ps(_mm_add_ps(minusB, root), a);
+
+	distance = tNear;
+
+	return _mm_and_ps(_mm_cmpge_ps(tFar, _mm_setzero_ps()), _mm_cmple_ps(tNear, maxDistance));
+}
+
+FE_FORCEINLINE __m128 IntersectRayPlane(const Vector3x4& origin, const Vector3x4& direction, const Vector3x4& normal, __m128 planeDistance, __m128 maxDistance, __m128& distance) {
+	__m128 t = _mm_div_ps(_mm_sub_ps(planeDistance, DotProduct(normal, origin)), DotProduct(normal, direction));
+
+	distance = t;
+
+	return _mm_and_ps(_mm_cmpge_ps(t, _mm_setzero_ps()), _mm_cmple_ps(t, maxDistance));
+}
+
+FE_FORCEINLINE __m128 IntersectRayTriangle(const Vector3x4& origin, const Vector3x4& direction, const Vector3x4& v0, const Vector3x4& v1, const Vector3x4& v2, __m128 maxDistance, __m128& distance, __m128& u, __m128& v) {
+	Vector3x4 e1 = v1 - v0;
+	Vector3x4 e2 = v2 - v0;
+	Vector3x4 p = CrossProduct(direction, e2);
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), DotProduct(e1, p));
+
+	// A zero determinant makes the barycentrics infinite or NaN, which
+	//	fails the range checks below without a separate test.
+	Vector3x4 s = origin - v0;
+	Vector3x4 q = CrossProduct(s, e1);
+	u = _mm_mul_ps(DotProduct(s, p), invDet);
+	v = _mm_mul_ps(DotProduct(direction, q), invDet);
+	distance = _mm_mul_ps(DotProduct(e2, q), invDet);
+
+	__m128 zero = _mm_setzero_ps();
+	__m128 hit = _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero));
+	hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.f)));
+	hit = _mm_and_ps(hit, _mm_cmpge_ps(distance, zero));
+
+	return _mm_and_ps(hit, _mm_cmple_ps(distance, maxDistance));
+}
+
+// ===============================================
+// AVX2
+// ===============================================
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 IntersectRayAABB(const Vector3x8& origin, const Vector3x8& invDirection, const Vector3x8& boxMin, const Vector3x8& boxMax, __m256 maxDistance, __m256& distance) {
+	Vector3x8 t1 = (boxMin - origin) * invDirection;
+	Vector3x8 t2 = (boxMax - origin) * invDirection;
+
+	__m256 tNear = _mm256_max_ps(_mm256_min_ps(t1.x, t2.x), _mm256_setzero_ps());
+	__m256 tFar = _mm256_min_ps(_mm256_max_ps(t1.x, t2.x), maxDistance);
+	tNear = _mm256_max_ps(_mm256_min_ps(t1.y, t2.y), tNear);
+	tFar = _mm256_min_ps(_mm256_max_ps(t1.y, t2.y), tFar);
+	tNear = _mm256_max_ps(_mm256_min_ps(t1.z, t2.z), tNear);
+	tFar = _mm256_min_ps(_mm256_max_ps(t1.z, t2.z), tFar);
+
+	distance = tNear;
+
+	return _mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ);
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 IntersectRaySphere(const Vector3x8& origin, const Vector3x8& direction, const Vector3x8& center, __m256 radius, __m256 maxDistance, __m256& distance) {
+	Vector3x8 oc = origin - center;
+	__m256 a = DotProduct(direction, direction);
+	__m256 b = DotProduct(oc, direction);
+	__m256 c = _mm256_sub_ps(DotProduct(oc, oc), _mm256_mul_ps(radius, radius));
+	__m256 root = _mm256_sqrt_ps(_mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(a, c)));
+	__m256 minusB = _mm256_xor_ps(b, _mm256_set1_ps(-0.f));
+
+	__m256 tNear = _mm256_max_ps(_mm256_div_ps(_mm256_sub_ps(minusB, root), a), _mm256_setzero_ps());
+	__m256 tFar = _mm256_div_ps(_mm256_add_ps(minusB, root), a);
+
+	distance = tNear;
+
+	return _mm256_and_ps(_mm256_cmp_ps(tFar, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(tNear, maxDistance, _CMP_LE_OQ));
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 IntersectRayPlane(const Vector3x8& origin, const Vector3x8& direction, const Vector3x8& normal, __m256 planeDistance, __m256 maxDistance, __m256& distance) {
+	__m256 t = _mm256_div_ps(_mm256_sub_ps(planeDistance, DotProduct(normal, origin)), DotProduct(normal, direction));
+
+	distance = t;
+
+	return _mm256_and_ps(_mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(t, maxDistance, _CMP_LE_OQ));
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 IntersectRayTriangle(const Vector3x8& origin, const Vector3x8& direction, const Vector3x8& v0, const Vector3x8& v1, const Vector3x8& v2, __m256 maxDistance, __m256& distance, __m256& u, __m256& v) {
+	Vector3x8 e1 = v1 - v0;
+	Vector3x8 e2 = v2 - v0;
+	Vector3x8 p = CrossProduct(direction, e2);
+	__m256 invDet = _mm256_div_ps(_mm256_set1_ps(1.f), DotProduct(e1, p));
+
+	Vector3x8 s = origin - v0;
+	Vector3x8 q = CrossProduct(s, e1);
+	u = _mm256_mul_ps(DotProduct(s, p), invDet);
+	v = _mm256_mul_ps(DotProduct(direction, q), invDet);
+	distance = _mm256_mul_ps(DotProduct(e2, q), invDet);
+
+	__m256 zero = _mm256_setzero_ps();
+	__m256 hit = _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+	hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(1.f), _CMP_LE_OQ));
+	hit = _mm256_and_ps(hit, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+
+	return _mm256_and_ps(hit, _mm256_cmp_ps(distance, maxDistance, _CMP_LE_OQ));
+}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "vector.h"
+#include "simd.h"
+
+#if FE_SIMD_SSE
+
+namespace fe::math {
+
+// Four Vector3 in structure of arrays layout, one register per component.
+//	Every lane does the same math as the matching Vector3 function.
+class Vector3x4 {
+public:
+	__m128 x, y, z;
+
+	Vector3x4() = default;
+
+	Vector3x4(__m128 x, __m128 y, __m128 z)
+		: x(x), y(y), z(z) {}
+
+	explicit Vector3x4(const Vector3& v)
+		: x(_mm_set1_ps(v.x)), y(_mm_set1_ps(v.y)), z(_mm_set1_ps(v.z)) {}
+
+	static Vector3x4 Load(const float* pXs, const float* pYs, const float* pZs) {
+		return Vector3x4(_mm_loadu_ps(pXs), _mm_loadu_ps(pYs), _mm_loadu_ps(pZs));
+	}
+
+	void Store(float* pXs, float* pYs, float* pZs) const {
+		_mm_storeu_ps(pXs, x);
+		_mm_storeu_ps(pYs, y);
+		_mm_storeu_ps(pZs, z);
+	}
+
+	Vector3x4 operator+(const Vector3x4& v) const { return Vector3x4(_mm_add_ps(x, v.x), _mm_add_ps(y, v.y), _mm_add_ps(z, v.z)); }
+	Vector3x4 operator-(const Vector3x4& v) const { return Vector3x4(_mm_sub_ps(x, v.x), _mm_sub_ps(y, v.y), _mm_sub_ps(z, v.z)); }
+	Vector3x4 operator*(const Vector3x4& v) const { return Vector3x4(_mm_mul_ps(x, v.x), _mm_mul_ps(y, v.y), _mm_mul_ps(z, v.z)); }
+	Vector3x4 operator*(__m128 s) const { return Vector3x4(_mm_mul_ps(x, s), _mm_mul_ps(y, s), _mm_mul_ps(z, s)); }
+};
+
+FE_FORCEINLINE __m128 DotProduct(const Vector3x4& A, const Vector3x4& B) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(A.x, B.x), _mm_mul_ps(A.y, B.y)), _mm_mul_ps(A.z, B.z));
+}
+
+FE_FORCEINLINE Vector3x4 CrossProduct(const Vector3x4& A, const Vector3x4& B) {
+	return Vector3x4(
+		_mm_sub_ps(_mm_mul_ps(A.y, B.z), _mm_mul_ps(A.z, B.y)),
+		_mm_sub_ps(_mm_mul_ps(A.z, B.x), _mm_mul_ps(A.x, B.z)),
+		_mm_sub_ps(_mm_mul_ps(A.x, B.y), _mm_mul_ps(A.y, B.x))
+	);
+}
+
+FE_FORCEINLINE Vector3x4 NormalizeVector(const Vector3x4& v) {
+	__m128 ratio = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(DotProduct(v, v)));
+
+	return v * ratio;
+}
+
+// Eight Vector3 in structure of arrays layout, needs AVX2.
+class Vector3x8 {
+public:
+	__m256 x, y, z;
+
+	Vector3x8() = default;
+
+	FE_TARGET_AVX2 Vector3x8(__m256 x, __m256 y, __m256 z)
+		: x(x), y(y), z(z) {}
+
+	FE_TARGET_AVX2 explicit Vector3x8(const Vector3& v)
+		: x(_mm256_set1_ps(v.x)), y(_mm256_set1_ps(v.y)), z(_mm256_set1_ps(v.z)) {}
+
+	FE_TARGET_AVX2 static Vector3x8 Load(const float* pXs, const float* pYs, const float* pZs) {
+		return Vector3x8(_mm256_loadu_ps(pXs), _mm256_loadu_ps(pYs), _mm256_loadu_ps(pZs));
+	}
+
+	FE_TARGET_AVX2 void Store(float* pXs, float* pYs, float* pZs) const {
+		_mm256_storeu_ps(pXs, x);
+		_mm256_storeu_ps(pYs, y);
+		_mm256_storeu_ps(pZs, z);
+	}
+
+	FE_TARGET_AVX2 Vector3x8 operator+(const Vector3x8& v) const { return Vector3x8(_mm256_add_ps(x, v.x), _mm256_add_ps(y, v.y), _mm256_add_ps(z, v.z)); }
+	FE_TARGET_AVX2 Vector3x8 operator-(const Vector3x8& v) const { return Vector3x8(_mm256_sub_ps(x, v.x), _mm256_sub_ps(y, v.y), _mm256_sub_ps(z, v.z)); }
+	FE_TARGET_AVX2 Vector3x8 operator*(const Vector3x8& v) const { return Vector3x8(_mm256_mul_ps(x, v.x), _mm256_mul_ps(y, v.y), _mm256_mul_ps(z, v.z)); }
+	FE_TARGET_AVX2 Vector3x8 operator*(__m256 s) const { return Vector3x8(_mm256_mul_ps(x, s), _mm256_mul_ps(y, s), _mm256_mul_ps(z, s)); }
+};
+
+FE_TARGET_AVX2 FE_FORCEINLINE __m256 DotProduct(const Vector3x8& A, const Vector3x8& B) {
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(A.x, B.x), _mm256_mul_ps(A.y, B.y)), _mm256_mul_ps(A.z, B.z));
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE Vector3x8 CrossProduct(const Vector3x8& A, const Vector3x8& B) {
+	return Vector3x8(
+		_mm256_sub_ps(_mm256_mul_ps(A.y, B.z), _mm256_mul_ps(A.z, B.y)),
+		_mm256_sub_ps(_mm256_mul_ps(A.z, B.x), _mm256_mul_ps(A.x, B.z)),
+		_mm256_sub_ps(_mm256_mul_ps(A.x, B.y), _mm256_mul_ps(A.y, B.x))
+	);
+}
+
+FE_TARGET_AVX2 FE_FORCEINLINE Vector3x8 NormalizeVector(const Vector3x8& v) {
+	__m256 ratio = _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(DotProduct(v, v)));
+
+	return v * ratio;
+}
+
+}
+
+#endif
\ No newline at end of file
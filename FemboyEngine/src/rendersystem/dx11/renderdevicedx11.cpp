@@ -1,5 +1,7 @@
 #include "renderdevicedx11.h"
 
+#include "fstdlib/arena.h"
+
 #include <SDL3/SDL_assert.h>
 
 #include <stdexcept>
@@ -30,6 +32,24 @@ DXGI_FORMAT ConvertRenderFormat(RenderFormat::Enum format) {
 	case RenderFormat::R32G32B32A32_Float:
 		return DXGI_FORMAT_R32G32B32A32_FLOAT;
 
+	case RenderFormat::R8G8B8A8_SNorm:
+		return DXGI_FORMAT_R8G8B8A8_SNORM;
+
+	case RenderFormat::R16G16_Float:
+		return DXGI_FORMAT_R16G16_FLOAT;
+
+	case RenderFormat::R16G16B16A16_Float:
+		return DXGI_FORMAT_R16G16B16A16_FLOAT;
+
+	case RenderFormat::R16G16_SNorm:
+		return DXGI_FORMAT_R16G16_SNORM;
+
+	case RenderFormat::R16G16B16A16_SNorm:
+		return DXGI_FORMAT_R16G16B16A16_SNORM;
+
+	case RenderFormat::R10G10B10A2_UNorm:
+		return DXGI_FORMAT_R10G10B10A2_UNORM;
+
 	default:
 		break;
 	}
@@ -260,12 +280,11 @@ void RenderDeviceDx11::Shutdown() {
 
 	m_pDeviceContext.Reset();
 
-	RenderResourceIterator_t* pResourceIter = m_RenderResourceList.GetHead();
-	while (pResourceIter) {
-		while (ReleaseResourceEx(pResourceIter->pData, false) > 0);
-		pResourceIter = pResourceIter->pNext;
+	// Unlink first, the last release deletes the resource.
+	while (RenderResource* pResource = m_RenderResourceList.GetHead()) {
+		m_RenderResourceList.Remove(pResource);
+		while (ReleaseResourceEx(pResource, false) > 0);
 	}
-	m_RenderResourceList.Clear();
 
 	m_pDevice.Reset();
 }
@@ -320,13 +339,14 @@ PixelShader* RenderDeviceDx11::CreatePixelShader(const void* pBytecode, size_t b
 }
 
 InputLayout* RenderDeviceDx11::CreateInputLayout(InputElement_t const* const pElements, uint32_t numElements, const void* pShaderBytecode, size_t bytecodeLength) {
-	std::vector<D3D11_INPUT_ELEMENT_DESC> inputElements(numElements);
+	ScratchScope scratch;
+	D3D11_INPUT_ELEMENT_DESC* inputElements = scratch.GetArena().AllocateArray<D3D11_INPUT_ELEMENT_DESC>(numElements);
 
 	for (uint32_t i = 0; i < numElements; i++) {
 		const InputElement_t& elem = pElements[i];
 
 		inputElements[i] = {
-			elem.semanticName.data(),
+			elem.semanticName.GetString(),
 			elem.semanticIndex,
 			ConvertRenderFormat(elem.format),
 			0,
@@ -338,7 +358,7 @@ InputLayout* RenderDeviceDx11::CreateInputLayout(InputElement_t const* const pEl
 
 	wrl::ComPtr<ID3D11InputLayout> pLayout;
 
-	ThrowIfFailed(m_pDevice->CreateInputLayout(inputElements.data(), numElements, pShaderBytecode, bytecodeLength, &pLayout));
+	ThrowIfFailed(m_pDevice->CreateInputLayout(inputElements, numElements, pShaderBytecode, bytecodeLength, &pLayout));
 
 	return RegisterResource(new InputLayout_Dx11(pLayout));
 }
@@ -626,24 +646,30 @@ static const uint8_t hlslVersion = MAKE_HLSL_VERSION(5, 0);
 static const std::string hlslVersionTarget = GetShaderTarget(hlslVersion);
 
 bool ShaderCompilerDx11::CompileShaderSource(const std::string& source, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode) {
-	std::string entry = "main";
-	std::string target = "";
+	return CompileShaderBuffer(source.data(), source.size(), stage, pBytecode);
+}
+
+bool ShaderCompilerDx11::CompileShaderBuffer(const void* pSource, size_t sourceSize, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode) {
+	ScratchScope scratch;
+
+	const char* pEntry = "main";
+	ArenaString target(scratch.GetAllocator());
 
 	pBytecode = nullptr;
 	
 	if (stage == ShaderStage::Vertex) {
-		entry = "VSMain";
-		target = "vs_" + hlslVersionTarget;
+		pEntry = "VSMain";
+		target.append("vs_").append(hlslVersionTarget.data(), hlslVersionTarget.size());
 	}
 	else if (stage == ShaderStage::Pixel) {
-		entry = "PSMain";
-		target = "ps_" + hlslVersionTarget;
+		pEntry = "PSMain";
+		target.append("ps_").append(hlslVersionTarget.data(), hlslVersionTarget.size());
 	}
 
 	wrl::ComPtr<ID3DBlob> pCode;
 	wrl::ComPtr<ID3DBlob> pError;
 
-	HRESULT hr = D3DCompile(source.data(), source.size(), nullptr, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entry.c_str(), target.c_str(), D3DCOMPILE_DEBUG, 0, &pCode, &pError);
+	HRESULT hr = D3DCompile(pSource, sourceSize, nullptr, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, pEntry, target.c_str(), D3DCOMPILE_DEBUG, 0, &pCode, &pError);
 	if (FAILED(hr)) {
 		if (pError) {
 			printf("HLSL Compile Error (HRESULT: %x): %s\n", hr, reinterpret_cast<char*>(pError->GetBufferPointer()));
@@ -657,11 +683,12 @@ bool ShaderCompilerDx11::CompileShaderSource(const std::string& source, ShaderSt
 }
 
 bool ShaderCompilerDx11::CompileShaderFile(const std::string& sourceFile, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode) {
+	ScratchScope scratch;
 	wrl::ComPtr<ID3DBlob> pShaderSource;
 
 	pBytecode = nullptr;
 
-	std::wstring wideFilePath(sourceFile.begin(), sourceFile.end());
+	ArenaWString wideFilePath(sourceFile.begin(), sourceFile.end(), scratch.GetAllocator<wchar_t>());
 
 	HRESULT hr = D3DReadFileToBlob(wideFilePath.c_str(), &pShaderSource);
 	if (FAILED(hr)) {
@@ -671,9 +698,8 @@ bool ShaderCompilerDx11::CompileShaderFile(const std::string& sourceFile, Shader
 		return false;
 	}
 
-	std::string shaderSourceStr(reinterpret_cast<char*>(pShaderSource->GetBufferPointer()), pShaderSource->GetBufferSize());
-
-	return CompileShaderSource(shaderSourceStr, stage, pBytecode);
+	// Compile straight from the blob instead of copying it into a string.
+	return CompileShaderBuffer(pShaderSource->GetBufferPointer(), pShaderSource->GetBufferSize(), stage, pBytecode);
 }
 
 }
\ No newline at end of file
@@ -20,6 +20,9 @@ public:
 	virtual ~ShaderCompilerDx11() = default;
 	virtual bool CompileShaderSource(const std::string& source, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode);
 	virtual bool CompileShaderFile(const std::string& sourceFile, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode);
+
+private:
+	bool CompileShaderBuffer(const void* pSource, size_t sourceSize, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode);
 };
 
 class SwapChainDx11 : public SwapChain {
@@ -72,6 +75,7 @@ public:
 	virtual VertexShader* CreateVertexShader(const void* pBytecode, size_t bytecodeLength);
 	virtual PixelShader* CreatePixelShader(const void* pBytecode, size_t bytecodeLength);
 	virtual InputLayout* CreateInputLayout(InputElement_t const* const pElements, uint32_t numElements, const void* pShaderBytecode, size_t bytecodeLength);
+	using RenderDevice::CreateInputLayout;
 
 	virtual Buffer* CreateConstantBuffer(uint32_t bufferSize, BufferUsage::Enum usage, const void* pInitData);
 	virtual Buffer* CreateVertexBuffer(uint32_t numVertices, uint32_t strideInBytes, BufferUsage::Enum usage, const void* pInitData);
@@ -2,31 +2,35 @@
 
 #include "typeinfo/object.h"
 
-#include "fstdlib/linkedlist.h"
+#include "fstdlib/smallvector.h"
+#include "fstdlib/stringid.h"
 
 #include "renderdevice.h"
 #include "rendercontext.h"
 
 namespace fe::render {
 
-using LayerList_t = LinkedList<class Layer>;
-using LayerIterator_t = LayerList_t::Iterator_t;
+using LayerList_t = SmallVector<class Layer*, 4>;
 
 class Layer : public Inherit<Object, Layer> {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~Layer() = default;
 
 	virtual void OnAttach(RenderDevice* pDevice) {}
 	virtual void OnDetach(RenderDevice* pDevice) {}
 	virtual void Draw(RenderContext* pRenderContext) {}
 
-	virtual std::string GetName() { return "Unnamed Layer"; }
+	virtual StringId GetName() {
+		static const StringId name("Unnamed Layer");
+		return name;
+	}
 
-	const LinkedList<Layer>& GetChildLayers() const { return m_ChildLayers; }
+	const LayerList_t& GetChildLayers() const { return m_ChildLayers; }
 
 private:
-	LayerIterator_t* m_pIterator;
-	LinkedList<Layer> m_ChildLayers;
+	LayerList_t m_ChildLayers;
 };
 
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ class RenderDevice;
 
 class RenderContext {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~RenderContext() = default;
 
 	virtual void SetViewports(const Viewport_t* const ppViewports, uint32_t numViewports) = 0;
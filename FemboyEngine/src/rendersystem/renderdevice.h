@@ -15,6 +15,8 @@ struct RenderDeviceParams_t {
 
 class RenderDevice {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~RenderDevice() = default;
 
 	virtual bool Initialize(const RenderDeviceParams_t& params) = 0;
@@ -30,6 +32,10 @@ public:
 	virtual PixelShader* CreatePixelShader(const void* pBytecode, size_t bytecodeLength) = 0;
 	virtual InputLayout* CreateInputLayout(InputElement_t const* const pElements, uint32_t numElements, const void* pShaderBytecode, size_t bytecodeLength) = 0;
 
+	InputLayout* CreateInputLayout(const InputElementList_t& elements, const void* pShaderBytecode, size_t bytecodeLength) {
+		return CreateInputLayout(elements.data(), static_cast<uint32_t>(elements.size()), pShaderBytecode, bytecodeLength);
+	}
+
 	virtual Buffer* CreateConstantBuffer(uint32_t bufferSize, BufferUsage::Enum usage, const void* pInitData) = 0;
 	virtual Buffer* CreateVertexBuffer(uint32_t numVertices, uint32_t strideInBytes, BufferUsage::Enum usage, const void* pInitData) = 0;
 
@@ -62,15 +68,13 @@ public:
 	}
 
 	RenderResource* RegisterResource(RenderResource* pResource) {
-		pResource->m_pIterator = m_RenderResourceList.AddToTail(pResource);
+		m_RenderResourceList.AddToTail(pResource);
 
 		return pResource;
 	}
 
 	void UnregisterResource(RenderResource* pResource) {
-		if (pResource->m_pIterator) {
-			m_RenderResourceList.Remove(pResource->m_pIterator);
-		}
+		m_RenderResourceList.Remove(pResource);
 	}
 
 	template<typename T>
@@ -4,7 +4,11 @@
 #include <string>
 #include <vector>
 
-#include "fstdlib/linkedlist.h"
+#include "fstdlib/intrusivelist.h"
+#include "fstdlib/fixedvector.h"
+#include "fstdlib/hash.h"
+#include "fstdlib/memorytracking.h"
+#include "fstdlib/stringid.h"
 
 namespace fe::render {
 
@@ -15,9 +19,43 @@ struct RenderFormat {
 		R32_Float,
 		R32G32B32_Float,
 		R32G32B32A32_Float,
+
+		// Packed vertex attributes, see mathlib/packing.h for the encoders.
+		R8G8B8A8_SNorm,
+		R16G16_Float,
+		R16G16B16A16_Float,
+		R16G16_SNorm, // Also octahedral normals.
+		R16G16B16A16_SNorm,
+		R10G10B10A2_UNorm, // Also tangents with the bitangent sign in alpha.
 	};
 };
 
+// Size of one element in bytes, 0 for Unknown.
+constexpr uint32_t GetRenderFormatSize(RenderFormat::Enum format) {
+	switch (format) {
+	case RenderFormat::R8G8B8A8_UNorm:
+	case RenderFormat::R8G8B8A8_SNorm:
+	case RenderFormat::R32_Float:
+	case RenderFormat::R16G16_Float:
+	case RenderFormat::R16G16_SNorm:
+	case RenderFormat::R10G10B10A2_UNorm:
+		return 4;
+
+	case RenderFormat::R16G16B16A16_Float:
+	case RenderFormat::R16G16B16A16_SNorm:
+		return 8;
+
+	case RenderFormat::R32G32B32_Float:
+		return 12;
+
+	case RenderFormat::R32G32B32A32_Float:
+		return 16;
+
+	default:
+		return 0;
+	}
+}
+
 struct PrimitiveToplogy {
 	enum Enum {
 		TriangleList,
@@ -62,30 +100,36 @@ struct BindFlags {
 constexpr uint32_t InputElement_ByteOffset_Append = static_cast<uint32_t>(-1);
 
 struct InputElement_t {
-	std::string semanticName;
+	StringId semanticName;
 	uint32_t semanticIndex;
 	RenderFormat::Enum format;
 	uint32_t byteOffset;
 
 	InputElement_t()
-		: semanticName(""), semanticIndex(0), format(RenderFormat::Unknown), byteOffset(-1) {}
+		: semanticIndex(0), format(RenderFormat::Unknown), byteOffset(-1) {}
 
-	InputElement_t(const std::string& semanticName, uint32_t semanticIndex, RenderFormat::Enum format, uint32_t byteOffset = InputElement_ByteOffset_Append)
+	InputElement_t(StringId semanticName, uint32_t semanticIndex, RenderFormat::Enum format, uint32_t byteOffset = InputElement_ByteOffset_Append)
 		: semanticName(semanticName), semanticIndex(semanticIndex), format(format), byteOffset(byteOffset) {}
+
+	InputElement_t(std::string_view semanticName, uint32_t semanticIndex, RenderFormat::Enum format, uint32_t byteOffset = InputElement_ByteOffset_Append)
+		: InputElement_t(StringId(semanticName), semanticIndex, format, byteOffset) {}
+
+	bool operator==(const InputElement_t& other) const = default;
 };
 
-using RenderResourceList_t = LinkedList<class RenderResource>;
-using RenderResourceIterator_t = RenderResourceList_t::Iterator_t;
+// D3D11_IA_VERTEX_INPUT_STRUCTURE_ELEMENT_COUNT, the most any API allows.
+constexpr uint32_t MaxInputElements = 32;
+
+using InputElementList_t = FixedVector<InputElement_t, MaxInputElements>;
 
-class RenderResource {
-	friend class RenderDevice;
+using RenderResourceList_t = IntrusiveList<class RenderResource>;
 
+class RenderResource : public RenderResourceList_t::Hook_t {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~RenderResource() = default;
 	virtual uint32_t Release() = 0;
-
-private:
-	RenderResourceIterator_t* m_pIterator = nullptr;
 };
 
 class Texture2D : public RenderResource {
@@ -118,4 +162,11 @@ public:
 	virtual ~InputLayout() = default;
 };
 
-}
\ No newline at end of file
+}
+
+template<>
+struct std::hash<fe::render::InputElement_t> {
+	size_t operator()(const fe::render::InputElement_t& element) const noexcept {
+		return static_cast<size_t>(fe::HashBytesOf(element));
+	}
+};
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace fe::render {
 
 class RHI {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	RHI(GraphicsAPI::Enum graphicsApi);
 
 	virtual RenderDevice* CreateRenderDevice(const RenderDeviceParams_t& params);
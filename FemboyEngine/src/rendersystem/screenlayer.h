@@ -9,24 +9,22 @@ namespace fe::render {
 class ScreenLayer : public Inherit<Layer, ScreenLayer> {
 public:
 	virtual void Draw(RenderContext* pRenderContext) {
-		LayerIterator_t* pLayerIter = GetChildLayers().GetHead();
-		while (pLayerIter) {
-			RenderLayer(pRenderContext, pLayerIter->pData);
-			pLayerIter = pLayerIter->pNext;
+		for (Layer* pLayer : GetChildLayers()) {
+			RenderLayer(pRenderContext, pLayer);
 		}
 	}
 
-	virtual std::string GetName() { return "Screen Layer"; }
+	virtual StringId GetName() {
+		static const StringId name("Screen Layer");
+		return name;
+	}
 	
 private:
 	void RenderLayer(RenderContext* pRenderContext, Layer* pLayer) {
 		pLayer->Draw(pRenderContext);
 
-		auto* pChildIter = pLayer->GetChildLayers().GetHead();
-		if (pChildIter) {
-			RenderLayer(pRenderContext, pChildIter->pData);
-
-			pChildIter = pChildIter->pNext;
+		for (Layer* pChild : pLayer->GetChildLayers()) {
+			RenderLayer(pRenderContext, pChild);
 		}
 	}
 };
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "fstdlib/pointers.h"
+#include "fstdlib/memorytracking.h"
 
 namespace fe::render {
 
@@ -16,6 +17,8 @@ struct ShaderStage {
 
 class ShaderBytecode {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~ShaderBytecode() = default;
 	virtual void* GetData() const = 0;
 	virtual size_t GetSize() const = 0;
@@ -23,6 +26,8 @@ public:
 
 class ShaderCompiler {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~ShaderCompiler() = default;
 	virtual bool CompileShaderSource(const std::string& source, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode) = 0;
 	virtual bool CompileShaderFile(const std::string& sourceFile, ShaderStage::Enum stage, ScopedPtr<ShaderBytecode>& pBytecode) = 0;
@@ -28,6 +28,8 @@ struct SwapChainParams_t {
 
 class SwapChain {
 public:
+	FE_MEMORY_TAG(MemoryTag::Render)
+
 	virtual ~SwapChain() = default;
 
 	virtual bool Initialize(RenderDevice* pDevice, const SwapChainParams_t& params) = 0;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "fstdlib/hash.h"
+
 namespace fe::render {
 
 struct Float2 {
@@ -33,6 +35,8 @@ struct Float4 {
 
 	Float4(float x, float y, float z, float w)
 		: x(x), y(y), z(z), w(w) {}
+
+	bool operator==(const Float4& other) const = default;
 };
 
 struct Float3x3 {
@@ -50,6 +54,10 @@ struct Float3x3 {
 struct Float3x4 {
 	Float4 m[3];
 
+	float* AsArray() {
+		return (&m[0].x);
+	}
+
 	Float3x4() {}
 
 	Float3x4(const Float4& m0, const Float4& m1, const Float4& m2) {
@@ -74,6 +82,15 @@ struct Float4x4 {
 		m[2] = m2;
 		m[3] = m3;
 	}
+
+	bool operator==(const Float4x4& other) const = default;
 };
 
-}
\ No newline at end of file
+}
+
+template<>
+struct std::hash<fe::render::Float4x4> {
+	size_t operator()(const fe::render::Float4x4& matrix) const noexcept {
+		return static_cast<size_t>(fe::HashFloats(&matrix.m[0].x, 16));
+	}
+};
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "fstdlib/hash.h"
+
 namespace fe::render {
 
 struct Viewport_t {
@@ -15,6 +17,15 @@ struct Viewport_t {
 
 	Viewport_t(float x, float y, float width, float height, float minDepth = 0.f, float maxDepth = 1.f)
 		: x(0.f), y(0.f), width(width), height(height), minDepth(minDepth), maxDepth(maxDepth) {}
+
+	bool operator==(const Viewport_t& other) const = default;
 };
 
-}
\ No newline at end of file
+}
+
+template<>
+struct std::hash<fe::render::Viewport_t> {
+	size_t operator()(const fe::render::Viewport_t& viewport) const noexcept {
+		return static_cast<size_t>(fe::HashFloats(&viewport.x, 6));
+	}
+};
\ No newline at end of file
@@ -1,34 +1,29 @@
 #include "component.h"
-#include "sceneobject.h"
+#include "scene.h"
 
 namespace fe {
 
 Component::Component() {
-	m_pOwner = nullptr;
-	m_pIterator = nullptr;
+	m_pScene = nullptr;
 }
 
 Component::~Component() {
-	if (m_pOwner && m_pIterator) {
-		m_pOwner->RemoveComponent(m_pIterator);
-	}
 }
 
-ComponentIterator_t* Component::GetIterator() const {
-	return m_pIterator;
+ComponentHandle_t Component::GetHandle() const {
+	return m_Handle;
 }
 
-SceneObject* Component::GetOwner() const {
-	return m_pOwner;
+SceneObjectHandle_t Component::GetOwnerHandle() const {
+	return m_Owner;
 }
 
-void Component::SetOwner(SceneObject* pOwner) {
-	if (m_pOwner && m_pIterator) {
-		m_pOwner->RemoveComponent(m_pIterator);
-		m_pIterator = pOwner->AddComponent(this);
-	}
+SceneObject* Component::GetOwner() const {
+	return m_pScene ? m_pScene->GetSceneObject(m_Owner) : nullptr;
+}
 
-	m_pOwner = pOwner;
+Scene* Component::GetScene() const {
+	return m_pScene;
 }
 
 }
\ No newline at end of file
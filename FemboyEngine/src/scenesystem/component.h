@@ -2,28 +2,42 @@
 
 #include "typeinfo/object.h"
 
-#include "fstdlib/linkedlist.h"
+#include "fstdlib/intrusivelist.h"
+#include "fstdlib/slotmap.h"
+#include "fstdlib/memorytracking.h"
 
 namespace fe {
 
+class Scene;
 class SceneObject;
 
-using ComponentList_t = LinkedList<class Component>;
-using ComponentIterator_t = ComponentList_t::Iterator_t;
+using ComponentHandle_t = SlotHandle_t<class Component>;
+using SceneObjectHandle_t = SlotHandle_t<SceneObject>;
+
+// Links the component into the ComponentManager list of its type.
+using ComponentTypeList_t = IntrusiveList<class Component>;
+
+// Components are owned by their Scene, see Scene::AddComponent.
+class Component : public Inherit<Object, Component>, public ComponentTypeList_t::Hook_t {
+	friend class Scene;
 
-class Component : public Inherit<Object, Component> {
 public:
+	FE_MEMORY_TAG(MemoryTag::Scene)
+
 	Component();
 	virtual ~Component();
 
-	ComponentIterator_t* GetIterator() const;
+	ComponentHandle_t GetHandle() const;
+	SceneObjectHandle_t GetOwnerHandle() const;
 
+	// nullptr once the owner has been destroyed.
 	SceneObject* GetOwner() const;
-	void SetOwner(SceneObject* pOwner);
+	Scene* GetScene() const;
 
 private:
-	SceneObject* m_pOwner;
-	ComponentIterator_t* m_pIterator;
+	Scene* m_pScene;
+	ComponentHandle_t m_Handle;
+	SceneObjectHandle_t m_Owner;
 };
 
 }
\ No newline at end of file
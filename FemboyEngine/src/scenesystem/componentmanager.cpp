@@ -17,7 +17,7 @@ void ComponentManager::UnregisterComponent(Component* pComponent) {
 
 	auto componentListPos = m_Components.find(componentType);
 	if (componentListPos != m_Components.end())
-		componentListPos->second.Remove(pComponent->GetIterator());
+		componentListPos->second.Remove(pComponent);
 }
 
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 #include "typeinfo/object.h"
 
-#include <unordered_map>
+#include "fstdlib/flathashmap.h"
 
 namespace fe {
 
@@ -14,7 +14,7 @@ public:
 	void UnregisterComponent(Component* pComponent);
 
 private:
-	std::unordered_map<TypeIndex, LinkedList<Component>> m_Components;
+	FlatHashMap<TypeIndex, ComponentTypeList_t> m_Components;
 };
 
 }
\ No newline at end of file
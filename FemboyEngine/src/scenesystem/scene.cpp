@@ -1,19 +1,86 @@
 #include "scene.h"
 
+#include <algorithm>
+
 namespace fe {
 
-Scene::Scene(std::string&& name)
-	: m_Name(std::move(name))
+Scene::Scene(StringId name)
+	: m_Name(name)
 {
 	m_pDefaultCamera = ScopedPtr<Camera>(new Camera());
 	m_pActiveCamera = m_pDefaultCamera.get();
 }
 
-SceneObject* Scene::CreateSceneObject() {
-	SceneObjectIterator_t* pIterator = m_SceneObjects.AddToTail(nullptr);
-	pIterator->pData = new SceneObject(this, pIterator);
+Scene::~Scene() {
+	// Components can still look up their owners while they are destroyed.
+	m_Components.Clear();
+	m_SceneObjects.Clear();
+}
+
+SceneObjectHandle_t Scene::CreateSceneObject() {
+	SceneObjectHandle_t handle = m_SceneObjects.Emplace(this);
+	m_SceneObjects.Get(handle)->m_Handle = handle;
+
+	return handle;
+}
+
+void Scene::DestroySceneObject(SceneObjectHandle_t handle) {
+	SceneObject* pSceneObject = m_SceneObjects.Get(handle);
+	if (!pSceneObject)
+		return;
+
+	ComponentHandleList_t components = std::move(pSceneObject->m_Components);
+	for (ComponentHandle_t component : components) {
+		m_Components.Erase(component);
+	}
+
+	m_SceneObjects.Erase(handle);
+}
+
+SceneObject* Scene::GetSceneObject(SceneObjectHandle_t handle) const {
+	return const_cast<SceneObject*>(m_SceneObjects.Get(handle));
+}
+
+ComponentHandle_t Scene::AddComponent(SceneObjectHandle_t owner, Component* pComponent) {
+	SceneObject* pOwner = m_SceneObjects.Get(owner);
+	if (!pOwner) {
+		delete pComponent;
+		return {};
+	}
+
+	ComponentHandle_t handle = m_Components.Emplace(pComponent);
+
+	pComponent->m_pScene = this;
+	pComponent->m_Handle = handle;
+	pComponent->m_Owner = owner;
+	pOwner->m_Components.push_back(handle);
+
+	return handle;
+}
+
+void Scene::DestroyComponent(ComponentHandle_t handle) {
+	Component* pComponent = GetComponent(handle);
+	if (!pComponent)
+		return;
+
+	// The handle isn't in the owner's list while DestroySceneObject is
+	//	destroying its components, a component can destroy another one then.
+	SceneObject* pOwner = m_SceneObjects.Get(pComponent->m_Owner);
+	if (pOwner) {
+		auto& components = pOwner->m_Components;
+		auto it = std::find(components.begin(), components.end(), handle);
+
+		if (it != components.end())
+			components.erase(it);
+	}
+
+	m_Components.Erase(handle);
+}
+
+Component* Scene::GetComponent(ComponentHandle_t handle) const {
+	const ScopedPtr<Component>* ppComponent = m_Components.Get(handle);
 
-	return pIterator->pData;
+	return ppComponent ? ppComponent->get() : nullptr;
 }
 
 Camera* Scene::GetActiveCamera() const {
@@ -2,25 +2,59 @@
 
 #include "typeinfo/object.h"
 
-#include "fstdlib/linkedlist.h"
+#include "fstdlib/slotmap.h"
+#include "fstdlib/pointers.h"
+#include "fstdlib/memorytracking.h"
+#include "fstdlib/stringid.h"
 
 #include "sceneobject.h"
 #include "camera.h"
 
+#include <type_traits>
+
 namespace fe {
 
+using SceneObjectMap_t = SlotMap<SceneObject, SceneObject, TaggedAllocator<SceneObject, MemoryTag::Scene>>;
+using ComponentMap_t = SlotMap<ScopedPtr<Component>, Component, TaggedAllocator<ScopedPtr<Component>, MemoryTag::Scene>>;
+
 class Scene : public Inherit<Object, Scene> {
 public:
-	Scene(std::string&& name);
+	FE_MEMORY_TAG(MemoryTag::Scene)
+
+	Scene(StringId name);
+	virtual ~Scene();
+
+	SceneObjectHandle_t CreateSceneObject();
+	// Destroys the object's components too. Stale handles are ignored.
+	void DestroySceneObject(SceneObjectHandle_t handle);
+	// nullptr for stale handles. Only valid until the next object is
+	//	created or destroyed.
+	SceneObject* GetSceneObject(SceneObjectHandle_t handle) const;
+
+	// Takes ownership of pComponent. Returns an invalid handle, and deletes
+	//	the component, when the owner doesn't exist.
+	ComponentHandle_t AddComponent(SceneObjectHandle_t owner, Component* pComponent);
+
+	template<typename T, typename... Args>
+	ComponentHandle_t AddComponent(SceneObjectHandle_t owner, Args&&... args) {
+		static_assert(std::is_base_of_v<Component, T>);
+		return AddComponent(owner, new T(std::forward<Args>(args)...));
+	}
+
+	void DestroyComponent(ComponentHandle_t handle);
+	Component* GetComponent(ComponentHandle_t handle) const;
 
-	SceneObject* CreateSceneObject();
+	// Packed storage, for linear walks over every object or component.
+	const SceneObjectMap_t& GetSceneObjects() const { return m_SceneObjects; }
+	const ComponentMap_t& GetComponents() const { return m_Components; }
 
 	Camera* GetActiveCamera() const;
 	void SetActiveCamera(Camera* pCamera);
 
 private:
-	std::string m_Name;
-	LinkedList<SceneObject> m_SceneObjects;
+	StringId m_Name;
+	SceneObjectMap_t m_SceneObjects;
+	ComponentMap_t m_Components;
 
 	Camera* m_pActiveCamera;
 	ScopedPtr<Camera> m_pDefaultCamera;
@@ -12,7 +12,10 @@ public:
 	virtual void OnDetach(render::RenderDevice* pDevice);
 	virtual void Draw(render::RenderContext* pRenderContext);
 
-	virtual std::string GetName() { return "Scene Layer"; }
+	virtual StringId GetName() {
+		static const StringId name("Scene Layer");
+		return name;
+	}
 	
 private:
 
@@ -2,34 +2,16 @@
 
 namespace fe {
 
-SceneObject::SceneObject(Scene* pScene, SceneObjectIterator_t* pIterator) {
+SceneObject::SceneObject(Scene* pScene) {
 	m_pScene = pScene;
-	m_pIterator = pIterator;
 }
 
-SceneObject::~SceneObject() {
-	/*ComponentIterator_t* pComponentIter = m_Components.GetHead();
-	while (pComponentIter) {
-		ComponentIterator_t* pNextIter = pComponentIter->pNext;
-
-		if (pComponentIter->pData) {
-			delete pComponentIter->pData;
-		}
-
-		pComponentIter = pNextIter;
-	}*/
-
-	m_Components.ClearAndDeleteElements();
-}
-
-ComponentIterator_t* SceneObject::AddComponent(Component* pComponent) {
-	return m_Components.AddToTail(pComponent);
+SceneObjectHandle_t SceneObject::GetHandle() const {
+	return m_Handle;
 }
 
-void SceneObject::RemoveComponent(ComponentIterator_t* pIterator) {
-	if (pIterator) {
-		m_Components.Remove(pIterator);
-	}
+Scene* SceneObject::GetScene() const {
+	return m_pScene;
 }
 
 }
\ No newline at end of file
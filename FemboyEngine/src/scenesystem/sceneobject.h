@@ -4,31 +4,33 @@
 
 #include "typeinfo/object.h"
 
-#include "fstdlib/linkedlist.h"
+#include "fstdlib/smallvector.h"
 
 namespace fe {
 
-class Scene;
-
-using SceneObjectList_t = LinkedList<class SceneObject>;
-using SceneObjectIterator_t = SceneObjectList_t::Iterator_t;
+// Scene objects live packed in their Scene's slot map and move when other
+//	objects are destroyed, so keep a SceneObjectHandle_t rather than a pointer.
+// Most objects have a handful of components, those stay inline.
+using ComponentHandleList_t = SmallVector<ComponentHandle_t, 4>;
 
 class SceneObject : public Inherit<Object, SceneObject> {
-public:
-	SceneObject(Scene* pScene, SceneObjectIterator_t* pIterator);
-	virtual ~SceneObject();
+	friend class Scene;
 
-	ComponentIterator_t* AddComponent(Component* pComponent);
-
-	// Component::m_pIterator
-	void RemoveComponent(ComponentIterator_t* pIterator);
+public:
+	SceneObject(Scene* pScene);
+	SceneObject(SceneObject&&) = default;
+	SceneObject& operator=(SceneObject&&) = default;
+	virtual ~SceneObject() = default;
 
+	SceneObjectHandle_t GetHandle() const;
+	Scene* GetScene() const;
 
+	const ComponentHandleList_t& GetComponents() const { return m_Components; }
 
 private:
 	Scene* m_pScene;
-	SceneObjectIterator_t* m_pIterator;
-	LinkedList<Component> m_Components;
+	SceneObjectHandle_t m_Handle;
+	ComponentHandleList_t m_Components;
 };
 
 }
\ No newline at end of file
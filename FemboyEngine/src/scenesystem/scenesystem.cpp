@@ -3,7 +3,7 @@
 namespace fe {
 
 SceneSystem::SceneSystem() {
-	m_pDefaultScene = ScopedPtr<Scene>(new Scene("Default Scene"));
+	m_pDefaultScene = ScopedPtr<Scene>(new Scene(StringId("Default Scene")));
 	m_pActiveScene = m_pDefaultScene.get();
 }
 
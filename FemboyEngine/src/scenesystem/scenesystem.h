@@ -11,6 +11,8 @@ namespace fe {
 
 class SceneSystem : public Inherit<Object, SceneSystem>, public Singleton<SceneSystem> {
 public:
+	FE_MEMORY_TAG(MemoryTag::Scene)
+
 	SceneSystem();
 
 	Scene* GetActiveScene() const;
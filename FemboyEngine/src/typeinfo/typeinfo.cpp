@@ -2,6 +2,9 @@
 
 #include "Inherit.h"
 
+#include "fstdlib/memorytracking.h"
+
+#include <cstring>
 #include <fstream>
 
 namespace fe {
@@ -15,7 +18,7 @@ bool TypeInfo::isBaseOf(TypeIndex typeIndex) const
 		if (typeInfoPtr->typeIndex == typeIndex)
 			return true;
 
-		typeInfoPtr = typeInfoPtr->parentType.get();
+		typeInfoPtr = typeInfoPtr->parentType;
 	}
 	return false;
 }
@@ -45,35 +48,44 @@ public:
 SetupHelper<void, void> VoidSetupHelper::voidSetupHelper;
 
 // Wrap this into a function so that the vector isn't initialized during CRT.
-static std::vector<std::shared_ptr<TypeInfo>>& getTypeInfoDatabase()
+using TypeInfoDatabase = std::vector<RefPtr<TypeInfo>, TaggedAllocator<RefPtr<TypeInfo>, MemoryTag::TypeInfo>>;
+
+static TypeInfoDatabase& getTypeInfoDatabase()
 {
-	static std::vector<std::shared_ptr<TypeInfo>> typeInfoDatabase(UINT16_MAX, nullptr);
+	static TypeInfoDatabase typeInfoDatabase(UINT16_MAX, nullptr);
 
 	return typeInfoDatabase;
 }
 
-// Allocates a shared pointer to type info then adds it to the type info list.
-std::shared_ptr<TypeInfo> createTypeInfo(const std::string& className, uint32_t typeSize, TypeIndex typeIndex, TypeIndex parentTypeIndex, CreateFn createFn)
+// Allocates type info then adds it to the type info list.
+RefPtr<TypeInfo> createTypeInfo(StringId className, uint32_t typeSize, TypeIndex typeIndex, TypeIndex parentTypeIndex, CreateFn createFn)
 {
 	auto& typeInfoDB = getTypeInfoDatabase();
-	typeInfoDB[typeIndex] = std::make_shared<TypeInfo>(className, typeSize, typeIndex, parentTypeIndex, createFn);
+	typeInfoDB[typeIndex] = MakeRef<TypeInfo>(className, typeSize, typeIndex, parentTypeIndex, std::move(createFn));
 
 	return typeInfoDB[typeIndex];
 }
 
-std::string fixupTypeName(const char* typeName)
+StringId fixupTypeName(const char* typeName)
 {
-	std::string typeNameStr = typeName;
+	std::string typeNameStr;
+	typeNameStr.reserve(strlen(typeName));
 
-	// Replace "::" with "."
-	size_t replacePos = typeNameStr.find("::");
-	while (replacePos != std::string::npos)
+	// Replace "::" with "." in one pass.
+	for (const char* c = typeName; *c; c++)
 	{
-		typeNameStr = typeNameStr.replace(replacePos, 2, ".");
-		replacePos = typeNameStr.find("::");
+		if (c[0] == ':' && c[1] == ':')
+		{
+			typeNameStr += '.';
+			c++;
+		}
+		else
+		{
+			typeNameStr += *c;
+		}
 	}
 
-	return typeNameStr;
+	return StringId(typeNameStr);
 }
 }
 
@@ -91,7 +103,7 @@ void initialize()
 	for (auto& typeInfo : typeInfoDB)
 	{
 		// Get parent type in the database from parent type index.
-		std::shared_ptr<TypeInfo> parentType = typeInfoDB[typeInfo->parentTypeIndex];
+		TypeInfo* parentType = typeInfoDB[typeInfo->parentTypeIndex].get();
 
 		// Avoid parenting to self.
 		if (parentType && parentType->typeIndex != typeInfo->typeIndex)
@@ -100,7 +112,7 @@ void initialize()
 			typeInfo->parentType = parentType;
 
 			// Add this type to the parent's list of child types.
-			parentType->childTypes.push_back(typeInfo);
+			parentType->childTypes.push_back(typeInfo.get());
 		}
 		else
 			typeInfo->parentType = nullptr;
@@ -136,11 +148,11 @@ void dbgPrintType(std::ostream& outputStream, const TypeInfo* typeInfo, int dept
 	for (int i = 0; i < depth; i++)
 		outputStream << '\t';
 
-	outputStream << typeInfo->className << ": 0x" << std::hex << typeInfo->typeSize << "\n";
+	outputStream << typeInfo->className.GetString() << ": 0x" << std::hex << typeInfo->typeSize << "\n";
 
 	for (const auto& child : typeInfo->childTypes)
 	{
-		dbgPrintType(outputStream, child.get(), depth + 1);
+		dbgPrintType(outputStream, child, depth + 1);
 	}
 }
 
@@ -151,7 +163,7 @@ void dbgWriteTypeTreeToFile(std::ostream& outputStream)
 
 	for (const auto& child : rootPtr->childTypes)
 	{
-		dbgPrintType(outputStream, child.get(), 0);
+		dbgPrintType(outputStream, child, 0);
 	}
 }
 
@@ -163,9 +175,9 @@ std::string dbgGetTypeHierarchy(const TypeInfo* typeInfo)
 
 	while (typeInfo)
 	{
-		result.insert(0, typeInfo->className);
+		result.insert(0, typeInfo->className.GetString());
 
-		typeInfo = typeInfo->parentType.get();
+		typeInfo = typeInfo->parentType;
 
 		if (typeInfo && typeInfo != getNoneType())
 			result.insert(0, " -> ");
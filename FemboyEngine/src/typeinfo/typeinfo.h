@@ -3,7 +3,11 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <functional>
+
+#include "fstdlib/inplacefunction.h"
+#include "fstdlib/memorytracking.h"
+#include "fstdlib/pointers.h"
+#include "fstdlib/stringid.h"
 
 namespace fe {
 
@@ -21,12 +25,12 @@ void dbgWriteTypeTreeToFile(std::ostream& outputStream);
 std::string dbgGetTypeHierarchy(const TypeInfo* typeInfo);
 #endif
 
-using CreateFn = std::function<std::shared_ptr<Object>()>;
+using CreateFn = InplaceFunction<std::shared_ptr<Object>()>;
 
 namespace detail {
 
 extern TypeIndex globalTypeIndex;
-std::shared_ptr<TypeInfo> createTypeInfo(const std::string& className, uint32_t typeSize, TypeIndex typeIndex, TypeIndex parentTypeIndex, CreateFn createFn);
+RefPtr<TypeInfo> createTypeInfo(StringId className, uint32_t typeSize, TypeIndex typeIndex, TypeIndex parentTypeIndex, CreateFn createFn);
 
 template<class T>
 TypeIndex getTypeIndex()
@@ -38,10 +42,10 @@ TypeIndex getTypeIndex()
 	return typeIndex;
 }
 
-std::string fixupTypeName(const char* typeName);
+StringId fixupTypeName(const char* typeName);
 
 template<typename T>
-std::string getTypeName()
+StringId getTypeName()
 {
 	const char* typeName = typeid(T).name();
 
@@ -68,14 +72,16 @@ else
 }
 }
 
+// Returns a reference to the function's static, so looking a type up
+// doesn't touch its reference count.
 template<class Base, class Derived>
-std::shared_ptr<TypeInfo> getTypeInfo()
+const RefPtr<TypeInfo>& getTypeInfo()
 {
 	// void is considered "none" type.
 	if constexpr (std::is_void<Derived>())
 	{
-		static std::shared_ptr<TypeInfo> typeInfo = createTypeInfo(
-			"None",
+		static RefPtr<TypeInfo> typeInfo = createTypeInfo(
+			StringId("None"),
 			0,
 			getTypeIndex<Derived>(),
 			getTypeIndex<Base>(),
@@ -86,7 +92,7 @@ std::shared_ptr<TypeInfo> getTypeInfo()
 	}
 	else
 	{
-		static std::shared_ptr<TypeInfo> typeInfo = createTypeInfo(
+		static RefPtr<TypeInfo> typeInfo = createTypeInfo(
 			getTypeName<Derived>(),
 			sizeof(Derived),
 			getTypeIndex<Derived>(),
@@ -108,11 +114,11 @@ public:
 	}
 
 protected:
-	static std::shared_ptr<TypeInfo> typeInfoSetupVar;
+	static RefPtr<TypeInfo> typeInfoSetupVar;
 };
 
 template<class Base, class Derived>
-std::shared_ptr<TypeInfo> SetupHelper<Base, Derived>::typeInfoSetupVar = detail::getTypeInfo<Base, Derived>();
+RefPtr<TypeInfo> SetupHelper<Base, Derived>::typeInfoSetupVar = detail::getTypeInfo<Base, Derived>();
 
 }
 
@@ -143,21 +149,26 @@ bool isNoneType(const TypeInfo* typeInfo);
 }
 
 // TypeInfo implementation.
-class TypeInfo
+// References are only added and dropped while types register during static
+// initialization, so the count doesn't need to be atomic.
+class TypeInfo : public RefCounted<TypeInfo>
 {
 public:
-	TypeInfo(const std::string& className, uint32_t typeSize, TypeIndex typeIndex, TypeIndex parentTypeIndex, typeinfo::CreateFn createFn)
-		: className(className), typeSize(typeSize), typeIndex(typeIndex), parentTypeIndex(parentTypeIndex), createFn(createFn)
+	FE_MEMORY_TAG(MemoryTag::TypeInfo)
+
+	TypeInfo(StringId className, uint32_t typeSize, TypeIndex typeIndex, TypeIndex parentTypeIndex, typeinfo::CreateFn createFn)
+		: className(className), typeSize(typeSize), typeIndex(typeIndex), parentTypeIndex(parentTypeIndex), createFn(std::move(createFn))
 	{
 	}
 
-	const std::string className;
+	const StringId className;
 	const uint32_t typeSize;
 	const TypeIndex typeIndex;
 	const TypeIndex parentTypeIndex;
 	const typeinfo::CreateFn createFn;
-	std::shared_ptr<TypeInfo> parentType;
-	std::vector<std::shared_ptr<TypeInfo>> childTypes;
+	// Owned by the type database, so these don't hold references.
+	const TypeInfo* parentType = nullptr;
+	std::vector<const TypeInfo*> childTypes;
 
 	bool isBaseOf(TypeIndex typeIndex) const;
 	bool isNoneType() const;